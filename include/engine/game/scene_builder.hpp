@@ -1,5 +1,6 @@
 #pragma once
 #include <core/ecs/registry.hpp>
+#include <core/span.hpp>
 #include <engine/game/state.hpp>
 #include <engine/game/text2d.hpp>
 #include <engine/gfx/render_driver.hpp>
@@ -34,5 +35,16 @@ class SceneBuilder {
 
   public:
 	virtual gfx::render::Driver::Scene build(gfx::Camera const& camera, ecs::Registry const& registry) const;
+
+	///
+	/// \brief Select the level of detail of each mesh whose projected simplification error stays within `maxError` (fraction of view height)
+	///
+	static std::vector<u8> lods(Span<res::Mesh> meshes, Transform const& transform, gfx::Camera const& camera, f32 maxError);
+
+  public:
+	///
+	/// \brief Maximum projected simplification error (fraction of view height) when selecting mesh LODs; 0 draws full detail
+	///
+	f32 m_lodError = 1.0f / 1080.0f;
 };
 } // namespace le
@@ -18,6 +18,11 @@ struct Vertex final {
 	glm::vec2 texCoord = {};
 };
 
+///
+/// \brief Vertex buffer layout: eFull uploads Vertex as is, ePacked uploads `quantise::PackedVertex` (see `core/vertex_quantise.hpp`)
+///
+enum class VertexFormat : s8 { eFull, ePacked, eCOUNT_ };
+
 struct Geometry final {
 	std::vector<Vertex> vertices;
 	std::vector<u32> indices;
@@ -31,6 +31,8 @@ class Driver final {
 		std::vector<res::Mesh> meshes;
 		Ref<Transform const> transform = Transform::s_identity;
 		Pipeline pipeline;
+		// Level of detail of each mesh (missing entries draw full detail)
+		std::vector<u8> lods;
 	};
 
 	struct Batch final {
@@ -6,6 +6,7 @@
 #include <core/reader.hpp>
 #include <core/services.hpp>
 #include <core/std_types.hpp>
+#include <core/tasks.hpp>
 #include <core/time.hpp>
 #include <engine/gfx/screen_rect.hpp>
 #include <engine/window/window.hpp>
@@ -38,7 +39,12 @@ struct Info final {
 	std::optional<Window::Info> windowInfo;
 	std::optional<Ref<io::Reader>> customReader;
 	Span<stdfs::path> dataPaths;
+	// Capacity of the VRAM staging ring (total of all ranges); uploads that do not fit fall back to dedicated buffers
 	Span<MemRange> vramReserve;
+	// Directory for cached decoded assets (defaults to "<executable>/.cache"; disable via `no-asset-cache`)
+	stdfs::path assetCache;
+	// Per-frame budgets for main thread tasks (tasks::enqueueMain); zero runs all
+	EnumArray<tasks::Phase, Time> mainTaskBudgets = {2ms, 2ms, 1ms};
 #if defined(LEVK_DEBUG)
 	bool bLogVRAMallocations = false;
 	dl::level vramLogLevel = dl::level::debug;
@@ -12,6 +12,7 @@ namespace res {
 ///
 struct ResourceList final {
 	std::vector<stdfs::path> shaders;
+	std::vector<stdfs::path> samplers;
 	std::vector<stdfs::path> textures;
 	std::vector<stdfs::path> cubemaps;
 	std::vector<stdfs::path> materials;
@@ -23,6 +23,10 @@
 #endif
 
 namespace le {
+namespace io {
+class Reader;
+}
+
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
 inline constexpr bool levk_resourcesHotReload = true;
 #else
@@ -41,9 +45,18 @@ enum class Status : s8 {
 	eLoading,	// transferring resources
 	eReloading, // reloading (only relevant if `LEVK_RESOURCES_HOT_RELOAD` is defined)
 	eError,		// cannot be used
+	eEvicted,	// memory released under budget pressure; restored on next use
 	eCOUNT_
 };
 
+///
+/// \brief Memory (in bytes) occupied by / budgeted for resources
+///
+struct Footprint {
+	u64 cpu = 0;
+	u64 vram = 0;
+};
+
 ///
 /// \brief Base struct for all resources
 ///
@@ -241,9 +254,13 @@ struct Texture::CreateInfo {
 	std::vector<stdfs::path> ids;
 	std::vector<bytearray> bytes;
 	std::vector<Raw> raws;
+	// KTX2 container (BC1/3/5/7 or RGBA8, with its own mip levels); `ids` / `bytes` are also detected as KTX2
+	bytearray ktx2;
 	Hash samplerID;
 	Space mode = Space::eSRGBNonLinear;
 	Type type = Type::e2D;
+	// Generate and upload a full mip chain
+	bool bMipMaps = true;
 };
 struct Texture::LoadInfo : LoadBase<Texture> {
 	stdfs::path directory;
@@ -273,12 +290,31 @@ enum class Mesh::Type : s8 { eStatic, eDynamic, eCOUNT_ };
 struct Mesh::Info : InfoBase {
 	Material::Inst material;
 	Type type;
+	// Triangles at full detail
 	u64 triCount = 0;
+	// Bounding sphere (model space); radius is half the bounds diagonal
+	glm::vec3 centre = {};
+	f32 radius = 0.0f;
+	// Simplification error of each level of detail (see `core/mesh_simplifier.hpp`); empty if only full detail is available
+	std::vector<f32> lodErrors;
+	gfx::VertexFormat vertexFormat = gfx::VertexFormat::eFull;
 };
 struct Mesh::CreateInfo {
 	gfx::Geometry geometry;
 	Material::Inst material;
 	Type type = Type::eStatic;
+	///
+	/// \brief Reorder indices / vertices for GPU cache locality and overdraw before upload (eStatic only)
+	///
+	bool bOptimise = false;
+	///
+	/// \brief Levels of detail to generate by simplification, including full detail (eStatic only)
+	///
+	u8 lodCount = 1;
+	///
+	/// \brief Vertex buffer layout (eStatic only: dynamic meshes are always eFull)
+	///
+	gfx::VertexFormat vertexFormat = gfx::VertexFormat::eFull;
 };
 
 struct Font::Glyph {
@@ -329,6 +365,8 @@ struct Model::TexData {
 	bytearray bytes;
 	Hash samplerID;
 	Hash hash;
+	// Loaded in advance (if set): ownership transfers to the Model
+	Texture loaded;
 };
 struct Model::MatData {
 	stdfs::path id;
@@ -339,6 +377,8 @@ struct Model::MatData {
 	f32 shininess = 32.0f;
 	res::Material::Flags flags;
 	Hash hash;
+	// Loaded in advance (if set): ownership transfers to the Model
+	Material loaded;
 };
 struct Model::MeshData {
 	gfx::Geometry geometry;
@@ -346,6 +386,8 @@ struct Model::MeshData {
 	std::vector<std::size_t> materialIndices;
 	f32 shininess = 32.0f;
 	Hash hash;
+	// Loaded in advance (if set): ownership transfers to the Model
+	Mesh loaded;
 };
 struct Model::Info : InfoBase {
 	glm::vec3 origin;
@@ -362,12 +404,26 @@ struct Model::CreateInfo {
 	res::Mesh::Type type = res::Mesh::Type::eStatic;
 	res::Texture::Space mode = res::Texture::Space::eSRGBNonLinear;
 	Colour tint = colours::white;
+	// Levels of detail generated per mesh (see Mesh::CreateInfo)
+	u8 lodCount = 1;
+	gfx::VertexFormat vertexFormat = gfx::VertexFormat::eFull;
 	bool bDropColour = false;
 };
 struct Model::LoadInfo : LoadBase<Model> {
 	stdfs::path idRoot;
 	stdfs::path jsonDirectory;
 	std::string jsonFilename;
+	// Read texture bytes in createInfo() (otherwise left to the caller)
+	bool bTextureBytes = true;
+
+	///
+	/// \brief Parse .json / .OBJ / .MTL data via `reader` and serialise it as a precooked `.lvmesh` (see `core/lvmesh.hpp`)
+	///
+	/// createInfo() loads `<json stem>.lvmesh` (if present alongside the JSON) instead of parsing OBJ / MTL;
+	/// scale, origin, and dropColour are baked in, so the model must be re-cooked when its sources change.
+	/// \returns empty bytearray on failure
+	///
+	bytearray cook(io::Reader const& reader) const;
 };
 
 template <>
@@ -1,7 +1,9 @@
 #pragma once
 #include <filesystem>
 #include <type_traits>
+#include <utility>
 #include <core/counter.hpp>
+#include <core/handle_table.hpp>
 #include <core/tasks.hpp>
 #include <engine/resources/resource_types.hpp>
 
@@ -10,13 +12,27 @@ namespace stdfs = std::filesystem;
 }
 
 namespace le::res {
-using Semaphore = TCounter<s32>::Semaphore;
+///
+/// \brief Blocks deinit until released, and pins the epoch it was acquired in: resources unloaded meanwhile are not destroyed
+///
+struct Semaphore final {
+	TCounter<s32>::Semaphore counter;
+	ReaderEpochs::Pin pin;
+
+	void reset() noexcept {
+		counter.reset();
+		pin.reset();
+	}
+};
 template <typename T>
 using Result = kt::result_void<T>;
 
 ///
 /// \brief Acquire a semaphore to block deinit/unload until (all have been) released
 ///
+/// Lookups (find / info / impl) are lock-free, and their results stay valid until the next update on the main thread;
+/// other threads that keep them across updates must hold a semaphore for that duration.
+///
 Semaphore acquire();
 
 ///
@@ -45,6 +61,28 @@ struct TScoped final : NoCopy {
 	bool ready() const;
 };
 
+///
+/// \brief Reference-counted handle to a resource (never unloads; prevents eviction while alive)
+///
+template <typename T>
+struct TShared final {
+	static_assert(std::is_base_of_v<Resource<T>, T>, "T must derive from Resource!");
+	T resource;
+
+	TShared(T t = T{});
+	TShared(TShared const& rhs);
+	TShared(TShared&& rhs) noexcept;
+	TShared& operator=(TShared rhs) noexcept;
+	~TShared();
+
+	///
+	/// \brief Implicitly cast to T
+	///
+	constexpr operator T const &() const noexcept {
+		return resource;
+	}
+};
+
 template <typename T>
 class Async final {
   public:
@@ -302,11 +340,72 @@ bool unload<Model>(Hash id);
 ///
 bool unload(Hash id);
 
+///
+/// \brief Increment a resource's reference count (referenced resources are never evicted)
+///
+template <typename T>
+bool retain(T resource);
+///
+/// \brief Decrement a resource's reference count
+///
+template <typename T>
+bool release(T resource);
+///
+/// \brief Stamp a resource as used this frame (requests a reload if it has been evicted)
+///
+template <typename T>
+void touch(T resource);
+
+///
+/// \brief Set the memory budget for an evictable resource type (Texture, Mesh); 0 == unlimited
+/// Unreferenced resources are evicted in least-recently-used order while usage exceeds the budget
+///
+template <typename T>
+void setBudget(Footprint budget);
+///
+/// \brief Obtain the memory budget for an evictable resource type
+///
+template <typename T>
+Footprint budget();
+///
+/// \brief Obtain the memory currently used by an evictable resource type (as of the last update)
+///
+template <typename T>
+Footprint usage();
+
+template <>
+void setBudget<Texture>(Footprint budget);
+template <>
+Footprint budget<Texture>();
+template <>
+Footprint usage<Texture>();
+template <>
+void setBudget<Mesh>(Footprint budget);
+template <>
+Footprint budget<Mesh>();
+template <>
+Footprint usage<Mesh>();
+
 template <typename T>
 Result<T> find(Hash) {
 	static_assert(alwaysFalse<T>, "Invalid type!");
 }
 
+template <typename T>
+void setBudget(Footprint) {
+	static_assert(alwaysFalse<T>, "Invalid type!");
+}
+
+template <typename T>
+Footprint budget() {
+	static_assert(alwaysFalse<T>, "Invalid type!");
+}
+
+template <typename T>
+Footprint usage() {
+	static_assert(alwaysFalse<T>, "Invalid type!");
+}
+
 template <typename T>
 constexpr TScoped<T>::TScoped(TScoped<T>&& rhs) noexcept : resource(std::move(rhs.resource)) {
 }
@@ -330,6 +429,31 @@ bool TScoped<T>::ready() const {
 	return resource.guid != GUID::null && resource.status() == Status::eReady;
 }
 
+template <typename T>
+TShared<T>::TShared(T t) : resource(t) {
+	retain(resource);
+}
+
+template <typename T>
+TShared<T>::TShared(TShared<T> const& rhs) : resource(rhs.resource) {
+	retain(resource);
+}
+
+template <typename T>
+TShared<T>::TShared(TShared<T>&& rhs) noexcept : resource(std::exchange(rhs.resource, T{})) {
+}
+
+template <typename T>
+TShared<T>& TShared<T>::operator=(TShared<T> rhs) noexcept {
+	std::swap(resource, rhs.resource);
+	return *this;
+}
+
+template <typename T>
+TShared<T>::~TShared() {
+	release(resource);
+}
+
 template <typename T>
 Async<T>::~Async() {
 	if (m_task) {
@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+
+namespace le::bc {
+///
+/// \brief Block compression formats (4x4 texel blocks)
+///
+/// BC1: RGB + 1-bit alpha, 8 bytes per block
+/// BC3: RGB + interpolated alpha, 16 bytes per block
+/// BC5: two independent channels (RG, eg normal maps), 16 bytes per block
+/// BC7: RGBA, 16 bytes per block (encoded / decoded in mode 6 only)
+///
+enum class Format : s8 { eBC1, eBC3, eBC5, eBC7, eCOUNT_ };
+
+constexpr u32 blockExtent = 4;
+
+///
+/// \brief Obtain the number of bytes per block
+///
+std::size_t blockSize(Format format) noexcept;
+///
+/// \brief Obtain the number of bytes required to store an image of `width x height` texels
+///
+std::size_t imageSize(Format format, u32 width, u32 height) noexcept;
+
+///
+/// \brief Encode a block of 4x4 RGBA8 texels (row-major) into `out_block`
+///
+void encodeBlock(Format format, u8 const* pRGBA, u8* out_block);
+///
+/// \brief Decode a block into 4x4 RGBA8 texels (row-major); BC5 outputs (R, G, 0, 255)
+/// \returns false if the block uses an unsupported BC7 mode
+///
+bool decodeBlock(Format format, u8 const* pBlock, u8* out_rgba);
+
+///
+/// \brief Encode an RGBA8 image (edge texels repeated to fill partial blocks)
+/// Block rows are split across task workers when `bParallel` is set (the calling thread participates)
+///
+std::vector<u8> encode(Format format, Span<u8> rgba, u32 width, u32 height, bool bParallel = true);
+///
+/// \brief Decode an image into RGBA8
+/// \returns empty vector on invalid size / unsupported blocks
+///
+std::vector<u8> decode(Format format, Span<u8> blocks, u32 width, u32 height);
+} // namespace le::bc
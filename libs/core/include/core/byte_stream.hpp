@@ -0,0 +1,155 @@
+#pragma once
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+
+namespace le::io {
+///
+/// \brief Serialises trivially copyable values, strings and vectors thereof into a byte buffer (native endianness)
+///
+class ByteWriter final {
+  public:
+	template <typename T>
+	ByteWriter& write(T const& value);
+	ByteWriter& write(std::string_view str);
+	ByteWriter& write(std::string const& str);
+	template <typename T>
+	ByteWriter& write(std::vector<T> const& vec);
+
+	bytearray const& bytes() const noexcept;
+	bytearray release() noexcept;
+
+  private:
+	void append(void const* pData, std::size_t size);
+
+	bytearray m_bytes;
+};
+
+///
+/// \brief Deserialises data written via ByteWriter; any out-of-bounds read fails the stream
+///
+class ByteReader final {
+  public:
+	ByteReader(Span<std::byte> bytes) noexcept;
+
+	template <typename T>
+	ByteReader& read(T& out_value);
+	ByteReader& read(std::string& out_str);
+	template <typename T>
+	ByteReader& read(std::vector<T>& out_vec);
+
+	bool good() const noexcept;
+	bool eof() const noexcept;
+	explicit operator bool() const noexcept;
+
+  private:
+	bool extract(void* pOut, std::size_t size);
+
+	Span<std::byte> m_bytes;
+	std::size_t m_position = 0;
+	bool m_bGood = true;
+};
+
+// impl
+
+template <typename T>
+ByteWriter& ByteWriter::write(T const& value) {
+	static_assert(std::is_trivially_copyable_v<T>, "Unsupported type");
+	append(&value, sizeof(T));
+	return *this;
+}
+inline ByteWriter& ByteWriter::write(std::string_view str) {
+	write((u64)str.size());
+	append(str.data(), str.size());
+	return *this;
+}
+inline ByteWriter& ByteWriter::write(std::string const& str) {
+	return write(std::string_view(str));
+}
+template <typename T>
+ByteWriter& ByteWriter::write(std::vector<T> const& vec) {
+	write((u64)vec.size());
+	if constexpr (std::is_trivially_copyable_v<T>) {
+		append(vec.data(), vec.size() * sizeof(T));
+	} else {
+		for (auto const& t : vec) {
+			write(t);
+		}
+	}
+	return *this;
+}
+inline bytearray const& ByteWriter::bytes() const noexcept {
+	return m_bytes;
+}
+inline bytearray ByteWriter::release() noexcept {
+	return std::move(m_bytes);
+}
+inline void ByteWriter::append(void const* pData, std::size_t size) {
+	if (size > 0) {
+		auto const offset = m_bytes.size();
+		m_bytes.resize(offset + size);
+		std::memcpy(m_bytes.data() + offset, pData, size);
+	}
+}
+
+inline ByteReader::ByteReader(Span<std::byte> bytes) noexcept : m_bytes(bytes) {
+}
+template <typename T>
+ByteReader& ByteReader::read(T& out_value) {
+	static_assert(std::is_trivially_copyable_v<T>, "Unsupported type");
+	extract(&out_value, sizeof(T));
+	return *this;
+}
+inline ByteReader& ByteReader::read(std::string& out_str) {
+	u64 size = 0;
+	if (read(size) && size <= m_bytes.size() - m_position) {
+		out_str.resize((std::size_t)size);
+		extract(out_str.data(), out_str.size());
+	} else {
+		m_bGood = false;
+	}
+	return *this;
+}
+template <typename T>
+ByteReader& ByteReader::read(std::vector<T>& out_vec) {
+	u64 size = 0;
+	// every element occupies at least one byte: reject sizes that cannot possibly fit
+	if (read(size) && size <= m_bytes.size() - m_position) {
+		out_vec.resize((std::size_t)size);
+		if constexpr (std::is_trivially_copyable_v<T>) {
+			extract(out_vec.data(), out_vec.size() * sizeof(T));
+		} else {
+			for (auto& t : out_vec) {
+				read(t);
+			}
+		}
+	} else {
+		m_bGood = false;
+	}
+	return *this;
+}
+inline bool ByteReader::good() const noexcept {
+	return m_bGood;
+}
+inline bool ByteReader::eof() const noexcept {
+	return m_position >= m_bytes.size();
+}
+inline ByteReader::operator bool() const noexcept {
+	return m_bGood;
+}
+inline bool ByteReader::extract(void* pOut, std::size_t size) {
+	if (!m_bGood || size > m_bytes.size() - m_position) {
+		m_bGood = false;
+		return false;
+	}
+	if (size > 0) {
+		std::memcpy(pOut, m_bytes.pData + m_position, size);
+		m_position += size;
+	}
+	return true;
+}
+} // namespace le::io
@@ -0,0 +1,230 @@
+#pragma once
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <core/log.hpp>
+#include <core/std_types.hpp>
+#include <core/time.hpp>
+
+namespace le::deferred {
+///
+/// \brief Deferred logger setup
+///
+struct Config final {
+	///
+	/// \brief Capacity of each thread's record buffer (rounded up to a power of two)
+	///
+	std::size_t recordsPerThread = 1024;
+	///
+	/// \brief Interval between drains of thread buffers
+	///
+	Time interval = 2ms;
+};
+
+///
+/// \brief RAII Service to initialise/deinitialise the deferred logger
+///
+struct Service final {
+	Service(Config config = {});
+	~Service();
+};
+
+///
+/// \brief Log a message with formatting deferred to a background thread
+/// Arguments are copied as raw bytes into a per-thread lock-free buffer and formatted/dispatched via `dl::log`
+/// (console, file, `dl::config::g_on_log`) later; `format` must be a string literal.
+/// Strings and trivially copyable types are deferred, any other argument type formats on the calling thread.
+/// Falls back to `dl::log` if the deferred logger is not running (or is shutting down) or the thread's buffer is full.
+/// Deferred lines are prefixed with their capture time (seconds since start), since sinks stamp lines when they are dispatched.
+///
+template <std::size_t N, typename... Args>
+void log(dl::level level, char const (&format)[N], Args const&... args);
+template <std::size_t N, typename... Args>
+void logD(char const (&format)[N], Args const&... args);
+template <std::size_t N, typename... Args>
+void logI(char const (&format)[N], Args const&... args);
+template <std::size_t N, typename... Args>
+void logW(char const (&format)[N], Args const&... args);
+template <std::size_t N, typename... Args>
+void logE(char const (&format)[N], Args const&... args);
+
+///
+/// \brief Check whether the deferred logger is running
+///
+bool active();
+///
+/// \brief Block until all records pushed before this call have been dispatched
+///
+void flush();
+
+///
+/// \brief Manually initialise the deferred logger (starts background thread)
+///
+bool init(Config config);
+///
+/// \brief Manually deinitialise the deferred logger (dispatches pending records)
+///
+void deinit();
+
+namespace detail {
+struct Record final {
+	using Emit = void (*)(Record const&);
+
+	static constexpr std::size_t payloadSize = 192;
+
+	Emit emit = nullptr;
+	std::string_view fmt;
+	Time timestamp;
+	dl::level level;
+	alignas(16) std::array<std::byte, payloadSize> payload;
+};
+
+///
+/// \brief Stored in place of string arguments: refers to characters copied into the payload
+///
+struct Str final {
+	u16 offset;
+	u16 size;
+};
+
+template <typename T>
+constexpr bool isStr_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> || std::is_same_v<T, char const*> || std::is_same_v<T, char*>;
+template <typename T>
+using Stored = std::conditional_t<isStr_v<std::decay_t<T>>, Str, std::decay_t<T>>;
+template <typename T>
+constexpr bool deferrable_v = isStr_v<std::decay_t<T>> || (std::is_trivially_copyable_v<std::decay_t<T>> && alignof(std::decay_t<T>) <= 16);
+
+///
+/// \brief Obtain a free record in the calling thread's buffer
+/// \returns `nullptr` if inactive / full
+///
+Record* acquire();
+///
+/// \brief Publish the record last obtained via `acquire()`
+///
+void publish();
+///
+/// \brief Discard the record last obtained via `acquire()` (without publishing it)
+///
+void abandon();
+
+template <typename... S>
+constexpr std::array<std::size_t, sizeof...(S) + 1> offsets() {
+	std::array<std::size_t, sizeof...(S) + 1> ret{};
+	std::size_t offset = 0;
+	std::size_t idx = 0;
+	((offset = (offset + alignof(S) - 1) / alignof(S) * alignof(S), ret[idx++] = offset, offset += sizeof(S)), ...);
+	ret[idx] = offset;
+	return ret;
+}
+
+template <typename T>
+bool encode(Record& out_record, std::size_t offset, std::size_t& out_chars, T const& arg) {
+	if constexpr (isStr_v<std::decay_t<T>>) {
+		std::string_view str;
+		if constexpr (std::is_pointer_v<std::decay_t<T>>) {
+			str = arg ? std::string_view(arg) : std::string_view("(null)");
+		} else {
+			str = arg;
+		}
+		if (out_chars + str.size() > Record::payloadSize) {
+			return false;
+		}
+		std::memcpy(out_record.payload.data() + out_chars, str.data(), str.size());
+		Str const ref{(u16)out_chars, (u16)str.size()};
+		std::memcpy(out_record.payload.data() + offset, &ref, sizeof(ref));
+		out_chars += str.size();
+	} else {
+		Stored<T> const value = arg;
+		std::memcpy(out_record.payload.data() + offset, &value, sizeof(value));
+	}
+	return true;
+}
+
+template <typename S>
+decltype(auto) decode(Record const& record, std::size_t offset) {
+	if constexpr (std::is_same_v<S, Str>) {
+		Str ref;
+		std::memcpy(&ref, record.payload.data() + offset, sizeof(ref));
+		return std::string_view(reinterpret_cast<char const*>(record.payload.data()) + ref.offset, ref.size);
+	} else {
+		return *reinterpret_cast<S const*>(record.payload.data() + offset);
+	}
+}
+
+template <typename... S, std::size_t... I>
+void emit(Record const& record, std::index_sequence<I...>) {
+	constexpr auto offs = offsets<S...>();
+	auto const message = fmt::format(record.fmt, decode<S>(record, offs[I])...);
+	dl::log(record.level, "[{:.3f}] {}", record.timestamp.to_s(), message);
+}
+
+template <typename... S>
+void emit(Record const& record) {
+	emit<S...>(record, std::index_sequence_for<S...>());
+}
+
+template <typename... Args>
+bool push(dl::level level, std::string_view format, Args const&... args) {
+	using Offsets = std::array<std::size_t, sizeof...(Args) + 1>;
+	constexpr Offsets offs = offsets<Stored<Args>...>();
+	static_assert(offs.back() <= Record::payloadSize, "Too many arguments");
+	Record* pRecord = acquire();
+	if (!pRecord) {
+		return false;
+	}
+	std::size_t chars = offs.back();
+	std::size_t idx = 0;
+	bool bFits = true;
+	((bFits = bFits && encode(*pRecord, offs[idx++], chars, args)), ...);
+	if (!bFits) {
+		abandon();
+		return false;
+	}
+	pRecord->emit = &emit<Stored<Args>...>;
+	pRecord->fmt = format;
+	pRecord->timestamp = Time::elapsed();
+	pRecord->level = level;
+	publish();
+	return true;
+}
+} // namespace detail
+
+// impl
+
+template <std::size_t N, typename... Args>
+void log(dl::level level, char const (&format)[N], Args const&... args) {
+	std::string_view const fmtStr(format, N - 1);
+	if constexpr ((detail::deferrable_v<Args> && ...)) {
+		if (!detail::push(level, fmtStr, args...)) {
+			dl::log(level, fmtStr, args...);
+		}
+	} else {
+		auto const formatted = fmt::format(fmtStr, args...);
+		if (!detail::push(level, "{}", formatted)) {
+			dl::log(level, "{}", formatted);
+		}
+	}
+}
+template <std::size_t N, typename... Args>
+void logD([[maybe_unused]] char const (&format)[N], [[maybe_unused]] Args const&... args) {
+	if constexpr (dl::dlog_debug) {
+		log(dl::level::debug, format, args...);
+	}
+}
+template <std::size_t N, typename... Args>
+void logI(char const (&format)[N], Args const&... args) {
+	log(dl::level::info, format, args...);
+}
+template <std::size_t N, typename... Args>
+void logW(char const (&format)[N], Args const&... args) {
+	log(dl::level::warning, format, args...);
+}
+template <std::size_t N, typename... Args>
+void logE(char const (&format)[N], Args const&... args) {
+	log(dl::level::error, format, args...);
+}
+} // namespace le::deferred
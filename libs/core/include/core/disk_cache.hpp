@@ -0,0 +1,56 @@
+#pragma once
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+
+namespace le::io {
+namespace stdfs = std::filesystem;
+
+///
+/// \brief Content-addressed cache of binary blobs on the filesystem
+/// Entries are keyed by a hash of their source data and import options (see `key()`); each is stored in its own file
+/// with a checksum, and written atomically (temp file + rename) so concurrent loaders never observe partial entries.
+///
+class DiskCache final {
+  public:
+	static constexpr u32 version = 1;
+
+  public:
+	DiskCache() = default;
+	explicit DiskCache(stdfs::path directory);
+
+	///
+	/// \brief Compute an entry key from source bytes and import options
+	///
+	static u64 key(Span<std::byte> source, std::string_view options = {}) noexcept;
+
+	///
+	/// \brief Set cache directory (created if not present)
+	///
+	bool open(stdfs::path directory);
+	void close();
+	bool active() const noexcept;
+	stdfs::path const& directory() const noexcept;
+
+	///
+	/// \brief Load a cached entry
+	/// \returns `std::nullopt` on a miss / if the entry is corrupt (which is then removed)
+	///
+	std::optional<bytearray> load(u64 key) const;
+	///
+	/// \brief Store an entry (replaces any existing one)
+	///
+	bool store(u64 key, Span<std::byte> data) const;
+	///
+	/// \brief Remove an entry
+	///
+	bool erase(u64 key) const;
+
+  private:
+	stdfs::path path(u64 key) const;
+
+	stdfs::path m_directory;
+};
+} // namespace le::io
@@ -4,6 +4,7 @@
 #include <typeindex>
 #include <typeinfo>
 #include <core/counter.hpp>
+#include <core/deferred_log.hpp>
 #include <core/ecs/storage.hpp>
 #include <core/log.hpp>
 #include <kt/async_queue/async_queue.hpp>
@@ -274,7 +275,9 @@ inline bool Registry::destroy(Entity entity) {
 	for (auto& [_, uConcept] : m_db) {
 		bRet |= uConcept->detach(entity);
 	}
-	log_if(bRet && m_logLevel && !name.empty(), m_logLevel.value_or(dl::level::debug), "[{}] [{}:{}] [{}] destroyed", m_name, s_tEName, entity.id, name);
+	if (bRet && m_logLevel && !name.empty()) {
+		deferred::log(*m_logLevel, "[{}] [{}:{}] [{}] destroyed", m_name, s_tEName, entity.id, name);
+	}
 	return bRet;
 }
 
@@ -503,7 +506,9 @@ inline Entity Registry::spawn_Impl(std::string name) {
 	Entity ret{id, m_regID};
 	auto& info = attach_Impl<Info>(ret, {});
 	info.name = std::move(name);
-	log_if(m_logLevel, m_logLevel.value_or(dl::level::debug), "[{}] [{}:{}] [{}] spawned", m_name, s_tEName, id, info.name);
+	if (m_logLevel) {
+		deferred::log(*m_logLevel, "[{}] [{}:{}] [{}] spawned", m_name, s_tEName, id, info.name);
+	}
 	return ret;
 }
 
@@ -512,7 +517,7 @@ T& Registry::attach_Impl(Entity entity, std::string_view name, Args&&... args) {
 	auto& storage = get_Impl<T>();
 	ENSURE(!storage.find(entity), "Duplicate component!");
 	if (m_logLevel && !name.empty()) {
-		dl::log(*m_logLevel, "[{}] [{}] attached to [{}:{}] [{}]", m_name, name_Impl<T>(), s_tEName, entity.id, name);
+		deferred::log(*m_logLevel, "[{}] [{}] attached to [{}:{}] [{}]", m_name, name_Impl<T>(), s_tEName, entity.id, name);
 	}
 	return storage.attach(entity, std::forward<Args>(args)...);
 }
@@ -522,7 +527,7 @@ bool Registry::detach_Impl(Entity entity, std::string_view name) {
 	auto& storage = get_Impl<T>();
 	if (storage.exists(entity)) {
 		if (m_logLevel && !name.empty()) {
-			dl::log(*m_logLevel, "[{}] [{}] detached from [{}:{}] [{}] and destroyed", m_name, name_Impl<T>(), s_tEName, entity.id, name);
+			deferred::log(*m_logLevel, "[{}] [{}] detached from [{}:{}] [{}] and destroyed", m_name, name_Impl<T>(), s_tEName, entity.id, name);
 		}
 		return storage.detach(entity);
 	}
@@ -0,0 +1,316 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+#include <core/std_types.hpp>
+
+namespace le {
+///
+/// \brief Generational slot array: handles index slots directly, with lock-free reads
+///
+/// Handle layout: [serial: 32 | index: 32]; serials must be unique per reservation (and non-zero) for stale handles to be rejected.
+/// Slots live in fixed-size chunks that are never moved or freed while the table is alive, so readers need no locks.
+/// Removed objects are retired (not destroyed) with the writer's epoch, and destroyed by `reclaim(epoch)`; the caller
+/// must choose an epoch no reader can still hold a pointer from (see ReaderEpochs for readers that span epochs).
+/// Writer functions (reserve, publish, unreserve, remove, reclaim, forEach, clear) must be externally synchronised.
+///
+///
+/// \brief Registry of epochs pinned by readers that keep pointers across writer epochs (eg worker tasks)
+///
+/// A reader pins the current epoch before its first lookup and releases the pin when it no longer holds any pointers;
+/// `oldest(bound)` is then the highest epoch that is safe to pass to `THandleTable::reclaim()`.
+///
+class ReaderEpochs final {
+  public:
+	///
+	/// \brief RAII pin (released on destruction / reset)
+	///
+	class Pin final {
+	  public:
+		Pin() = default;
+		Pin(Pin&& rhs) noexcept;
+		Pin& operator=(Pin&& rhs) noexcept;
+		~Pin();
+
+		void reset() noexcept;
+
+	  private:
+		Pin(ReaderEpochs& out_readers, u64 epoch) noexcept : m_pReaders(&out_readers), m_epoch(epoch) {
+		}
+
+		ReaderEpochs* m_pReaders = nullptr;
+		u64 m_epoch = 0;
+
+		friend class ReaderEpochs;
+	};
+
+  public:
+	Pin pin(u64 epoch);
+	///
+	/// \brief Obtain the oldest pinned epoch, or `bound` if it is older / nothing is pinned
+	///
+	u64 oldest(u64 bound) const;
+	std::size_t pinned() const;
+
+  private:
+	void unpin(u64 epoch) noexcept;
+
+	std::multiset<u64> m_epochs;
+	mutable std::mutex m_mutex;
+};
+
+template <typename T, std::size_t ChunkSize = 256, std::size_t MaxChunks = 4096>
+class THandleTable final {
+	static_assert(ChunkSize > 0 && MaxChunks > 0, "Invalid size");
+
+  public:
+	using type = T;
+	using Handle = u64;
+
+	static constexpr std::size_t maxSlots = ChunkSize * MaxChunks;
+
+	static constexpr u32 index(Handle handle) noexcept {
+		return (u32)(handle & 0xffffffff);
+	}
+	static constexpr u32 serial(Handle handle) noexcept {
+		return (u32)(handle >> 32);
+	}
+
+  public:
+	THandleTable() = default;
+	THandleTable(THandleTable&&) = delete;
+	THandleTable& operator=(THandleTable&&) = delete;
+	~THandleTable();
+
+	///
+	/// \brief Lock-free lookup
+	/// \returns `nullptr` if handle is stale / not published
+	///
+	T* find(Handle handle) const noexcept;
+
+	///
+	/// \brief Reserve a slot (not visible to `find()` until published)
+	/// \returns 0 if out of slots
+	///
+	Handle reserve(u32 serial);
+	///
+	/// \brief Publish an object into a reserved slot
+	///
+	T& publish(Handle handle, std::unique_ptr<T>&& uT);
+	///
+	/// \brief Return a reserved (unpublished) slot
+	///
+	void unreserve(Handle handle);
+	///
+	/// \brief Unpublish and retire an object (destroyed in `reclaim()`)
+	///
+	bool remove(Handle handle, u64 epoch);
+	///
+	/// \brief Destroy all objects retired before `epoch`
+	///
+	std::size_t reclaim(u64 epoch);
+	///
+	/// \brief Iterate over published objects: `f(Handle, T&)`
+	///
+	template <typename F>
+	void forEach(F&& f) const;
+	///
+	/// \brief Destroy all objects (no concurrent readers allowed)
+	///
+	void clear();
+
+	std::size_t size() const noexcept;
+	std::size_t retired() const noexcept;
+
+  private:
+	struct Slot final {
+		std::atomic<Handle> handle = 0;
+		std::atomic<T*> pT = nullptr;
+	};
+
+	Slot* slot(u32 idx) const noexcept;
+
+	std::array<std::atomic<Slot*>, MaxChunks> m_chunks = {};
+	std::vector<std::unique_ptr<Slot[]>> m_storage;
+	std::vector<std::pair<u64, std::unique_ptr<T>>> m_retired;
+	std::vector<u32> m_free;
+	u32 m_next = 0;
+	std::size_t m_size = 0;
+};
+
+// impl
+
+inline ReaderEpochs::Pin::Pin(Pin&& rhs) noexcept : m_pReaders(std::exchange(rhs.m_pReaders, nullptr)), m_epoch(rhs.m_epoch) {
+}
+
+inline ReaderEpochs::Pin& ReaderEpochs::Pin::operator=(Pin&& rhs) noexcept {
+	if (&rhs != this) {
+		reset();
+		m_pReaders = std::exchange(rhs.m_pReaders, nullptr);
+		m_epoch = rhs.m_epoch;
+	}
+	return *this;
+}
+
+inline ReaderEpochs::Pin::~Pin() {
+	reset();
+}
+
+inline void ReaderEpochs::Pin::reset() noexcept {
+	if (m_pReaders) {
+		m_pReaders->unpin(m_epoch);
+		m_pReaders = nullptr;
+	}
+}
+
+inline ReaderEpochs::Pin ReaderEpochs::pin(u64 epoch) {
+	std::scoped_lock lock(m_mutex);
+	m_epochs.insert(epoch);
+	return Pin(*this, epoch);
+}
+
+inline u64 ReaderEpochs::oldest(u64 bound) const {
+	std::scoped_lock lock(m_mutex);
+	return m_epochs.empty() ? bound : std::min(bound, *m_epochs.begin());
+}
+
+inline std::size_t ReaderEpochs::pinned() const {
+	std::scoped_lock lock(m_mutex);
+	return m_epochs.size();
+}
+
+inline void ReaderEpochs::unpin(u64 epoch) noexcept {
+	std::scoped_lock lock(m_mutex);
+	if (auto search = m_epochs.find(epoch); search != m_epochs.end()) {
+		m_epochs.erase(search);
+	}
+}
+
+template <typename T, std::size_t C, std::size_t M>
+THandleTable<T, C, M>::~THandleTable() {
+	clear();
+}
+
+template <typename T, std::size_t C, std::size_t M>
+T* THandleTable<T, C, M>::find(Handle handle) const noexcept {
+	Slot const* pSlot = slot(index(handle));
+	if (!pSlot || handle == 0 || pSlot->handle.load(std::memory_order_acquire) != handle) {
+		return nullptr;
+	}
+	T* ret = pSlot->pT.load(std::memory_order_acquire);
+	// re-check: slot may have been recycled between loads (serials are never reused)
+	return pSlot->handle.load(std::memory_order_acquire) == handle ? ret : nullptr;
+}
+
+template <typename T, std::size_t C, std::size_t M>
+typename THandleTable<T, C, M>::Handle THandleTable<T, C, M>::reserve(u32 serial) {
+	u32 idx;
+	if (!m_free.empty()) {
+		idx = m_free.back();
+		m_free.pop_back();
+	} else {
+		if ((std::size_t)m_next >= maxSlots) {
+			return 0;
+		}
+		idx = m_next++;
+		auto& chunk = m_chunks[idx / C];
+		if (!chunk.load(std::memory_order_relaxed)) {
+			m_storage.push_back(std::make_unique<Slot[]>(C));
+			chunk.store(m_storage.back().get(), std::memory_order_release);
+		}
+	}
+	return ((Handle)serial << 32) | (Handle)idx;
+}
+
+template <typename T, std::size_t C, std::size_t M>
+T& THandleTable<T, C, M>::publish(Handle handle, std::unique_ptr<T>&& uT) {
+	Slot* pSlot = slot(index(handle));
+	T* pT = uT.release();
+	pSlot->pT.store(pT, std::memory_order_release);
+	pSlot->handle.store(handle, std::memory_order_release);
+	++m_size;
+	return *pT;
+}
+
+template <typename T, std::size_t C, std::size_t M>
+void THandleTable<T, C, M>::unreserve(Handle handle) {
+	m_free.push_back(index(handle));
+}
+
+template <typename T, std::size_t C, std::size_t M>
+bool THandleTable<T, C, M>::remove(Handle handle, u64 epoch) {
+	Slot* pSlot = slot(index(handle));
+	if (!pSlot || handle == 0 || pSlot->handle.load(std::memory_order_relaxed) != handle) {
+		return false;
+	}
+	pSlot->handle.store(0, std::memory_order_release);
+	m_retired.push_back({epoch, std::unique_ptr<T>(pSlot->pT.exchange(nullptr, std::memory_order_acq_rel))});
+	m_free.push_back(index(handle));
+	--m_size;
+	return true;
+}
+
+template <typename T, std::size_t C, std::size_t M>
+std::size_t THandleTable<T, C, M>::reclaim(u64 epoch) {
+	std::size_t ret = 0;
+	for (auto iter = m_retired.begin(); iter != m_retired.end();) {
+		if (iter->first < epoch) {
+			iter = m_retired.erase(iter);
+			++ret;
+		} else {
+			++iter;
+		}
+	}
+	return ret;
+}
+
+template <typename T, std::size_t C, std::size_t M>
+template <typename F>
+void THandleTable<T, C, M>::forEach(F&& f) const {
+	for (u32 idx = 0; idx < m_next; ++idx) {
+		Slot* pSlot = slot(idx);
+		if (auto const handle = pSlot->handle.load(std::memory_order_relaxed); handle != 0) {
+			f(handle, *pSlot->pT.load(std::memory_order_relaxed));
+		}
+	}
+}
+
+template <typename T, std::size_t C, std::size_t M>
+void THandleTable<T, C, M>::clear() {
+	for (u32 idx = 0; idx < m_next; ++idx) {
+		Slot* pSlot = slot(idx);
+		pSlot->handle.store(0, std::memory_order_release);
+		delete pSlot->pT.exchange(nullptr);
+	}
+	m_retired.clear();
+	m_free.clear();
+	for (u32 idx = m_next; idx > 0; --idx) {
+		m_free.push_back(idx - 1);
+	}
+	m_size = 0;
+}
+
+template <typename T, std::size_t C, std::size_t M>
+std::size_t THandleTable<T, C, M>::size() const noexcept {
+	return m_size;
+}
+
+template <typename T, std::size_t C, std::size_t M>
+std::size_t THandleTable<T, C, M>::retired() const noexcept {
+	return m_retired.size();
+}
+
+template <typename T, std::size_t C, std::size_t M>
+typename THandleTable<T, C, M>::Slot* THandleTable<T, C, M>::slot(u32 idx) const noexcept {
+	if ((std::size_t)idx >= C * M) {
+		return nullptr;
+	}
+	Slot* pChunk = m_chunks[idx / C].load(std::memory_order_acquire);
+	return pChunk ? pChunk + idx % C : nullptr;
+}
+} // namespace le
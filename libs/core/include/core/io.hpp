@@ -1,15 +1,49 @@
 #pragma once
 #include <filesystem>
 #include <optional>
+#include <core/std_types.hpp>
+#include <core/time.hpp>
 
 namespace le::io {
 namespace stdfs = std::filesystem;
 
+///
+/// \brief File logger setup
+///
+struct FileLogConfig final {
+	///
+	/// \brief Behaviour when the pending lines buffer is full
+	///
+	enum class Overflow : s8 { eBlock, eDropNewest, eDropOldest, eCOUNT_ };
+
+	///
+	/// \brief Capacity of pending lines (ring buffer)
+	///
+	std::size_t bufferLines = 4096;
+	///
+	/// \brief Pending bytes that trigger an early flush
+	///
+	std::size_t flushBytes = 64 * 1024;
+	///
+	/// \brief Maximum time a line remains pending before being flushed
+	///
+	Time flushInterval = 250ms;
+	///
+	/// \brief Log file size at which it is rotated (`0` disables rotation)
+	///
+	std::size_t rotateBytes = 16 * 1024 * 1024;
+	///
+	/// \brief Number of rotated files retained (`<path>.1` is the most recent)
+	///
+	u32 rotateCount = 3;
+	Overflow overflow = Overflow::eBlock;
+};
+
 ///
 /// \brief RAII wrapper for file logging
 ///
 struct Service final {
-	Service(std::optional<stdfs::path> logFilePath);
+	Service(std::optional<stdfs::path> logFilePath, FileLogConfig config = {});
 	~Service();
 };
 } // namespace le::io
@@ -0,0 +1,110 @@
+#pragma once
+#include <optional>
+#include <vector>
+#include <core/bc.hpp>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+
+namespace le::io {
+///
+/// \brief KTX 2.0 texture container (`.ktx2`)
+///
+/// Layout:
+/// 	Identifier, Header, Index
+/// 	LevelIndex[Header::levelCount] (level 0 = base / largest)
+/// 	Data Format Descriptor
+/// 	Level data (smallest level first; each level holds every layer and face, layer-major)
+/// Supercompressed (Basis / Zstd) files are not supported.
+///
+namespace ktx2 {
+constexpr u8 identifier[12] = {0xab, 0x4b, 0x54, 0x58, 0x20, 0x32, 0x30, 0xbb, 0x0d, 0x0a, 0x1a, 0x0a};
+
+///
+/// \brief Subset of VkFormat values supported by the engine
+///
+enum class VkFormat : u32 {
+	eUndefined = 0,
+	eR8G8B8A8Unorm = 37,
+	eR8G8B8A8Srgb = 43,
+	eBC1RGBAUnorm = 133,
+	eBC1RGBASrgb = 134,
+	eBC3Unorm = 137,
+	eBC3Srgb = 138,
+	eBC5Unorm = 141,
+	eBC7Unorm = 145,
+	eBC7Srgb = 146,
+};
+
+struct Header final {
+	u32 vkFormat = 0;
+	u32 typeSize = 1;
+	u32 pixelWidth = 0;
+	u32 pixelHeight = 0;
+	u32 pixelDepth = 0;
+	u32 layerCount = 0;
+	u32 faceCount = 1;
+	u32 levelCount = 1;
+	u32 supercompressionScheme = 0;
+	u32 dfdByteOffset = 0;
+	u32 dfdByteLength = 0;
+	u32 kvdByteOffset = 0;
+	u32 kvdByteLength = 0;
+	u64 sgdByteOffset = 0;
+	u64 sgdByteLength = 0;
+};
+
+struct LevelIndex final {
+	u64 byteOffset = 0;
+	u64 byteLength = 0;
+	u64 uncompressedByteLength = 0;
+};
+
+static_assert(sizeof(LevelIndex) == 24, "KTX2 layout changed!");
+
+///
+/// \brief Parsed (or to be written) image: `levels[idx]` holds `layers * faces` images of level `idx`
+///
+struct Image final {
+	VkFormat format = VkFormat::eUndefined;
+	u32 width = 0;
+	u32 height = 0;
+	u32 layers = 1;
+	u32 faces = 1;
+	std::vector<Span<u8>> levels;
+
+	///
+	/// \brief Obtain the image of `layer` (or face) at `level`
+	///
+	Span<u8> image(std::size_t level, std::size_t layer) const;
+};
+
+///
+/// \brief Check whether `bytes` begins with the KTX2 identifier
+///
+bool identify(Span<std::byte> bytes) noexcept;
+///
+/// \brief Parse a KTX2 file (spans in the returned Image point into `bytes`)
+/// \returns nullopt if invalid / supercompressed / of an unsupported format
+///
+std::optional<Image> parse(Span<std::byte> bytes);
+///
+/// \brief Serialise an image (supported formats only)
+/// \returns empty bytearray on failure
+///
+bytearray write(Image const& image);
+
+///
+/// \brief Obtain the number of bytes of a single `width x height` image in `format` (0 if unsupported)
+///
+std::size_t imageSize(VkFormat format, u32 width, u32 height) noexcept;
+///
+/// \brief Map a block compressed format to its VkFormat (BC5 has no sRGB variant)
+///
+VkFormat vkFormat(bc::Format format, bool bSRGB) noexcept;
+///
+/// \brief Map a VkFormat to its block compressed format (if any)
+///
+std::optional<bc::Format> bcFormat(VkFormat format) noexcept;
+bool isSRGB(VkFormat format) noexcept;
+} // namespace ktx2
+} // namespace le::io
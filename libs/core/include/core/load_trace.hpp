@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <core/std_types.hpp>
+#include <core/time.hpp>
+
+namespace le {
+///
+/// \brief Thread-safe recorder of per-resource load phases (disabled by default)
+///
+/// Exports recorded events as Chrome trace event JSON (chrome://tracing, ui.perfetto.dev) and as a table aggregated by resource type.
+/// Recording stops (the trace disables itself) once `capacity` events have been stored, so a long running session cannot grow it without bound.
+///
+class LoadTrace final {
+  public:
+	enum class Phase : s8 { eRead, eDecode, eProcess, eStage, eTransfer, eCOUNT_ };
+	static constexpr EnumArray<Phase> phaseNames = {"read", "decode", "process", "stage", "transfer"};
+	static constexpr std::size_t defaultCapacity = 1 << 16;
+
+	struct Event final {
+		std::string type;
+		std::string id;
+		Time begin;
+		Time end;
+		u32 thread = 0;
+		Phase phase = Phase::eRead;
+	};
+
+	struct Row final {
+		std::string type;
+		Phase phase = Phase::eRead;
+		u32 count = 0;
+		Time total;
+		Time max;
+	};
+
+	///
+	/// \brief RAII wrapper that records a phase on destruction (if the trace was enabled on construction)
+	///
+	class Scope final {
+	  public:
+		Scope() = default;
+		Scope(LoadTrace& out_trace, std::string_view type, std::string_view id, Phase phase);
+		Scope(Scope&&) noexcept;
+		Scope& operator=(Scope&&) noexcept;
+		~Scope();
+
+	  private:
+		LoadTrace* m_pTrace = nullptr;
+		Event m_event;
+	};
+
+  public:
+	///
+	/// \brief Obtain a small, stable, process-wide index for the calling thread (starts at 1)
+	///
+	static u32 thisThread() noexcept;
+
+	void enable(bool bEnable, std::size_t capacity = defaultCapacity);
+	bool enabled() const noexcept;
+	///
+	/// \brief Check whether recording stopped because `capacity` was reached (reset by `clear()`)
+	///
+	bool full() const;
+
+	///
+	/// \brief Record a phase on the calling thread (no-op if disabled)
+	///
+	void record(std::string_view type, std::string_view id, Phase phase, Time begin, Time end = Time::elapsed());
+	///
+	/// \brief Record an event as is (no-op if disabled)
+	///
+	void record(Event event);
+	///
+	/// \brief Obtain a scoped phase recorder (inactive if disabled)
+	///
+	Scope scope(std::string_view type, std::string_view id, Phase phase);
+
+	std::vector<Event> events() const;
+	void clear();
+
+	///
+	/// \brief Obtain all events as Chrome trace event JSON (timestamps in microseconds)
+	///
+	std::string chromeTrace() const;
+	bool writeChromeTrace(std::filesystem::path const& path) const;
+	///
+	/// \brief Obtain durations aggregated by resource type and phase (sorted)
+	///
+	std::vector<Row> table() const;
+	///
+	/// \brief Obtain `table()` as aligned text (one row per line)
+	///
+	std::string summary() const;
+
+  private:
+	std::vector<Event> m_events;
+	std::size_t m_capacity = defaultCapacity;
+	mutable std::mutex m_mutex;
+	std::atomic<bool> m_bEnabled = false;
+	bool m_bFull = false;
+};
+
+///
+/// \brief Global load trace (enabled via `load-trace[=path]`)
+///
+inline LoadTrace g_loadTrace;
+} // namespace le
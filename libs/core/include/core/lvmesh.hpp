@@ -0,0 +1,100 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <vector>
+#include <core/colour.hpp>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+#include <glm/vec3.hpp>
+
+namespace le::io {
+///
+/// \brief Precooked model container (`.lvmesh`)
+///
+/// Layout:
+/// 	Identifier, Header
+/// 	Table (Textures, Materials, Meshes; serialised via ByteWriter)
+/// 	Blobs (vertices and indices of each mesh, each aligned to `alignment`)
+/// Vertices are opaque to the container except for their stride and leading `glm::vec3` position (used for bounds).
+/// IDs and filenames are relative (to the model's ID root / JSON directory).
+///
+namespace lvmesh {
+constexpr u8 identifier[8] = {0xab, 0x4c, 0x56, 0x4d, 0x53, 0x48, 0x0d, 0x0a};
+constexpr u32 version = 1;
+constexpr std::size_t alignment = 16;
+
+struct Bounds final {
+	glm::vec3 min = glm::vec3(0.0f);
+	glm::vec3 max = glm::vec3(0.0f);
+};
+
+struct Header final {
+	u32 version = lvmesh::version;
+	u32 vertexStride = 0;
+	u64 tableSize = 0;
+	Bounds bounds;
+};
+
+struct Texture final {
+	std::string id;
+	std::string filename;
+};
+
+struct Material final {
+	std::string id;
+	std::vector<u32> diffuseIndices;
+	std::vector<u32> specularIndices;
+	std::vector<u32> bumpIndices;
+	Colour ambient;
+	Colour diffuse;
+	Colour specular;
+	f32 shininess = 32.0f;
+	u32 flags = 0;
+};
+
+struct Mesh final {
+	std::string id;
+	std::vector<u32> materialIndices;
+	f32 shininess = 32.0f;
+	Bounds bounds;
+	Span<std::byte> vertices;
+	Span<u32> indices;
+};
+
+///
+/// \brief Parsed (or to be written) model: blob spans in meshes point into the file (or the caller's data)
+///
+struct Model final {
+	u32 vertexStride = 0;
+	Bounds bounds;
+	std::vector<Texture> textures;
+	std::vector<Material> materials;
+	std::vector<Mesh> meshes;
+
+	///
+	/// \brief Obtain the number of vertices in `mesh`
+	///
+	std::size_t vertexCount(Mesh const& mesh) const noexcept;
+};
+
+///
+/// \brief Check whether `bytes` begins with the `.lvmesh` identifier
+///
+bool identify(Span<std::byte> bytes) noexcept;
+///
+/// \brief Parse a `.lvmesh` file (blob spans in the returned Model point into `bytes`, which must be `alignment` aligned)
+/// \returns nullopt if invalid / of a different version / misaligned
+///
+std::optional<Model> parse(Span<std::byte> bytes);
+///
+/// \brief Serialise a model (computes all bounds from vertex positions)
+/// \returns empty bytearray on failure
+///
+bytearray write(Model const& model);
+
+///
+/// \brief Compute the axis aligned bounds of `vertices` (each beginning with a `glm::vec3` position)
+///
+Bounds bounds(Span<std::byte> vertices, u32 stride) noexcept;
+} // namespace lvmesh
+} // namespace le::io
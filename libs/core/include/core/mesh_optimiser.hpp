@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+
+namespace le::meshopt {
+///
+/// \brief Post-transform cache size assumed by default (FIFO entries)
+///
+constexpr u32 defaultCacheSize = 16;
+
+struct Options final {
+	u32 cacheSize = defaultCacheSize;
+	///
+	/// \brief Reorder Tipsify clusters front-to-back (view independent)
+	///
+	bool bOverdraw = true;
+	///
+	/// \brief Maximum ACMR increase (ratio) accepted from overdraw ordering
+	///
+	f32 overdrawThreshold = 1.05f;
+};
+
+struct Stats final {
+	f32 acmrBefore = 0.0f;
+	f32 acmrAfter = 0.0f;
+	u32 vertexCount = 0;
+};
+
+///
+/// \brief Obtain the average cache miss ratio (vertices transformed per triangle) through a FIFO cache of `cacheSize`
+/// Ranges from 0.5 (ideal, large grids) to 3.0 (no reuse)
+///
+f32 acmr(Span<u32> indices, u32 vertexCount, u32 cacheSize = defaultCacheSize);
+///
+/// \brief Reorder triangles for post-transform cache locality (Tipsify; Sander, Nehab, Barczak 2007)
+/// \param out_clusters if not null, filled with the first triangle of each cluster (split at dead-end jumps)
+///
+std::vector<u32> optimiseVertexCache(Span<u32> indices, u32 vertexCount, u32 cacheSize = defaultCacheSize, std::vector<u32>* out_clusters = nullptr);
+///
+/// \brief Reorder clusters of triangles (first triangle of each in `clusters`) to reduce overdraw
+/// Clusters facing away from the mesh centroid are drawn first; vertices must begin with a `glm::vec3` position
+/// \returns `indices` unchanged if the reordered ACMR exceeds `threshold` times that of `indices`
+///
+std::vector<u32> optimiseOverdraw(Span<u32> indices, Span<std::byte> vertices, u32 stride, Span<u32> clusters, f32 threshold = 1.05f,
+								  u32 cacheSize = defaultCacheSize);
+///
+/// \brief Obtain a vertex remap table (old index => new index) in order of first use; unreferenced vertices map to `~0U`
+///
+std::vector<u32> fetchRemap(Span<u32> indices, u32 vertexCount);
+///
+/// \brief Apply a remap `table` to `out_indices`, and to `vertexCount` vertices of `stride` at `pVertices` (in place)
+/// \returns Remapped vertex count (unreferenced vertices are dropped)
+///
+u32 remap(std::vector<u32>& out_indices, std::byte* pVertices, u32 vertexCount, u32 stride, Span<u32> table);
+
+///
+/// \brief Run vertex cache, overdraw (optional), and vertex fetch optimisation (in place)
+///
+Stats optimise(std::vector<u32>& out_indices, std::byte* pVertices, u32 vertexCount, u32 stride, Options const& options = {});
+///
+/// \brief Run vertex cache, overdraw (optional), and vertex fetch optimisation on a vertex / index buffer pair (in place)
+/// `V` must begin with a `glm::vec3` position
+///
+template <typename V>
+Stats optimise(std::vector<V>& out_vertices, std::vector<u32>& out_indices, Options const& options = {}) {
+	auto const ret = optimise(out_indices, reinterpret_cast<std::byte*>(out_vertices.data()), (u32)out_vertices.size(), (u32)sizeof(V), options);
+	out_vertices.resize((std::size_t)ret.vertexCount);
+	return ret;
+}
+} // namespace le::meshopt
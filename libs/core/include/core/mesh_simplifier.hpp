@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+
+namespace le::meshopt {
+///
+/// \brief Level of detail: triangles over the source vertices, and their error relative to the source bounds diagonal
+///
+struct Lod final {
+	std::vector<u32> indices;
+	f32 error = 0.0f;
+};
+
+///
+/// \brief Simplify triangles by quadric error metric edge collapse (Garland, Heckbert 1997) onto existing vertices
+/// Vertices sharing a position (attribute seams) collapse together; open borders and seams only collapse along themselves
+/// Vertices must begin with a `glm::vec3` position
+/// \param targetIndexCount stop once at or below this many indices
+/// \param maxError stop before exceeding this error (relative to the bounds diagonal)
+/// \param out_error if not null, set to the error of the result
+///
+std::vector<u32> simplify(Span<u32> indices, Span<std::byte> vertices, u32 stride, std::size_t targetIndexCount, f32 maxError = 0.05f,
+						  f32* out_error = nullptr);
+///
+/// \brief Generate up to `count` levels of detail (source at 0), each targeting `ratio` of the previous triangle count
+/// Stops early once a level fails to reduce the triangle count meaningfully or the accumulated error exceeds `maxError`
+///
+std::vector<Lod> lods(Span<u32> indices, Span<std::byte> vertices, u32 stride, u32 count, f32 ratio = 0.5f, f32 maxError = 0.05f);
+
+///
+/// \brief Obtain the fraction of view height subtended by a sphere of `radius` at `distance` (perspective, vertical `fov` in radians)
+/// With `radius` as half the bounds diagonal, `Lod::error * screenSize` is the projected error as a fraction of view height
+///
+f32 screenSize(f32 radius, f32 distance, f32 fov) noexcept;
+///
+/// \brief Select the coarsest level whose error projected at `screenSize` does not exceed `maxError` (fraction of view height)
+/// \param errors Lod::error of each level (non-decreasing)
+///
+u32 selectLod(Span<f32> errors, f32 screenSize, f32 maxError) noexcept;
+} // namespace le::meshopt
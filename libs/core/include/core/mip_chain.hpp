@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+
+namespace le::mips {
+///
+/// \brief Interpretation of 8-bit channels (determines how texels are averaged)
+///
+enum class Encoding : s8 { eUNorm, eSNorm, eSRGB, eCOUNT_ };
+
+///
+/// \brief A single level within a Chain
+///
+struct Level final {
+	u32 width = 0;
+	u32 height = 0;
+	std::size_t offset = 0;
+	std::size_t size = 0;
+};
+
+///
+/// \brief Levels 1..N of an RGBA8 image (level 0 is the source image itself), tightly packed
+///
+struct Chain final {
+	std::vector<u8> bytes;
+	std::vector<Level> levels;
+
+	Span<u8> level(std::size_t idx) const;
+};
+
+///
+/// \brief Obtain the number of levels in a full chain for an image of `width x height` (including level 0)
+///
+u32 levelCount(u32 width, u32 height) noexcept;
+
+///
+/// \brief Downsample one RGBA8 level into the next (2x2 box filter, edge texels repeated for odd dimensions)
+/// \param pDst must point to `max(1, width / 2) * max(1, height / 2) * 4` bytes
+/// sRGB colour channels are filtered in linear space; alpha is always filtered as-is
+///
+void downsample(u8 const* pSrc, u32 width, u32 height, u8* pDst, Encoding encoding);
+
+///
+/// \brief Generate all levels below `rgba` (`maxLevels` including level 0; full chain if 0)
+/// Rows of each level are split into bands across task workers when `bParallel` is set and the level is large enough
+/// (the calling thread processes bands too, so this is safe to call from within a task)
+///
+Chain generate(Span<u8> rgba, u32 width, u32 height, Encoding encoding, u32 maxLevels = 0, bool bParallel = true);
+} // namespace le::mips
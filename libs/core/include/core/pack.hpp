@@ -0,0 +1,90 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include <core/std_types.hpp>
+
+namespace le {
+namespace stdfs = std::filesystem;
+
+namespace io {
+///
+/// \brief Native asset archive format (`.pack`)
+///
+/// Layout:
+/// 	Header
+/// 	Entry[Header::entryCount] (sorted by `Entry::hash`)
+/// 	Names (`Header::namesSize` bytes of concatenated IDs)
+/// 	Data (each entry aligned to `pack::alignment`)
+///
+namespace pack {
+constexpr u32 magic = 0x504b564c; // "LVKP"
+constexpr u32 version = 1;
+constexpr u64 alignment = 4096;
+
+///
+/// \brief Per-entry storage encoding
+///
+enum class Codec : u8 { eNone, eLZ4, eZstd, eCOUNT_ };
+
+struct Header final {
+	u32 magic = pack::magic;
+	u32 version = pack::version;
+	u32 entryCount = 0;
+	u32 flags = 0;
+	u64 namesOffset = 0;
+	u64 namesSize = 0;
+};
+
+struct Entry final {
+	u64 hash = 0;
+	u64 offset = 0;
+	u64 size = 0;
+	u64 storedSize = 0;
+	u32 nameOffset = 0;
+	u32 nameSize = 0;
+	Codec codec = Codec::eNone;
+	u8 padding[7] = {};
+};
+
+static_assert(sizeof(Header) == 32 && sizeof(Entry) == 48, "Pack layout changed!");
+
+///
+/// \brief Stable (cross-platform) hash of an ID (FNV-1a)
+///
+u64 hash(std::string_view id) noexcept;
+
+///
+/// \brief Builds a `.pack` file from filesystem files
+///
+class Writer final {
+  public:
+	///
+	/// \brief Add a file to be packed as `id`
+	///
+	bool add(std::string id, stdfs::path file);
+	///
+	/// \brief Add all files in `directory` (recursively), with IDs relative to it
+	///
+	std::size_t addAll(stdfs::path const& directory);
+	///
+	/// \brief Write out pack
+	///
+	bool write(stdfs::path const& path) const;
+
+	std::size_t size() const noexcept;
+
+  private:
+	struct File final {
+		std::string id;
+		stdfs::path path;
+	};
+
+	std::vector<File> m_files;
+	std::unordered_set<std::string> m_ids;
+};
+} // namespace pack
+} // namespace io
+} // namespace le
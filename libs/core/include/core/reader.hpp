@@ -1,15 +1,100 @@
 #pragma once
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
 #include <sstream>
 #include <string_view>
+#include <unordered_map>
+#include <core/pack.hpp>
 #include <core/span.hpp>
 #include <core/utils.hpp>
+#include <core/watcher.hpp>
 #include <kt/result/result.hpp>
 
 namespace le {
 namespace stdfs = std::filesystem;
 
 namespace io {
+///
+/// \brief Read-only view of an IO resource's contents (RAII)
+/// Memory mapped when supported by the medium / platform, else owns a buffered copy
+///
+class Mapped final {
+  public:
+	Mapped() = default;
+	explicit Mapped(bytearray buffer) noexcept;
+	Mapped(Mapped&&) noexcept;
+	Mapped& operator=(Mapped&&) noexcept;
+	Mapped(Mapped const&) = delete;
+	Mapped& operator=(Mapped const&) = delete;
+	~Mapped();
+
+	///
+	/// \brief Memory map a file on the filesystem (falls back to a buffered read)
+	///
+	static kt::result_void<Mapped> file(stdfs::path const& path);
+	///
+	/// \brief Memory map `size` bytes at `offset` of a file on the filesystem (falls back to a buffered read)
+	///
+	static kt::result_void<Mapped> file(stdfs::path const& path, std::size_t offset, std::size_t size);
+
+	///
+	/// \brief Obtain contents as bytes
+	///
+	Span<std::byte> bytes() const noexcept;
+	///
+	/// \brief Obtain contents as text
+	///
+	std::string_view text() const noexcept;
+	std::size_t size() const noexcept;
+	bool empty() const noexcept;
+	///
+	/// \brief Check whether contents are memory mapped (vs buffered)
+	///
+	bool mapped() const noexcept;
+
+  private:
+	void unmap() noexcept;
+
+	bytearray m_buffer;
+	void* m_pMap = nullptr;
+	std::size_t m_mapSize = 0;
+	std::size_t m_offset = 0;
+	std::size_t m_size = 0;
+};
+
+///
+/// \brief Handle to an open IO resource for incremental reads with bounded buffers (RAII)
+///
+class Stream {
+  public:
+	Stream() = default;
+	Stream(Stream const&) = delete;
+	Stream& operator=(Stream const&) = delete;
+	virtual ~Stream();
+
+	///
+	/// \brief Read up to `count` bytes from the current position into `pOut`
+	/// \returns Number of bytes read (less than `count` at end of stream / on error)
+	///
+	virtual std::size_t read(std::byte* pOut, std::size_t count) = 0;
+	///
+	/// \brief Move the read position to `position` (clamped to `size()`)
+	///
+	virtual bool seek(std::size_t position) = 0;
+	///
+	/// \brief Obtain the current read position
+	///
+	virtual std::size_t tell() const = 0;
+	///
+	/// \brief Obtain the total size of the resource
+	///
+	virtual std::size_t size() const = 0;
+
+	bool eof() const;
+};
+
 ///
 /// \brief Abstract base class for reading data from various IO
 ///
@@ -44,6 +129,10 @@ class Reader {
 	///
 	[[nodiscard]] bool checkPresences(std::initializer_list<stdfs::path> ids) const;
 	///
+	/// \brief Discard any cached lookup for `id` and search for it again (eg after it has been created / deleted)
+	///
+	bool refresh(stdfs::path const& id) const;
+	///
 	/// \brief Obtain data as `std::string`
 	///
 	[[nodiscard]] Result<std::string> string(stdfs::path const& id) const;
@@ -66,12 +155,22 @@ class Reader {
 	/// \brief Obtain data as `std::stringstream`
 	///
 	[[nodiscard]] virtual Result<std::stringstream> sstream(stdfs::path const& id) const = 0;
+	///
+	/// \brief Obtain read-only view of data (zero-copy where supported, else buffered via `bytes()`)
+	///
+	[[nodiscard]] virtual Result<Mapped> map(stdfs::path const& id) const;
+	///
+	/// \brief Open data for incremental reads (buffers via `bytes()` if not overridden)
+	/// \returns `nullptr` if `id` is not present
+	///
+	[[nodiscard]] virtual std::unique_ptr<Stream> open(stdfs::path const& id) const;
 
   protected:
 	std::string m_medium;
 
   protected:
 	virtual Result<stdfs::path> findPrefixed(stdfs::path const& id) const = 0;
+	virtual void forget(stdfs::path const& id) const;
 };
 
 ///
@@ -103,15 +202,37 @@ class FileReader final : public Reader {
 	bool mount(stdfs::path path) override;
 	Result<bytearray> bytes(stdfs::path const& id) const override;
 	Result<std::stringstream> sstream(stdfs::path const& id) const override;
+	///
+	/// \brief Memory map file
+	///
+	Result<Mapped> map(stdfs::path const& id) const override;
+	std::unique_ptr<Stream> open(stdfs::path const& id) const override;
 
   private:
+	///
+	/// \brief Resolved paths of all files in mounted directories (avoids filesystem queries per lookup)
+	///
+	struct Index final {
+		std::unordered_map<std::string, stdfs::path> paths;
+		mutable std::shared_mutex mutex;
+
+		Index() = default;
+		Index(Index&& rhs) noexcept;
+		Index& operator=(Index&& rhs) noexcept;
+		Index(Index const& rhs);
+		Index& operator=(Index const& rhs);
+	};
+
 	std::vector<stdfs::path> m_dirs;
+	mutable Index m_index;
 
   private:
 	Result<stdfs::path> findPrefixed(stdfs::path const& id) const override;
+	void forget(stdfs::path const& id) const override;
 
   private:
 	std::vector<stdfs::path> finalPaths(stdfs::path const& id) const;
+	std::size_t index(stdfs::path const& dir);
 };
 
 ///
@@ -128,6 +249,7 @@ class ZIPReader final : public Reader {
 	bool mount(stdfs::path path) override;
 	Result<bytearray> bytes(stdfs::path const& id) const override;
 	Result<std::stringstream> sstream(stdfs::path const& id) const override;
+	std::unique_ptr<Stream> open(stdfs::path const& id) const override;
 
   private:
 	std::vector<stdfs::path> m_zips;
@@ -136,6 +258,46 @@ class ZIPReader final : public Reader {
 	Result<stdfs::path> findPrefixed(stdfs::path const& id) const override;
 };
 
+///
+/// \brief Concrete class for `.pack` IO (see `pack.hpp`)
+///
+class PackReader final : public Reader {
+  public:
+	PackReader();
+
+  public:
+	///
+	/// \brief Mount `.pack` file
+	///
+	bool mount(stdfs::path path) override;
+	Result<bytearray> bytes(stdfs::path const& id) const override;
+	Result<std::stringstream> sstream(stdfs::path const& id) const override;
+	///
+	/// \brief Memory map entry (uncompressed entries only, else buffered)
+	///
+	Result<Mapped> map(stdfs::path const& id) const override;
+	std::unique_ptr<Stream> open(stdfs::path const& id) const override;
+
+  private:
+	struct Pack final {
+		stdfs::path path;
+		std::vector<pack::Entry> entries;
+		std::string names;
+	};
+	struct Found final {
+		Pack const* pPack = nullptr;
+		pack::Entry const* pEntry = nullptr;
+	};
+
+	std::vector<Pack> m_packs;
+
+  private:
+	Result<stdfs::path> findPrefixed(stdfs::path const& id) const override;
+
+  private:
+	Result<Found> find(stdfs::path const& id) const;
+};
+
 ///
 /// \brief Utility for monitoring filesystem files
 ///
@@ -143,8 +305,9 @@ class FileMonitor {
   public:
 	///
 	/// \brief Monitoring mode
+	/// eContentHash: retains only a 64-bit hash of the contents (streamed); fetch data via a Reader on modification
 	///
-	enum class Mode : s8 { eTimestamp, eTextContents, eBinaryContents };
+	enum class Mode : s8 { eTimestamp, eTextContents, eBinaryContents, eContentHash };
 
 	///
 	/// \brief Monitor status
@@ -165,6 +328,7 @@ class FileMonitor {
   public:
 	///
 	/// \brief Obtain current status of file being monitored
+	/// Skips filesystem queries until notified of changes if `watcher` is active
 	///
 	virtual Status update();
 
@@ -195,6 +359,17 @@ class FileMonitor {
 	/// \brief Obtain the last scanned contents of the file being monitored
 	/// Note: only valid for `eBinaryContents` mode
 	bytearray const& bytes() const;
+	///
+	/// \brief Obtain the hash (XXH64) of the last scanned contents of the file being monitored
+	/// Note: only valid for `eContentHash` mode
+	///
+	u64 hash() const;
+
+  protected:
+	///
+	/// \brief Stream the file through the hasher in fixed-size chunks (never holds the whole file)
+	///
+	std::optional<u64> hashContents() const;
 
   protected:
 	inline static io::FileReader s_reader;
@@ -205,6 +380,8 @@ class FileMonitor {
 	stdfs::path m_path;
 	std::string m_text;
 	bytearray m_bytes;
+	u64 m_hash = 0;
+	watcher::Flag m_changed;
 	Mode m_mode;
 	Status m_status = Status::eNotFound;
 };
@@ -0,0 +1,51 @@
+#pragma once
+#include <optional>
+#include <core/std_types.hpp>
+
+namespace le {
+///
+/// \brief Linear sub-allocator over a fixed size ring (eg a persistently mapped staging buffer)
+///
+/// Blocks must be released in allocation order: pass the `consumed` size of each retired block (or the sum over a batch of them)
+/// to `release()`. `consumed` includes alignment and any space skipped at the end of the ring when wrapping around.
+///
+class RingAllocator final {
+  public:
+	struct Block final {
+		u64 offset = 0;
+		u64 consumed = 0;
+	};
+
+  public:
+	RingAllocator() = default;
+	///
+	/// \brief Construct an allocator over `capacity` bytes; offsets are multiples of `alignment` (must be a power of two)
+	///
+	RingAllocator(u64 capacity, u64 alignment = 16) noexcept;
+
+	///
+	/// \brief Allocate a contiguous block of (at least) `size` bytes
+	/// \returns `std::nullopt` if there is not enough free space (until older blocks are released)
+	///
+	std::optional<Block> allocate(u64 size) noexcept;
+	///
+	/// \brief Release the oldest `consumed` bytes
+	///
+	void release(u64 consumed) noexcept;
+	///
+	/// \brief Release all blocks
+	///
+	void reset() noexcept;
+
+	u64 capacity() const noexcept;
+	u64 used() const noexcept;
+
+  private:
+	u64 align(u64 size) const noexcept;
+
+	u64 m_capacity = 0;
+	u64 m_alignment = 1;
+	u64 m_head = 0;
+	u64 m_used = 0;
+};
+} // namespace le
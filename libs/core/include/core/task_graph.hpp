@@ -0,0 +1,106 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <core/std_types.hpp>
+#include <core/tasks.hpp>
+#include <core/time.hpp>
+
+namespace le::tasks {
+///
+/// \brief Dependency graph of tasks: each node is enqueued as soon as all of its dependencies have completed
+///
+/// Nodes may be added at any time (including from within running nodes, to expand the graph dynamically);
+/// dependencies that have already completed are satisfied immediately.
+/// Tracks per-node durations to report the critical path: the longest chain of dependent work.
+///
+class Graph final {
+  public:
+	using ID = std::size_t;
+
+	///
+	/// \brief Timing statistics (valid once the graph is done)
+	///
+	struct Stats final {
+		///
+		/// \brief Wall time from first node enqueued to last node completed
+		///
+		Time elapsed;
+		///
+		/// \brief Sum of durations along the longest dependency chain
+		///
+		Time criticalPath;
+		///
+		/// \brief Sum of durations of all nodes
+		///
+		Time total;
+		std::size_t nodes = 0;
+		std::size_t discarded = 0;
+	};
+
+  public:
+	Graph() = default;
+	Graph(Graph&&) = delete;
+	Graph& operator=(Graph&&) = delete;
+	///
+	/// \brief Discards pending nodes and waits for running ones
+	///
+	~Graph();
+
+	///
+	/// \brief Add a node that runs `task` after all `dependencies` have completed
+	///
+	ID add(std::function<void()> task, std::string name, std::vector<ID> const& dependencies = {});
+	///
+	/// \brief Obtain the ID of the node executing on the calling thread (if any): to add dependents from within a node
+	///
+	std::optional<ID> current() const;
+	///
+	/// \brief Check whether all nodes have completed / been discarded
+	///
+	bool done() const;
+	///
+	/// \brief Block until `done()`; do not call from within a node
+	///
+	void wait();
+	///
+	/// \brief Discard all nodes that have not started executing (and any added subsequently)
+	///
+	void discard();
+	///
+	/// \brief Obtain timing statistics
+	///
+	Stats stats() const;
+
+  private:
+	struct Node final {
+		std::function<void()> task;
+		std::string name;
+		std::vector<ID> dependencies;
+		std::vector<ID> dependents;
+		std::shared_ptr<Handle> handle;
+		Time duration;
+		Time path;
+		u32 pending = 0;
+		bool bDone = false;
+		bool bDiscarded = false;
+	};
+
+	void launch(ID id);
+	void run(ID id);
+	void finish(ID id, bool bDiscarded);
+
+	std::deque<Node> m_nodes;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_cv;
+	Time m_start;
+	Time m_end;
+	std::size_t m_done = 0;
+	bool m_bDiscard = false;
+};
+} // namespace le::tasks
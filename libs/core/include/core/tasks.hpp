@@ -7,6 +7,7 @@
 #include <vector>
 #include <fmt/format.h>
 #include <core/std_types.hpp>
+#include <core/time.hpp>
 
 namespace le::tasks {
 ///
@@ -64,6 +65,33 @@ class Handle final {
 	friend struct Worker;
 };
 
+///
+/// \brief Handle to a delayed / periodic task
+///
+class Timer final {
+  public:
+	Timer(s64 id);
+
+  public:
+	s64 id() const noexcept;
+	///
+	/// \brief Stop the timer from firing again (does not affect already enqueued tasks)
+	///
+	bool cancel() noexcept;
+	bool cancelled() const noexcept;
+	///
+	/// \brief Obtain the number of times this timer has fired
+	///
+	u64 fireCount() const noexcept;
+
+  private:
+	s64 const m_id;
+	std::atomic<bool> m_bCancelled;
+	std::atomic<u64> m_fireCount;
+
+	friend struct Scheduler;
+};
+
 ///
 /// \brief Enqueue a new task
 ///
@@ -72,6 +100,30 @@ std::shared_ptr<Handle> enqueue(std::function<void()> task, std::string name);
 /// \brief Enqueue a list of tasks
 ///
 std::vector<std::shared_ptr<Handle>> enqueue(List taskList);
+///
+/// \brief Enqueue a task after `delay` has elapsed
+///
+std::shared_ptr<Timer> enqueueAfter(Time delay, std::function<void()> task, std::string name = {});
+///
+/// \brief Enqueue a task every `period` (first after one `period`) until cancelled
+///
+std::shared_ptr<Timer> enqueueEvery(Time period, std::function<void()> task, std::string name = {});
+
+///
+/// \brief Frame phase during which main thread tasks are run
+///
+enum class Phase : s8 { ePreTick, ePostTick, ePreRender, eCOUNT_ };
+///
+/// \brief Enqueue a task to be run on the main thread during `phase` (via `runMain()`)
+/// Note: do not wait on the returned handle from the main thread
+///
+std::shared_ptr<Handle> enqueueMain(Phase phase, std::function<void()> task, std::string name = {});
+///
+/// \brief Run main thread tasks enqueued for `phase` until `budget` is exhausted (runs all if zero)
+/// At least one task is run per call; tasks remaining past budget carry over to the next call
+/// \returns Number of tasks run
+///
+std::size_t runMain(Phase phase, Time budget = {});
 
 ///
 /// \brief Enqueue a task per item in a container
@@ -85,24 +137,71 @@ std::vector<std::shared_ptr<Handle>> forEach(C<T, Args...>& out_itemList, std::f
 template <template <typename, typename...> typename C, typename... Args>
 void wait(C<std::shared_ptr<Handle>, Args...>& out_handles);
 
+///
+/// \brief Split `[0, count)` into (up to) `bandCount` bands and run `work(begin, end)` on each, across workers and the calling thread
+/// Bands are claimed from a shared counter: the caller never blocks on a helper that has not started,
+/// so this is safe to call from within a task (even when all workers are doing the same)
+///
+void forBands(u32 count, u32 bandCount, std::function<void(u32, u32)> work);
 ///
 /// \brief Wait until no tasks are executing / enqueued
 ///
 void waitIdle(bool bKillEnqueued);
 
+///
+/// \brief Worker setup
+///
+struct Config final {
+	///
+	/// \brief Number of workers (derived from hardware threads if 0)
+	///
+	u8 workerCount = 0;
+	///
+	/// \brief Hardware threads reserved for main / transfer threads (when deriving worker count / pinning)
+	///
+	u8 reserve = 2;
+	///
+	/// \brief Pin each worker to a hardware thread (Linux only)
+	///
+	bool bPinWorkers = false;
+	///
+	/// \brief Resolution of delayed / periodic tasks
+	///
+	Time timerTick = 1ms;
+};
+
 ///
 /// \brief RAII Service to initialise/deinitialise tasks module
 ///
 struct Service final {
 	Service(u8 workerCount = 2);
+	Service(Config config);
 	~Service();
 };
 
+///
+/// \brief Obtain the number of workers that fit in hardware threads after `reserve`
+///
+u8 autoWorkerCount(u8 reserve);
+///
+/// \brief Obtain the number of running workers
+///
+std::size_t workerCount();
+///
+/// \brief Add / retire workers without affecting enqueued tasks
+/// Retiring workers finish their current task first; returns without waiting for them (call on the main thread)
+///
+bool resize(u8 workerCount);
+
 ///
 /// \brief Manually initialise tasks module
 ///
 bool init(u8 workerCount);
 ///
+/// \brief Manually initialise tasks module
+///
+bool init(Config config);
+///
 /// \brief Manually deinitialise tasks module
 ///
 void deinit();
@@ -1,5 +1,6 @@
 #pragma once
 #include <functional>
+#include <string_view>
 #include <thread>
 #include <core/std_types.hpp>
 #include <core/time.hpp>
@@ -74,6 +75,17 @@ u32 maxHardwareThreads();
 ///
 u32 runningCount();
 
+///
+/// \brief Set the name of the calling thread (visible in debuggers / profilers)
+/// Note: names longer than 15 characters are truncated on Linux
+///
+bool setName(std::string_view name);
+///
+/// \brief Pin the calling thread to a hardware thread (Linux only)
+/// \returns `false` if unsupported / failed
+///
+bool pin(u32 hardwareThread);
+
 ///
 /// \brief Sleep this thread
 /// \param duration pass zero to yield
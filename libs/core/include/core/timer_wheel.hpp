@@ -0,0 +1,143 @@
+#pragma once
+#include <array>
+#include <utility>
+#include <vector>
+#include <core/std_types.hpp>
+
+namespace le {
+///
+/// \brief Hierarchical timer wheel: O(1) scheduling, amortised O(1) expiry per tick
+///
+/// Level 0 holds entries due within `slots` ticks; each subsequent level covers `slots` times the range of the previous one,
+/// and cascades its entries down when the lower level wraps around.
+///
+template <typename T, std::size_t Levels = 4, std::size_t SlotBits = 6>
+class TTimerWheel final {
+	static_assert(Levels > 0 && SlotBits > 0 && Levels * SlotBits < 64, "Invalid wheel dimensions!");
+
+  public:
+	using Tick = u64;
+
+	static constexpr std::size_t slots = std::size_t(1) << SlotBits;
+	static constexpr Tick maxDelay = (Tick(1) << (Levels * SlotBits)) - 1;
+
+  public:
+	///
+	/// \brief Schedule `payload` to expire after `delay` ticks (minimum 1)
+	///
+	void schedule(Tick delay, T payload);
+	///
+	/// \brief Advance the wheel by `ticks`, invoking `onExpired(Tick, T&&)` for each expired entry
+	///
+	template <typename F>
+	void advance(Tick ticks, F onExpired);
+	///
+	/// \brief Remove all entries
+	///
+	void clear() noexcept;
+
+	///
+	/// \brief Obtain the current tick
+	///
+	Tick now() const noexcept;
+	///
+	/// \brief Obtain the number of scheduled entries
+	///
+	std::size_t size() const noexcept;
+	bool empty() const noexcept;
+
+  private:
+	struct Entry final {
+		Tick expiry;
+		T payload;
+	};
+	using Slot = std::vector<Entry>;
+
+	void insert(Entry&& entry);
+	void cascade(std::size_t level);
+
+	std::array<std::array<Slot, slots>, Levels> m_levels;
+	Tick m_now = 0;
+	std::size_t m_count = 0;
+};
+
+template <typename T, std::size_t Levels, std::size_t SlotBits>
+void TTimerWheel<T, Levels, SlotBits>::schedule(Tick delay, T payload) {
+	delay = delay == 0 ? 1 : delay;
+	insert({m_now + delay, std::move(payload)});
+	++m_count;
+}
+
+template <typename T, std::size_t Levels, std::size_t SlotBits>
+template <typename F>
+void TTimerWheel<T, Levels, SlotBits>::advance(Tick ticks, F onExpired) {
+	for (; ticks > 0; --ticks) {
+		if (m_count == 0) {
+			m_now += ticks;
+			return;
+		}
+		++m_now;
+		for (std::size_t level = 1; level < Levels; ++level) {
+			if ((m_now & ((Tick(1) << (level * SlotBits)) - 1)) != 0) {
+				break;
+			}
+			cascade(level);
+		}
+		Slot expired = std::move(m_levels[0][m_now & (slots - 1)]);
+		m_levels[0][m_now & (slots - 1)] = {};
+		m_count -= expired.size();
+		for (auto& entry : expired) {
+			onExpired(entry.expiry, std::move(entry.payload));
+		}
+	}
+}
+
+template <typename T, std::size_t Levels, std::size_t SlotBits>
+void TTimerWheel<T, Levels, SlotBits>::clear() noexcept {
+	for (auto& level : m_levels) {
+		for (auto& slot : level) {
+			slot.clear();
+		}
+	}
+	m_count = 0;
+}
+
+template <typename T, std::size_t Levels, std::size_t SlotBits>
+typename TTimerWheel<T, Levels, SlotBits>::Tick TTimerWheel<T, Levels, SlotBits>::now() const noexcept {
+	return m_now;
+}
+
+template <typename T, std::size_t Levels, std::size_t SlotBits>
+std::size_t TTimerWheel<T, Levels, SlotBits>::size() const noexcept {
+	return m_count;
+}
+
+template <typename T, std::size_t Levels, std::size_t SlotBits>
+bool TTimerWheel<T, Levels, SlotBits>::empty() const noexcept {
+	return m_count == 0;
+}
+
+template <typename T, std::size_t Levels, std::size_t SlotBits>
+void TTimerWheel<T, Levels, SlotBits>::insert(Entry&& entry) {
+	// entries cascading down on their expiry tick land in the current slot (fired after cascading)
+	Tick const delta = entry.expiry > m_now ? entry.expiry - m_now : 0;
+	// out of range entries park in the furthest slot and get re-inserted on cascade
+	Tick const target = delta > maxDelay ? m_now + maxDelay : m_now + delta;
+	std::size_t level = 0;
+	while (level + 1 < Levels && delta >= (Tick(1) << ((level + 1) * SlotBits))) {
+		++level;
+	}
+	auto const slot = (std::size_t)((target >> (level * SlotBits)) & (slots - 1));
+	m_levels[level][slot].push_back(std::move(entry));
+}
+
+template <typename T, std::size_t Levels, std::size_t SlotBits>
+void TTimerWheel<T, Levels, SlotBits>::cascade(std::size_t level) {
+	auto const slot = (std::size_t)((m_now >> (level * SlotBits)) & (slots - 1));
+	Slot entries = std::move(m_levels[level][slot]);
+	m_levels[level][slot] = {};
+	for (auto& entry : entries) {
+		insert(std::move(entry));
+	}
+}
+} // namespace le
@@ -0,0 +1,63 @@
+#pragma once
+#include <core/std_types.hpp>
+#include <glm/glm.hpp>
+
+namespace le::quantise {
+///
+/// \brief Compact vertex layout (20 bytes, vs 44 for three float vec3s and a float vec2)
+///
+/// position: unorm16 xyz within mesh Bounds (w unused, for alignment)
+/// colour: RGBA8 unorm
+/// normal: octahedral, snorm16 xy
+/// texCoord: half float xy
+///
+struct PackedVertex final {
+	u16 position[4] = {};
+	u8 colour[4] = {};
+	s16 normal[2] = {};
+	u16 texCoord[2] = {};
+};
+
+static_assert(sizeof(PackedVertex) == 20, "Unexpected padding");
+
+///
+/// \brief Dequantisation of unorm positions: `position = origin + unorm * scale`
+///
+struct Bounds final {
+	glm::vec3 origin = {};
+	glm::vec3 scale = glm::vec3(1.0f);
+};
+
+///
+/// \brief Obtain Bounds spanning [lo, hi] (degenerate axes have unit scale)
+///
+Bounds bounds(glm::vec3 const& lo, glm::vec3 const& hi) noexcept;
+
+///
+/// \brief Convert to / from IEEE 754 binary16 (round to nearest even; overflow saturates to infinity)
+///
+u16 toHalf(f32 value) noexcept;
+f32 fromHalf(u16 half) noexcept;
+
+u16 toUnorm16(f32 value) noexcept;
+f32 fromUnorm16(u16 value) noexcept;
+s16 toSnorm16(f32 value) noexcept;
+f32 fromSnorm16(s16 value) noexcept;
+
+///
+/// \brief Map a unit vector onto the [-1, 1] square (octahedral projection, folded for -z) and back
+///
+glm::vec2 octEncode(glm::vec3 const& normal) noexcept;
+glm::vec3 octDecode(glm::vec2 const& oct) noexcept;
+
+PackedVertex pack(glm::vec3 const& position, glm::vec3 const& colour, glm::vec3 const& normal, glm::vec2 const& texCoord, Bounds const& bounds) noexcept;
+
+struct Unpacked final {
+	glm::vec3 position;
+	glm::vec4 colour;
+	glm::vec3 normal;
+	glm::vec2 texCoord;
+};
+
+Unpacked unpack(PackedVertex const& vertex, Bounds const& bounds) noexcept;
+} // namespace le::quantise
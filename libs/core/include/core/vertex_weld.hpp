@@ -0,0 +1,67 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+
+namespace le::weld {
+///
+/// \brief Attribute indices of a face corner (negative if absent)
+///
+struct Corner final {
+	s32 position = -1;
+	s32 normal = -1;
+	s32 texCoord = -1;
+};
+
+constexpr bool operator==(Corner const& lhs, Corner const& rhs) noexcept {
+	return lhs.position == rhs.position && lhs.normal == rhs.normal && lhs.texCoord == rhs.texCoord;
+}
+constexpr bool operator!=(Corner const& lhs, Corner const& rhs) noexcept {
+	return !(lhs == rhs);
+}
+
+///
+/// \brief Open-addressing (linear probing) map of Corner to vertex index
+/// Hashes only select slots: keys are always compared exactly, so distinct corners are never merged
+///
+class Table final {
+  public:
+	///
+	/// \brief Construct a table sized for `expected` unique corners (grows on demand)
+	///
+	explicit Table(std::size_t expected = 0);
+
+	///
+	/// \brief Obtain the vertex index of `corner`, inserting it as the next vertex if not present
+	/// \returns Vertex index, and whether `corner` was inserted
+	///
+	std::pair<u32, bool> insert(Corner const& corner);
+	///
+	/// \brief Unique corners, in vertex index order
+	///
+	std::vector<Corner> const& keys() const noexcept;
+	std::size_t size() const noexcept;
+
+  private:
+	void grow();
+
+	std::vector<Corner> m_keys;
+	// vertex index + 1 (0 is empty)
+	std::vector<u32> m_slots;
+	std::size_t m_mask = 0;
+};
+
+///
+/// \brief Welded index buffer: `indices[i]` is the vertex of the `i`th corner, `vertices[v]` the corner of vertex `v`
+///
+struct Result final {
+	std::vector<u32> indices;
+	std::vector<Corner> vertices;
+};
+
+///
+/// \brief Weld identical corners into shared vertices (first occurrence order)
+///
+Result weld(Span<Corner> corners);
+} // namespace le::weld
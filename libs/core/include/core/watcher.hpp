@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <core/time.hpp>
+
+namespace le::io {
+namespace stdfs = std::filesystem;
+
+namespace watcher {
+///
+/// \brief Shared flag raised (after debouncing) whenever a watched file changes; reset by the consumer
+///
+using Flag = std::shared_ptr<std::atomic<bool>>;
+
+///
+/// \brief Watcher setup
+///
+struct Config final {
+	///
+	/// \brief Quiet period after the last change before dispatching (coalesces bursts of writes)
+	///
+	Time debounce = 50ms;
+	///
+	/// \brief Interval between timestamp scans (polling fallback only)
+	///
+	Time pollInterval = 250ms;
+	///
+	/// \brief Force polling even if a native backend is available
+	///
+	bool bForcePoll = false;
+};
+
+///
+/// \brief RAII Service to initialise/deinitialise the watcher
+///
+struct Service final {
+	Service(Config config = {});
+	~Service();
+};
+
+///
+/// \brief Start watching a file (it need not exist yet)
+/// \returns `nullptr` if the watcher is not running
+///
+Flag watch(stdfs::path const& path);
+///
+/// \brief Check whether the watcher is running
+///
+bool active();
+///
+/// \brief Check whether the watcher is using a native backend (inotify) vs polling
+///
+bool native();
+
+///
+/// \brief Manually initialise the watcher (starts background thread)
+///
+bool init(Config config);
+///
+/// \brief Manually deinitialise the watcher
+///
+void deinit();
+} // namespace watcher
+} // namespace le::io
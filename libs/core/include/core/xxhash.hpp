@@ -0,0 +1,34 @@
+#pragma once
+#include <array>
+#include <core/std_types.hpp>
+
+namespace le {
+///
+/// \brief Streaming 64-bit xxHash (XXH64): fast non-cryptographic content hash
+///
+class XXH64 final {
+  public:
+	explicit XXH64(u64 seed = 0) noexcept;
+
+	///
+	/// \brief Hash a contiguous block in one call
+	///
+	static u64 hash(void const* pData, std::size_t size, u64 seed = 0) noexcept;
+
+	///
+	/// \brief Feed the next `size` bytes of input
+	///
+	XXH64& update(void const* pData, std::size_t size) noexcept;
+	///
+	/// \brief Obtain the hash of all input so far (does not reset state)
+	///
+	u64 digest() const noexcept;
+
+  private:
+	std::array<u64, 4> m_acc;
+	std::array<u8, 32> m_buffer;
+	u64 m_seed;
+	u64 m_total = 0;
+	std::size_t m_buffered = 0;
+};
+} // namespace le
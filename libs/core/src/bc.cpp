@@ -0,0 +1,493 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <core/bc.hpp>
+#include <core/ensure.hpp>
+#include <core/tasks.hpp>
+
+namespace le::bc {
+namespace {
+constexpr u32 g_minBandRows = 8;
+constexpr std::array<u32, 16> g_bc7Weights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+using Texel = std::array<s32, 4>;
+using Texels = std::array<Texel, 16>;
+
+struct BitWriter final {
+	u8* pData;
+	u32 pos = 0;
+
+	void write(u32 value, u32 count) noexcept {
+		for (u32 bit = 0; bit < count; ++bit, ++pos) {
+			if ((value >> bit) & 1) {
+				pData[pos / 8] |= (u8)(1 << (pos % 8));
+			}
+		}
+	}
+};
+
+struct BitReader final {
+	u8 const* pData;
+	u32 pos = 0;
+
+	u32 read(u32 count) noexcept {
+		u32 ret = 0;
+		for (u32 bit = 0; bit < count; ++bit, ++pos) {
+			ret |= (u32)((pData[pos / 8] >> (pos % 8)) & 1) << bit;
+		}
+		return ret;
+	}
+};
+
+s32 distance(Texel const& lhs, Texel const& rhs, std::size_t channels) noexcept {
+	s32 ret = 0;
+	for (std::size_t c = 0; c < channels; ++c) {
+		ret += (lhs[c] - rhs[c]) * (lhs[c] - rhs[c]);
+	}
+	return ret;
+}
+
+// Endpoints at the extremes of the texels' projections onto their principal axis
+void fitEndpoints(Texels const& texels, std::size_t channels, Texel& out_lo, Texel& out_hi) {
+	std::array<f32, 4> mean = {};
+	std::array<f32, 4> min = {255.0f, 255.0f, 255.0f, 255.0f};
+	std::array<f32, 4> max = {};
+	for (auto const& texel : texels) {
+		for (std::size_t c = 0; c < channels; ++c) {
+			mean[c] += (f32)texel[c] / 16.0f;
+			min[c] = std::min(min[c], (f32)texel[c]);
+			max[c] = std::max(max[c], (f32)texel[c]);
+		}
+	}
+	std::array<std::array<f32, 4>, 4> cov = {};
+	for (auto const& texel : texels) {
+		for (std::size_t row = 0; row < channels; ++row) {
+			for (std::size_t col = 0; col < channels; ++col) {
+				cov[row][col] += ((f32)texel[row] - mean[row]) * ((f32)texel[col] - mean[col]);
+			}
+		}
+	}
+	// power iteration, seeded with the bounding box diagonal
+	std::array<f32, 4> axis = {};
+	for (std::size_t c = 0; c < channels; ++c) {
+		axis[c] = max[c] - min[c];
+	}
+	for (s32 iter = 0; iter < 8; ++iter) {
+		std::array<f32, 4> next = {};
+		f32 norm = 0.0f;
+		for (std::size_t row = 0; row < channels; ++row) {
+			for (std::size_t col = 0; col < channels; ++col) {
+				next[row] += cov[row][col] * axis[col];
+			}
+			norm = std::max(norm, std::abs(next[row]));
+		}
+		if (norm <= 0.0f) {
+			break;
+		}
+		for (std::size_t c = 0; c < channels; ++c) {
+			axis[c] = next[c] / norm;
+		}
+	}
+	f32 lengthSq = 0.0f;
+	for (std::size_t c = 0; c < channels; ++c) {
+		lengthSq += axis[c] * axis[c];
+	}
+	f32 tMin = 0.0f;
+	f32 tMax = 0.0f;
+	if (lengthSq > 0.0f) {
+		for (auto const& texel : texels) {
+			f32 t = 0.0f;
+			for (std::size_t c = 0; c < channels; ++c) {
+				t += ((f32)texel[c] - mean[c]) * axis[c];
+			}
+			tMin = std::min(tMin, t / lengthSq);
+			tMax = std::max(tMax, t / lengthSq);
+		}
+	}
+	for (std::size_t c = 0; c < 4; ++c) {
+		out_lo[c] = out_hi[c] = 255;
+		if (c < channels) {
+			out_lo[c] = std::clamp((s32)std::lround(mean[c] + axis[c] * tMin), 0, 255);
+			out_hi[c] = std::clamp((s32)std::lround(mean[c] + axis[c] * tMax), 0, 255);
+		}
+	}
+}
+
+u16 pack565(Texel const& colour) noexcept {
+	u32 const r = ((u32)colour[0] * 31 + 127) / 255;
+	u32 const g = ((u32)colour[1] * 63 + 127) / 255;
+	u32 const b = ((u32)colour[2] * 31 + 127) / 255;
+	return (u16)((r << 11) | (g << 5) | b);
+}
+
+Texel unpack565(u16 colour) noexcept {
+	u32 const r = (colour >> 11) & 31;
+	u32 const g = (colour >> 5) & 63;
+	u32 const b = colour & 31;
+	return {(s32)((r << 3) | (r >> 2)), (s32)((g << 2) | (g >> 4)), (s32)((b << 3) | (b >> 2)), 255};
+}
+
+std::array<Texel, 4> colourPalette(u16 c0, u16 c1, bool bFourColour) noexcept {
+	std::array<Texel, 4> ret;
+	ret[0] = unpack565(c0);
+	ret[1] = unpack565(c1);
+	for (std::size_t c = 0; c < 3; ++c) {
+		if (bFourColour) {
+			ret[2][c] = (2 * ret[0][c] + ret[1][c] + 1) / 3;
+			ret[3][c] = (ret[0][c] + 2 * ret[1][c] + 1) / 3;
+		} else {
+			ret[2][c] = (ret[0][c] + ret[1][c] + 1) / 2;
+			ret[3][c] = 0;
+		}
+	}
+	ret[2][3] = 255;
+	ret[3][3] = bFourColour ? 255 : 0;
+	return ret;
+}
+
+std::array<s32, 8> channelPalette(u8 a0, u8 a1) noexcept {
+	std::array<s32, 8> ret;
+	ret[0] = a0;
+	ret[1] = a1;
+	if (a0 > a1) {
+		for (s32 idx = 2; idx < 8; ++idx) {
+			ret[(std::size_t)idx] = ((8 - idx) * a0 + (idx - 1) * a1 + 3) / 7;
+		}
+	} else {
+		for (s32 idx = 2; idx < 6; ++idx) {
+			ret[(std::size_t)idx] = ((6 - idx) * a0 + (idx - 1) * a1 + 2) / 5;
+		}
+		ret[6] = 0;
+		ret[7] = 255;
+	}
+	return ret;
+}
+
+// BC1 / colour half of BC3 (which always decodes in four colour mode)
+void encodeColour(Texels const& texels, u8* out_block, bool bPunchThrough) {
+	bool bTransparent = false;
+	if (bPunchThrough) {
+		bTransparent = std::any_of(texels.begin(), texels.end(), [](Texel const& t) { return t[3] < 128; });
+	}
+	Texel lo;
+	Texel hi;
+	fitEndpoints(texels, 3, lo, hi);
+	u16 c0 = pack565(hi);
+	u16 c1 = pack565(lo);
+	// four colour mode requires c0 > c1, three colour (+ transparent) mode c0 <= c1
+	if ((!bTransparent && c0 < c1) || (bTransparent && c0 > c1)) {
+		std::swap(c0, c1);
+	}
+	bool const bFourColour = !bPunchThrough || c0 > c1;
+	auto const palette = colourPalette(c0, c1, bFourColour);
+	u32 indices = 0;
+	for (std::size_t idx = 0; idx < texels.size(); ++idx) {
+		u32 best = 0;
+		if (bTransparent && texels[idx][3] < 128) {
+			best = 3;
+		} else {
+			s32 bestDist = distance(texels[idx], palette[0], 3);
+			u32 const count = bFourColour ? 4 : 3;
+			for (u32 entry = 1; entry < count; ++entry) {
+				if (s32 const dist = distance(texels[idx], palette[entry], 3); dist < bestDist) {
+					bestDist = dist;
+					best = entry;
+				}
+			}
+		}
+		indices |= best << (idx * 2);
+	}
+	out_block[0] = (u8)(c0 & 0xff);
+	out_block[1] = (u8)(c0 >> 8);
+	out_block[2] = (u8)(c1 & 0xff);
+	out_block[3] = (u8)(c1 >> 8);
+	for (std::size_t byte = 0; byte < 4; ++byte) {
+		out_block[4 + byte] = (u8)((indices >> (byte * 8)) & 0xff);
+	}
+}
+
+void decodeColour(u8 const* pBlock, u8* out_rgba, bool bPunchThrough) {
+	u16 const c0 = (u16)(pBlock[0] | (pBlock[1] << 8));
+	u16 const c1 = (u16)(pBlock[2] | (pBlock[3] << 8));
+	auto const palette = colourPalette(c0, c1, !bPunchThrough || c0 > c1);
+	u32 const indices = (u32)pBlock[4] | ((u32)pBlock[5] << 8) | ((u32)pBlock[6] << 16) | ((u32)pBlock[7] << 24);
+	for (std::size_t idx = 0; idx < 16; ++idx) {
+		auto const& texel = palette[(indices >> (idx * 2)) & 3];
+		for (std::size_t c = 0; c < 4; ++c) {
+			out_rgba[idx * 4 + c] = (u8)texel[c];
+		}
+	}
+}
+
+// BC4 block: BC3 alpha / each BC5 channel
+void encodeChannel(Texels const& texels, std::size_t channel, u8* out_block) {
+	s32 lo = 255;
+	s32 hi = 0;
+	for (auto const& texel : texels) {
+		lo = std::min(lo, texel[channel]);
+		hi = std::max(hi, texel[channel]);
+	}
+	out_block[0] = (u8)hi;
+	out_block[1] = (u8)lo;
+	auto const palette = channelPalette((u8)hi, (u8)lo);
+	u64 indices = 0;
+	for (std::size_t idx = 0; idx < texels.size(); ++idx) {
+		u64 best = 0;
+		s32 bestDist = std::abs(texels[idx][channel] - palette[0]);
+		for (u32 entry = 1; entry < 8 && hi > lo; ++entry) {
+			if (s32 const dist = std::abs(texels[idx][channel] - palette[entry]); dist < bestDist) {
+				bestDist = dist;
+				best = entry;
+			}
+		}
+		indices |= best << (idx * 3);
+	}
+	for (std::size_t byte = 0; byte < 6; ++byte) {
+		out_block[2 + byte] = (u8)((indices >> (byte * 8)) & 0xff);
+	}
+}
+
+void decodeChannel(u8 const* pBlock, u8* out_rgba, std::size_t channel) {
+	auto const palette = channelPalette(pBlock[0], pBlock[1]);
+	u64 indices = 0;
+	for (std::size_t byte = 0; byte < 6; ++byte) {
+		indices |= (u64)pBlock[2 + byte] << (byte * 8);
+	}
+	for (std::size_t idx = 0; idx < 16; ++idx) {
+		out_rgba[idx * 4 + channel] = (u8)palette[(indices >> (idx * 3)) & 7];
+	}
+}
+
+// BC7 mode 6: one subset, 7-bit RGBA endpoints with a unique p-bit each, 4-bit indices
+void encodeBC7(Texels const& texels, u8* out_block) {
+	Texel lo;
+	Texel hi;
+	fitEndpoints(texels, 4, lo, hi);
+	std::array<Texel, 2> endpoints;
+	std::array<u32, 2> pBits;
+	std::array<Texel, 2> quantised;
+	std::array<Texel const*, 2> const targets = {&lo, &hi};
+	for (std::size_t e = 0; e < 2; ++e) {
+		s32 bestError = -1;
+		for (u32 p = 0; p < 2; ++p) {
+			Texel q;
+			Texel recon;
+			s32 error = 0;
+			for (std::size_t c = 0; c < 4; ++c) {
+				q[c] = std::clamp(((*targets[e])[c] - (s32)p + 1) / 2, 0, 127);
+				recon[c] = (q[c] << 1) | (s32)p;
+				error += ((*targets[e])[c] - recon[c]) * ((*targets[e])[c] - recon[c]);
+			}
+			if (bestError < 0 || error < bestError) {
+				bestError = error;
+				quantised[e] = q;
+				endpoints[e] = recon;
+				pBits[e] = p;
+			}
+		}
+	}
+	std::array<Texel, 16> palette;
+	for (std::size_t idx = 0; idx < palette.size(); ++idx) {
+		for (std::size_t c = 0; c < 4; ++c) {
+			palette[idx][c] = (s32)(((64 - g_bc7Weights[idx]) * (u32)endpoints[0][c] + g_bc7Weights[idx] * (u32)endpoints[1][c] + 32) >> 6);
+		}
+	}
+	std::array<u32, 16> indices;
+	for (std::size_t idx = 0; idx < texels.size(); ++idx) {
+		s32 bestDist = distance(texels[idx], palette[0], 4);
+		indices[idx] = 0;
+		for (u32 entry = 1; entry < 16; ++entry) {
+			if (s32 const dist = distance(texels[idx], palette[entry], 4); dist < bestDist) {
+				bestDist = dist;
+				indices[idx] = entry;
+			}
+		}
+	}
+	// the anchor (first) index is stored without its most significant bit
+	if (indices[0] & 8) {
+		std::swap(quantised[0], quantised[1]);
+		std::swap(pBits[0], pBits[1]);
+		for (auto& index : indices) {
+			index = 15 - index;
+		}
+	}
+	std::fill(out_block, out_block + 16, (u8)0);
+	BitWriter writer{out_block};
+	writer.write(1 << 6, 7);
+	for (std::size_t c = 0; c < 4; ++c) {
+		writer.write((u32)quantised[0][c], 7);
+		writer.write((u32)quantised[1][c], 7);
+	}
+	writer.write(pBits[0], 1);
+	writer.write(pBits[1], 1);
+	for (std::size_t idx = 0; idx < indices.size(); ++idx) {
+		writer.write(indices[idx], idx == 0 ? 3 : 4);
+	}
+}
+
+bool decodeBC7(u8 const* pBlock, u8* out_rgba) {
+	BitReader reader{pBlock};
+	u32 mode = 0;
+	while (mode < 8 && reader.read(1) == 0) {
+		++mode;
+	}
+	if (mode != 6) {
+		return false;
+	}
+	std::array<Texel, 2> endpoints;
+	for (std::size_t c = 0; c < 4; ++c) {
+		endpoints[0][c] = (s32)reader.read(7) << 1;
+		endpoints[1][c] = (s32)reader.read(7) << 1;
+	}
+	for (auto& endpoint : endpoints) {
+		s32 const p = (s32)reader.read(1);
+		for (auto& channel : endpoint) {
+			channel |= p;
+		}
+	}
+	for (std::size_t idx = 0; idx < 16; ++idx) {
+		u32 const weight = g_bc7Weights[reader.read(idx == 0 ? 3 : 4)];
+		for (std::size_t c = 0; c < 4; ++c) {
+			out_rgba[idx * 4 + c] = (u8)(((64 - weight) * (u32)endpoints[0][c] + weight * (u32)endpoints[1][c] + 32) >> 6);
+		}
+	}
+	return true;
+}
+
+void encodeRows(Format format, u8 const* pRGBA, u32 width, u32 height, u8* out_blocks, u32 rowBegin, u32 rowEnd) {
+	u32 const blocksX = (width + blockExtent - 1) / blockExtent;
+	std::size_t const size = blockSize(format);
+	std::array<u8, 64> texels;
+	for (u32 by = rowBegin; by < rowEnd; ++by) {
+		for (u32 bx = 0; bx < blocksX; ++bx) {
+			for (u32 ty = 0; ty < blockExtent; ++ty) {
+				u32 const y = std::min(by * blockExtent + ty, height - 1);
+				for (u32 tx = 0; tx < blockExtent; ++tx) {
+					u32 const x = std::min(bx * blockExtent + tx, width - 1);
+					std::copy_n(pRGBA + ((std::size_t)y * width + x) * 4, 4, texels.data() + (ty * blockExtent + tx) * 4);
+				}
+			}
+			encodeBlock(format, texels.data(), out_blocks + ((std::size_t)by * blocksX + bx) * size);
+		}
+	}
+}
+} // namespace
+
+std::size_t blockSize(Format format) noexcept {
+	return format == Format::eBC1 ? 8 : 16;
+}
+
+std::size_t imageSize(Format format, u32 width, u32 height) noexcept {
+	std::size_t const blocksX = (width + blockExtent - 1) / blockExtent;
+	std::size_t const blocksY = (height + blockExtent - 1) / blockExtent;
+	return blocksX * blocksY * blockSize(format);
+}
+
+void encodeBlock(Format format, u8 const* pRGBA, u8* out_block) {
+	Texels texels;
+	for (std::size_t idx = 0; idx < texels.size(); ++idx) {
+		for (std::size_t c = 0; c < 4; ++c) {
+			texels[idx][c] = pRGBA[idx * 4 + c];
+		}
+	}
+	switch (format) {
+	case Format::eBC1: {
+		encodeColour(texels, out_block, true);
+		break;
+	}
+	case Format::eBC3: {
+		encodeChannel(texels, 3, out_block);
+		encodeColour(texels, out_block + 8, false);
+		break;
+	}
+	case Format::eBC5: {
+		encodeChannel(texels, 0, out_block);
+		encodeChannel(texels, 1, out_block + 8);
+		break;
+	}
+	case Format::eBC7: {
+		encodeBC7(texels, out_block);
+		break;
+	}
+	default: {
+		ENSURE(false, "Invalid format!");
+		break;
+	}
+	}
+}
+
+bool decodeBlock(Format format, u8 const* pBlock, u8* out_rgba) {
+	switch (format) {
+	case Format::eBC1: {
+		decodeColour(pBlock, out_rgba, true);
+		return true;
+	}
+	case Format::eBC3: {
+		decodeColour(pBlock + 8, out_rgba, false);
+		decodeChannel(pBlock, out_rgba, 3);
+		return true;
+	}
+	case Format::eBC5: {
+		decodeChannel(pBlock, out_rgba, 0);
+		decodeChannel(pBlock + 8, out_rgba, 1);
+		for (std::size_t idx = 0; idx < 16; ++idx) {
+			out_rgba[idx * 4 + 2] = 0;
+			out_rgba[idx * 4 + 3] = 255;
+		}
+		return true;
+	}
+	case Format::eBC7: {
+		return decodeBC7(pBlock, out_rgba);
+	}
+	default: {
+		return false;
+	}
+	}
+}
+
+std::vector<u8> encode(Format format, Span<u8> rgba, u32 width, u32 height, bool bParallel) {
+	std::vector<u8> ret;
+	ENSURE(rgba.extent >= (std::size_t)width * height * 4, "Invalid image data!");
+	if (width == 0 || height == 0 || rgba.extent < (std::size_t)width * height * 4) {
+		return ret;
+	}
+	ret.resize(imageSize(format, width, height));
+	u32 const blocksY = (height + blockExtent - 1) / blockExtent;
+	u32 const workers = bParallel ? (u32)tasks::workerCount() : 0;
+	u32 const bandCount = std::min(workers + 1, blocksY / g_minBandRows);
+	u8* pOut = ret.data();
+	u8 const* pIn = rgba.pData;
+	if (workers > 0 && bandCount > 1) {
+		tasks::forBands(blocksY, bandCount, [=](u32 begin, u32 end) { encodeRows(format, pIn, width, height, pOut, begin, end); });
+	} else {
+		encodeRows(format, pIn, width, height, pOut, 0, blocksY);
+	}
+	return ret;
+}
+
+std::vector<u8> decode(Format format, Span<u8> blocks, u32 width, u32 height) {
+	std::vector<u8> ret;
+	if (width == 0 || height == 0 || blocks.extent != imageSize(format, width, height)) {
+		return ret;
+	}
+	ret.resize((std::size_t)width * height * 4);
+	u32 const blocksX = (width + blockExtent - 1) / blockExtent;
+	u32 const blocksY = (height + blockExtent - 1) / blockExtent;
+	std::size_t const size = blockSize(format);
+	std::array<u8, 64> texels;
+	for (u32 by = 0; by < blocksY; ++by) {
+		for (u32 bx = 0; bx < blocksX; ++bx) {
+			if (!decodeBlock(format, blocks.pData + ((std::size_t)by * blocksX + bx) * size, texels.data())) {
+				return {};
+			}
+			for (u32 ty = 0; ty < blockExtent && by * blockExtent + ty < height; ++ty) {
+				for (u32 tx = 0; tx < blockExtent && bx * blockExtent + tx < width; ++tx) {
+					std::size_t const dst = ((std::size_t)(by * blockExtent + ty) * width + bx * blockExtent + tx) * 4;
+					std::copy_n(texels.data() + (ty * blockExtent + tx) * 4, 4, ret.data() + dst);
+				}
+			}
+		}
+	}
+	return ret;
+}
+} // namespace le::bc
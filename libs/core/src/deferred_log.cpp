@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <core/deferred_log.hpp>
+#include <core/threads.hpp>
+
+namespace le::deferred {
+namespace {
+constexpr std::string_view g_tName = "deferred";
+
+///
+/// \brief Single-producer single-consumer ring of records (owned by one logging thread)
+///
+struct Ring final {
+	std::vector<detail::Record> records;
+	std::size_t mask = 0;
+	std::atomic<std::size_t> head = 0; // consumer
+	std::atomic<std::size_t> tail = 0; // producer
+	std::atomic<bool> bOrphaned = false;
+
+	Ring(std::size_t capacity) {
+		std::size_t size = 1;
+		while (size < capacity) {
+			size <<= 1;
+		}
+		records.resize(size);
+		mask = size - 1;
+	}
+};
+
+struct State final {
+	std::mutex mutex;
+	std::vector<std::shared_ptr<Ring>> rings;
+	Config config;
+	std::atomic<u64> generation = 0;
+	std::atomic<u64> drained = 0;
+	// producers between acquire() and publish() / abandon(): deinit waits for them before the final drain
+	std::atomic<u32> writers = 0;
+	// doubles as the "closed" flag: acquire() fails (callers log synchronously) once cleared
+	std::atomic<bool> bWork = false;
+	threads::TScoped thread;
+};
+
+struct Local final {
+	std::shared_ptr<Ring> ring;
+	u64 generation = 0;
+
+	~Local() {
+		if (ring) {
+			ring->bOrphaned.store(true);
+		}
+	}
+};
+
+State g_state;
+thread_local Local t_local;
+
+// Called on logger thread (or deinit, after join)
+void drain(std::vector<detail::Record>& out_batch) {
+	{
+		std::scoped_lock lock(g_state.mutex);
+		for (auto iter = g_state.rings.begin(); iter != g_state.rings.end();) {
+			auto& ring = **iter;
+			// read orphaned status before tail: an orphaned ring will not receive any more records
+			bool const bOrphaned = ring.bOrphaned.load();
+			auto const head = ring.head.load(std::memory_order_relaxed);
+			auto const tail = ring.tail.load(std::memory_order_acquire);
+			for (auto idx = head; idx != tail; ++idx) {
+				out_batch.push_back(ring.records[idx & ring.mask]);
+			}
+			ring.head.store(tail, std::memory_order_release);
+			iter = bOrphaned ? g_state.rings.erase(iter) : iter + 1;
+		}
+	}
+	// restore chronological order across threads (each ring is already ordered)
+	std::stable_sort(out_batch.begin(), out_batch.end(), [](auto const& lhs, auto const& rhs) { return lhs.timestamp < rhs.timestamp; });
+	for (auto const& record : out_batch) {
+		record.emit(record);
+	}
+	out_batch.clear();
+}
+} // namespace
+
+Service::Service(Config config) {
+	if (!init(config)) {
+		logE("[{}] Failed to initialise deferred logger!", g_tName);
+	}
+}
+
+Service::~Service() {
+	deinit();
+}
+
+bool active() {
+	return g_state.bWork.load();
+}
+
+void flush() {
+	if (active()) {
+		// wait for two complete drains: the first may have started before this call
+		auto const target = g_state.drained.load() + 2;
+		while (active() && g_state.drained.load() < target) {
+			threads::sleep(g_state.config.interval);
+		}
+	}
+}
+
+bool init(Config config) {
+	if (g_state.bWork.load()) {
+		return false;
+	}
+	g_state.config = config;
+	++g_state.generation;
+	g_state.bWork.store(true);
+	g_state.thread = threads::newThread([]() {
+		threads::setName("levk-logger-deferred");
+		std::vector<detail::Record> batch;
+		while (g_state.bWork.load()) {
+			threads::sleep(g_state.config.interval);
+			drain(batch);
+			++g_state.drained;
+		}
+	});
+	logI("[{}] Deferred logging initialised", g_tName);
+	return true;
+}
+
+void deinit() {
+	if (g_state.bWork.load()) {
+		// close first: no new records after this, then wait for in-flight ones to be published
+		g_state.bWork.store(false);
+		while (g_state.writers.load() > 0) {
+			threads::sleep();
+		}
+		g_state.thread = {};
+		std::vector<detail::Record> batch;
+		drain(batch);
+		std::scoped_lock lock(g_state.mutex);
+		g_state.rings.clear();
+		logI("[{}] Deferred logging deinitialised", g_tName);
+	}
+}
+
+detail::Record* detail::acquire() {
+	++g_state.writers;
+	if (!g_state.bWork.load()) {
+		--g_state.writers;
+		return nullptr;
+	}
+	auto const generation = g_state.generation.load(std::memory_order_relaxed);
+	if (!t_local.ring || t_local.generation != generation) {
+		t_local.ring = std::make_shared<Ring>(std::max(g_state.config.recordsPerThread, (std::size_t)1));
+		t_local.generation = generation;
+		std::scoped_lock lock(g_state.mutex);
+		g_state.rings.push_back(t_local.ring);
+	}
+	auto& ring = *t_local.ring;
+	auto const tail = ring.tail.load(std::memory_order_relaxed);
+	if (tail - ring.head.load(std::memory_order_acquire) > ring.mask) {
+		--g_state.writers;
+		return nullptr;
+	}
+	return &ring.records[tail & ring.mask];
+}
+
+void detail::publish() {
+	auto& ring = *t_local.ring;
+	ring.tail.store(ring.tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	--g_state.writers;
+}
+
+void detail::abandon() {
+	--g_state.writers;
+}
+} // namespace le::deferred
@@ -0,0 +1,125 @@
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <fmt/format.h>
+#include <core/disk_cache.hpp>
+#include <core/log.hpp>
+#include <core/xxhash.hpp>
+
+namespace le::io {
+namespace {
+constexpr std::string_view g_tName = "DiskCache";
+constexpr u32 g_magic = 0x43564c; // "LVC"
+
+struct Header final {
+	u32 magic = g_magic;
+	u32 version = DiskCache::version;
+	u64 size = 0;
+	u64 checksum = 0;
+};
+
+std::atomic<u32> g_nextTemp = 0;
+} // namespace
+
+DiskCache::DiskCache(stdfs::path directory) {
+	open(std::move(directory));
+}
+
+u64 DiskCache::key(Span<std::byte> source, std::string_view options) noexcept {
+	XXH64 hasher(DiskCache::version);
+	hasher.update(source.pData, source.size());
+	hasher.update(options.data(), options.size());
+	return hasher.digest();
+}
+
+bool DiskCache::open(stdfs::path directory) {
+	std::error_code errCode;
+	stdfs::create_directories(directory, errCode);
+	if (!stdfs::is_directory(directory, errCode)) {
+		logW("[{}] Failed to create cache directory [{}]", g_tName, directory.generic_string());
+		m_directory.clear();
+		return false;
+	}
+	m_directory = std::move(directory);
+	logI("[{}] Cache directory: [{}]", g_tName, m_directory.generic_string());
+	return true;
+}
+
+void DiskCache::close() {
+	m_directory.clear();
+}
+
+bool DiskCache::active() const noexcept {
+	return !m_directory.empty();
+}
+
+stdfs::path const& DiskCache::directory() const noexcept {
+	return m_directory;
+}
+
+std::optional<bytearray> DiskCache::load(u64 key) const {
+	if (!active()) {
+		return std::nullopt;
+	}
+	auto const filePath = path(key);
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file) {
+		return std::nullopt;
+	}
+	std::error_code errCode;
+	auto const fileSize = (u64)stdfs::file_size(filePath, errCode);
+	Header header;
+	bytearray ret;
+	bool const bHeader = !errCode && file.read(reinterpret_cast<char*>(&header), sizeof(header)) && header.magic == g_magic && header.version == version;
+	if (bHeader && header.size == fileSize - sizeof(header)) {
+		ret.resize((std::size_t)header.size);
+		if (file.read(reinterpret_cast<char*>(ret.data()), (std::streamsize)ret.size()) && XXH64::hash(ret.data(), ret.size()) == header.checksum) {
+			return ret;
+		}
+	}
+	file.close();
+	logW("[{}] Discarding corrupt / stale entry [{}]", g_tName, filePath.filename().generic_string());
+	erase(key);
+	return std::nullopt;
+}
+
+bool DiskCache::store(u64 key, Span<std::byte> data) const {
+	if (!active()) {
+		return false;
+	}
+	auto const filePath = path(key);
+	auto tempPath = filePath;
+	tempPath += fmt::format(".{}-{}.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()), g_nextTemp++);
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		Header header;
+		header.size = data.size();
+		header.checksum = XXH64::hash(data.pData, data.size());
+		file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+		file.write(reinterpret_cast<char const*>(data.pData), (std::streamsize)data.size());
+		if (!file) {
+			file.close();
+			std::error_code errCode;
+			stdfs::remove(tempPath, errCode);
+			logW("[{}] Failed to write entry [{}]", g_tName, filePath.filename().generic_string());
+			return false;
+		}
+	}
+	std::error_code errCode;
+	stdfs::rename(tempPath, filePath, errCode);
+	if (errCode) {
+		stdfs::remove(tempPath, errCode);
+		return false;
+	}
+	return true;
+}
+
+bool DiskCache::erase(u64 key) const {
+	std::error_code errCode;
+	return active() && stdfs::remove(path(key), errCode);
+}
+
+stdfs::path DiskCache::path(u64 key) const {
+	return m_directory / fmt::format("{:016x}.bin", key);
+}
+} // namespace le::io
@@ -1,86 +1,214 @@
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
+#include <vector>
 #include <core/io.hpp>
 #include <core/log.hpp>
 #include <core/threads.hpp>
 #include <io_impl.hpp>
-#include <kt/async_queue/async_queue.hpp>
 
 namespace le::io {
 namespace {
-struct FileLogger final {
-	FileLogger();
+using Overflow = FileLogConfig::Overflow;
+
+///
+/// \brief Fixed-capacity ring of pending lines; slots retain their capacity across reuse
+///
+struct Lines final {
+	std::vector<std::string> slots;
+	std::size_t head = 0;
+	std::size_t count = 0;
+	std::size_t bytes = 0;
+
+	bool full() const noexcept {
+		return count >= slots.size();
+	}
+
+	void push(std::string_view text) {
+		auto& slot = slots[(head + count) % slots.size()];
+		slot.assign(text.data(), text.size());
+		bytes += slot.size() + 1;
+		++count;
+	}
+
+	void popFront() {
+		bytes -= slots[head].size() + 1;
+		head = (head + 1) % slots.size();
+		--count;
+	}
 
+	void drain(std::string& out_batch) {
+		out_batch.reserve(out_batch.size() + bytes);
+		for (; count > 0; --count) {
+			auto& slot = slots[head];
+			out_batch += slot;
+			out_batch += '\n';
+			head = (head + 1) % slots.size();
+		}
+		head = bytes = 0;
+	}
+};
+
+struct FileLogger final {
+	std::mutex mutex;
+	std::condition_variable cvFlush;
+	std::condition_variable cvSpace;
+	Lines lines;
+	stdfs::path path;
+	FileLogConfig config;
+	std::ofstream file;
+	std::size_t written = 0;
+	u64 dropped = 0;
+	bool bWork = false;
 	threads::TScoped thread;
+
+	bool open(stdfs::path logFilePath, FileLogConfig logConfig);
+	void close();
+
+	void push(std::string_view text);
+	void write(std::string const& batch);
+	void rotate();
 };
 
-std::filesystem::path g_logFilePath;
-kt::async_queue<std::string> g_queue;
-void dumpToFile(std::filesystem::path const& path, std::string const& str);
+FileLogger g_fileLogger;
+dl::config::on_log::token g_token;
 
-FileLogger::FileLogger() {
-	std::ifstream iFile(g_logFilePath);
-	if (iFile.good()) {
-		iFile.close();
-		std::filesystem::path backup(g_logFilePath);
+bool FileLogger::open(stdfs::path logFilePath, FileLogConfig logConfig) {
+	path = std::move(logFilePath);
+	config = logConfig;
+	std::error_code errCode;
+	if (stdfs::is_regular_file(path, errCode)) {
+		stdfs::path backup(path);
 		backup += ".bak";
-		std::filesystem::rename(g_logFilePath, backup);
+		stdfs::rename(path, backup, errCode);
 	}
-	std::ofstream oFile(g_logFilePath);
-	if (!oFile.good()) {
-		return;
+	file.open(path, std::ios::binary | std::ios::trunc);
+	if (!file.good()) {
+		return false;
 	}
-	oFile.close();
-	g_queue.active(true);
-	logI("Logging to file: {}", std::filesystem::absolute(g_logFilePath).generic_string());
-	thread = threads::newThread([]() {
-		while (auto str = g_queue.pop()) {
-			*str += "\n";
-			dumpToFile(g_logFilePath, *str);
+	lines.slots.resize(std::max(config.bufferLines, (std::size_t)1));
+	lines.head = lines.count = lines.bytes = 0;
+	written = 0;
+	dropped = 0;
+	bWork = true;
+	thread = threads::newThread([this]() {
+		threads::setName("levk-logger");
+		std::string batch;
+		bool bExit = false;
+		while (!bExit) {
+			{
+				std::unique_lock lock(mutex);
+				cvFlush.wait_for(lock, config.flushInterval.duration, [this]() { return !bWork || lines.bytes >= config.flushBytes || lines.full(); });
+				bExit = !bWork;
+				if (dropped > 0) {
+					batch += fmt::format("[FileLogger] {} lines dropped\n", dropped);
+					dropped = 0;
+				}
+				lines.drain(batch);
+			}
+			cvSpace.notify_all();
+			// Don't log from this thread: it would feed back into the queue
+			if (!batch.empty()) {
+				write(batch);
+				batch.clear();
+			}
 		}
 	});
-	return;
+	return true;
 }
 
-void dumpToFile(std::filesystem::path const& path, std::string const& str) {
-	if (!path.empty() && !str.empty()) {
-		std::ofstream file(path, std::ios_base::app);
-		file.write(str.data(), (std::streamsize)str.length());
+void FileLogger::close() {
+	{
+		std::scoped_lock lock(mutex);
+		bWork = false;
 	}
-	return;
+	cvFlush.notify_all();
+	cvSpace.notify_all();
+	// thread flushes residue before exiting
+	thread = {};
+	file.close();
 }
 
-std::optional<FileLogger> g_fileLogger;
-dl::config::on_log::token g_token;
+void FileLogger::push(std::string_view text) {
+	std::unique_lock lock(mutex);
+	if (!bWork) {
+		return;
+	}
+	if (lines.full()) {
+		switch (config.overflow) {
+		case Overflow::eDropNewest: {
+			++dropped;
+			return;
+		}
+		case Overflow::eDropOldest: {
+			lines.popFront();
+			++dropped;
+			break;
+		}
+		default: {
+			cvFlush.notify_one();
+			cvSpace.wait(lock, [this]() { return !bWork || !lines.full(); });
+			if (!bWork) {
+				return;
+			}
+			break;
+		}
+		}
+	}
+	lines.push(text);
+	if (lines.bytes >= config.flushBytes || lines.full()) {
+		cvFlush.notify_one();
+	}
+}
 
-void fileLog(std::string_view text, dl::level) {
-	if (g_fileLogger) {
-		g_queue.push(std::string(text));
+void FileLogger::write(std::string const& batch) {
+	if (config.rotateBytes > 0 && written > 0 && written + batch.size() > config.rotateBytes) {
+		rotate();
 	}
+	file.write(batch.data(), (std::streamsize)batch.size());
+	file.flush();
+	written += batch.size();
+}
+
+void FileLogger::rotate() {
+	file.close();
+	std::error_code errCode;
+	auto const rotated = [this](u32 index) {
+		stdfs::path ret(path);
+		ret += fmt::format(".{}", index);
+		return ret;
+	};
+	if (config.rotateCount > 0) {
+		stdfs::remove(rotated(config.rotateCount), errCode);
+		for (u32 index = config.rotateCount; index > 1; --index) {
+			stdfs::rename(rotated(index - 1), rotated(index), errCode);
+		}
+		stdfs::rename(path, rotated(1), errCode);
+	}
+	file.open(path, std::ios::binary | std::ios::trunc);
+	written = 0;
+}
+
+void fileLog(std::string_view text, dl::level) {
+	g_fileLogger.push(text);
 }
 } // namespace
 
-Service::Service(std::optional<std::filesystem::path> logFilePath) {
+Service::Service(std::optional<stdfs::path> logFilePath, FileLogConfig config) {
 	if (logFilePath && !logFilePath->empty()) {
-		g_logFilePath = std::move(*logFilePath);
-		g_fileLogger = FileLogger();
-		g_token = dl::config::g_on_log.add(&fileLog);
+		if (g_fileLogger.open(std::move(*logFilePath), config)) {
+			g_token = dl::config::g_on_log.add(&fileLog);
+			logI("Logging to file: {}", stdfs::absolute(g_fileLogger.path).generic_string());
+		}
 	}
 }
 
 Service::~Service() {
 	impl::deinitPhysfs();
-	if (g_fileLogger) {
+	if (g_fileLogger.thread.valid()) {
 		logI("File Logging terminated");
 		g_token = {};
-		g_queue.active(false);
-		g_fileLogger.reset();
-		auto residue = g_queue.clear();
-		std::string residueStr;
-		for (auto& str : residue) {
-			residueStr = std::move(str);
-			residueStr += "\n";
-		}
-		dumpToFile(g_logFilePath, residueStr);
+		g_fileLogger.close();
 	}
 }
 } // namespace le::io
@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <core/byte_stream.hpp>
+#include <core/ensure.hpp>
+#include <core/ktx2.hpp>
+#include <core/log.hpp>
+#include <core/mip_chain.hpp>
+
+namespace le::io {
+namespace {
+constexpr std::string_view g_tName = "ktx2";
+// Serialised size of Header (no padding)
+constexpr u64 g_headerSize = 13 * sizeof(u32) + 2 * sizeof(u64);
+
+// Returns false (leaving out_product untouched) if lhs * rhs overflows
+bool multiply(u64 lhs, u64 rhs, u64& out_product) noexcept {
+	if (lhs != 0 && rhs > std::numeric_limits<u64>::max() / lhs) {
+		return false;
+	}
+	out_product = lhs * rhs;
+	return true;
+}
+
+// Data Format Descriptor constants (Khronos Data Format Specification 1.3)
+enum class DFModel : u8 { eRGBSDA = 1, eBC1A = 128, eBC3 = 130, eBC5 = 132, eBC7 = 134 };
+enum class DFTransfer : u8 { eLinear = 1, eSRGB = 2 };
+constexpr u8 g_dfPrimariesBT709 = 1;
+constexpr u8 g_dfQualifierLinear = 0x10;
+constexpr u32 g_dfVersion = 2;
+
+struct Sample final {
+	u16 bitOffset = 0;
+	u8 bitLength = 0;
+	u8 channelType = 0;
+	u32 upper = 0;
+};
+
+constexpr u64 aligned(u64 offset, u64 alignment) noexcept {
+	return (offset + alignment - 1) / alignment * alignment;
+}
+
+// lcm(texel block size, 4)
+u64 levelAlignment(ktx2::VkFormat format) noexcept {
+	if (auto const bc = ktx2::bcFormat(format)) {
+		return (u64)bc::blockSize(*bc);
+	}
+	return 4;
+}
+
+bytearray descriptor(ktx2::VkFormat format) {
+	DFModel model = DFModel::eRGBSDA;
+	std::array<u8, 4> dimensions = {};
+	u8 bytes = 4;
+	std::vector<Sample> samples;
+	bool const bSRGB = ktx2::isSRGB(format);
+	if (auto const bc = ktx2::bcFormat(format)) {
+		dimensions = {bc::blockExtent - 1, bc::blockExtent - 1, 0, 0};
+		bytes = (u8)bc::blockSize(*bc);
+		switch (*bc) {
+		case bc::Format::eBC1: {
+			model = DFModel::eBC1A;
+			samples = {{0, 63, 1, ~0U}};
+			break;
+		}
+		case bc::Format::eBC3: {
+			model = DFModel::eBC3;
+			samples = {{0, 63, 15 | g_dfQualifierLinear, ~0U}, {64, 63, 0, ~0U}};
+			break;
+		}
+		case bc::Format::eBC5: {
+			model = DFModel::eBC5;
+			samples = {{0, 63, 0, ~0U}, {64, 63, 1, ~0U}};
+			break;
+		}
+		default: {
+			model = DFModel::eBC7;
+			samples = {{0, 127, 0, ~0U}};
+			break;
+		}
+		}
+	} else {
+		samples = {{0, 7, 0, 255}, {8, 7, 1, 255}, {16, 7, 2, 255}, {24, 7, 15 | g_dfQualifierLinear, 255}};
+	}
+	u32 const blockSize = 24 + 16 * (u32)samples.size();
+	ByteWriter writer;
+	writer.write(blockSize + 4);
+	writer.write((u32)0); // vendor ID (Khronos) and descriptor type (basic)
+	writer.write(g_dfVersion | (blockSize << 16));
+	writer.write(model).write(g_dfPrimariesBT709).write(bSRGB ? DFTransfer::eSRGB : DFTransfer::eLinear).write((u8)0);
+	writer.write(dimensions);
+	std::array<u8, 8> planes = {bytes};
+	writer.write(planes);
+	for (auto const& sample : samples) {
+		writer.write(sample.bitOffset).write(sample.bitLength).write(sample.channelType);
+		writer.write((u32)0).write((u32)0).write(sample.upper);
+	}
+	return writer.release();
+}
+} // namespace
+
+Span<u8> ktx2::Image::image(std::size_t level, std::size_t layer) const {
+	ENSURE(level < levels.size() && layer < (std::size_t)(layers * faces), "Invalid index!");
+	std::size_t const size = levels[level].extent / (std::size_t)(layers * faces);
+	return Span<u8>(levels[level].pData + size * layer, size);
+}
+
+bool ktx2::identify(Span<std::byte> bytes) noexcept {
+	return bytes.extent >= sizeof(identifier) && std::memcmp(bytes.pData, identifier, sizeof(identifier)) == 0;
+}
+
+std::optional<ktx2::Image> ktx2::parse(Span<std::byte> bytes) {
+	if (!identify(bytes)) {
+		logW("[{}] Invalid identifier", g_tName);
+		return std::nullopt;
+	}
+	ByteReader reader(Span<std::byte>(bytes.pData + sizeof(identifier), bytes.extent - sizeof(identifier)));
+	Header header;
+	reader.read(header.vkFormat).read(header.typeSize).read(header.pixelWidth).read(header.pixelHeight).read(header.pixelDepth);
+	reader.read(header.layerCount).read(header.faceCount).read(header.levelCount).read(header.supercompressionScheme);
+	reader.read(header.dfdByteOffset).read(header.dfdByteLength).read(header.kvdByteOffset).read(header.kvdByteLength);
+	reader.read(header.sgdByteOffset).read(header.sgdByteLength);
+	if (!reader) {
+		logW("[{}] Truncated header", g_tName);
+		return std::nullopt;
+	}
+	Image ret;
+	ret.format = (VkFormat)header.vkFormat;
+	ret.width = header.pixelWidth;
+	ret.height = header.pixelHeight;
+	ret.layers = std::max(header.layerCount, 1U);
+	ret.faces = header.faceCount;
+	if (header.supercompressionScheme != 0) {
+		logW("[{}] Unsupported supercompression scheme [{}]", g_tName, header.supercompressionScheme);
+		return std::nullopt;
+	}
+	if (imageSize(ret.format, 1, 1) == 0) {
+		logW("[{}] Unsupported VkFormat [{}]", g_tName, header.vkFormat);
+		return std::nullopt;
+	}
+	if (ret.width == 0 || ret.height == 0 || header.pixelDepth > 1 || (ret.faces != 1 && ret.faces != 6)) {
+		logW("[{}] Unsupported dimensions [{}x{}x{}] / faces [{}]", g_tName, ret.width, ret.height, header.pixelDepth, ret.faces);
+		return std::nullopt;
+	}
+	// no supported format packs more than two texels per byte (BC1), so anything larger cannot fit in the file (and would overflow imageSize)
+	if ((u64)ret.width * ret.height / 2 > (u64)bytes.extent) {
+		logW("[{}] Dimensions [{}x{}] exceed file size", g_tName, ret.width, ret.height);
+		return std::nullopt;
+	}
+	u32 const levelCount = std::max(header.levelCount, 1U);
+	if (levelCount > mips::levelCount(ret.width, ret.height)) {
+		logW("[{}] Too many levels [{}] for [{}x{}]", g_tName, levelCount, ret.width, ret.height);
+		return std::nullopt;
+	}
+	for (u32 level = 0; level < levelCount; ++level) {
+		LevelIndex index;
+		reader.read(index.byteOffset).read(index.byteLength).read(index.uncompressedByteLength);
+		u32 const width = std::max(ret.width >> level, 1U);
+		u32 const height = std::max(ret.height >> level, 1U);
+		u64 expected = 0;
+		bool const bSize = multiply((u64)imageSize(ret.format, width, height), (u64)ret.layers * ret.faces, expected);
+		if (!reader || !bSize || index.byteLength != expected || index.byteOffset > bytes.extent || index.byteLength > bytes.extent - index.byteOffset) {
+			logW("[{}] Invalid level [{}]", g_tName, level);
+			return std::nullopt;
+		}
+		ret.levels.push_back(Span<u8>(reinterpret_cast<u8 const*>(bytes.pData + index.byteOffset), (std::size_t)index.byteLength));
+	}
+	return ret;
+}
+
+bytearray ktx2::write(Image const& image) {
+	u64 const levelCount = (u64)image.levels.size();
+	if (imageSize(image.format, 1, 1) == 0 || levelCount == 0 || image.width == 0 || image.height == 0) {
+		logE("[{}] Invalid image", g_tName);
+		return {};
+	}
+	for (u32 level = 0; level < (u32)levelCount; ++level) {
+		u32 const width = std::max(image.width >> level, 1U);
+		u32 const height = std::max(image.height >> level, 1U);
+		if (image.levels[level].extent != imageSize(image.format, width, height) * image.layers * image.faces) {
+			logE("[{}] Invalid level [{}] size [{}]", g_tName, level, image.levels[level].extent);
+			return {};
+		}
+	}
+	bytearray const dfd = descriptor(image.format);
+	u64 const indexOffset = sizeof(identifier) + g_headerSize;
+	u64 const dfdOffset = indexOffset + levelCount * sizeof(LevelIndex);
+	u64 const alignment = levelAlignment(image.format);
+	// level data is stored smallest first
+	std::vector<LevelIndex> indices((std::size_t)levelCount);
+	u64 offset = dfdOffset + (u64)dfd.size();
+	for (std::size_t level = (std::size_t)levelCount; level > 0; --level) {
+		auto& index = indices[level - 1];
+		offset = aligned(offset, alignment);
+		index.byteOffset = offset;
+		index.byteLength = index.uncompressedByteLength = (u64)image.levels[level - 1].extent;
+		offset += index.byteLength;
+	}
+	Header header;
+	header.vkFormat = (u32)image.format;
+	header.pixelWidth = image.width;
+	header.pixelHeight = image.height;
+	header.layerCount = image.layers > 1 ? image.layers : 0;
+	header.faceCount = image.faces;
+	header.levelCount = (u32)levelCount;
+	header.dfdByteOffset = (u32)dfdOffset;
+	header.dfdByteLength = (u32)dfd.size();
+	ByteWriter writer;
+	writer.write(identifier);
+	writer.write(header.vkFormat).write(header.typeSize).write(header.pixelWidth).write(header.pixelHeight).write(header.pixelDepth);
+	writer.write(header.layerCount).write(header.faceCount).write(header.levelCount).write(header.supercompressionScheme);
+	writer.write(header.dfdByteOffset).write(header.dfdByteLength).write(header.kvdByteOffset).write(header.kvdByteLength);
+	writer.write(header.sgdByteOffset).write(header.sgdByteLength);
+	for (auto const& index : indices) {
+		writer.write(index.byteOffset).write(index.byteLength).write(index.uncompressedByteLength);
+	}
+	ENSURE(writer.bytes().size() == dfdOffset, "Invalid layout!");
+	bytearray ret = writer.release();
+	ret.insert(ret.end(), dfd.begin(), dfd.end());
+	for (std::size_t level = (std::size_t)levelCount; level > 0; --level) {
+		auto const& index = indices[level - 1];
+		auto const& data = image.levels[level - 1];
+		ret.resize((std::size_t)index.byteOffset);
+		auto const pData = reinterpret_cast<std::byte const*>(data.pData);
+		ret.insert(ret.end(), pData, pData + data.extent);
+	}
+	return ret;
+}
+
+std::size_t ktx2::imageSize(VkFormat format, u32 width, u32 height) noexcept {
+	if (auto const bc = bcFormat(format)) {
+		return bc::imageSize(*bc, width, height);
+	}
+	if (format == VkFormat::eR8G8B8A8Unorm || format == VkFormat::eR8G8B8A8Srgb) {
+		return (std::size_t)width * height * 4;
+	}
+	return 0;
+}
+
+ktx2::VkFormat ktx2::vkFormat(bc::Format format, bool bSRGB) noexcept {
+	switch (format) {
+	case bc::Format::eBC1: {
+		return bSRGB ? VkFormat::eBC1RGBASrgb : VkFormat::eBC1RGBAUnorm;
+	}
+	case bc::Format::eBC3: {
+		return bSRGB ? VkFormat::eBC3Srgb : VkFormat::eBC3Unorm;
+	}
+	case bc::Format::eBC5: {
+		return VkFormat::eBC5Unorm;
+	}
+	case bc::Format::eBC7: {
+		return bSRGB ? VkFormat::eBC7Srgb : VkFormat::eBC7Unorm;
+	}
+	default: {
+		return VkFormat::eUndefined;
+	}
+	}
+}
+
+std::optional<bc::Format> ktx2::bcFormat(VkFormat format) noexcept {
+	switch (format) {
+	case VkFormat::eBC1RGBAUnorm:
+	case VkFormat::eBC1RGBASrgb: {
+		return bc::Format::eBC1;
+	}
+	case VkFormat::eBC3Unorm:
+	case VkFormat::eBC3Srgb: {
+		return bc::Format::eBC3;
+	}
+	case VkFormat::eBC5Unorm: {
+		return bc::Format::eBC5;
+	}
+	case VkFormat::eBC7Unorm:
+	case VkFormat::eBC7Srgb: {
+		return bc::Format::eBC7;
+	}
+	default: {
+		return std::nullopt;
+	}
+	}
+}
+
+bool ktx2::isSRGB(VkFormat format) noexcept {
+	return format == VkFormat::eR8G8B8A8Srgb || format == VkFormat::eBC1RGBASrgb || format == VkFormat::eBC3Srgb || format == VkFormat::eBC7Srgb;
+}
+} // namespace le::io
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <utility>
+#include <core/load_trace.hpp>
+#include <fmt/format.h>
+
+namespace le {
+namespace {
+void escape(std::string& out_str, std::string_view text) {
+	for (char const c : text) {
+		switch (c) {
+		case '"':
+			out_str += "\\\"";
+			break;
+		case '\\':
+			out_str += "\\\\";
+			break;
+		case '\n':
+			out_str += "\\n";
+			break;
+		case '\t':
+			out_str += "\\t";
+			break;
+		default:
+			if ((unsigned char)c < 0x20) {
+				out_str += fmt::format("\\u{:04x}", (u32)(unsigned char)c);
+			} else {
+				out_str += c;
+			}
+			break;
+		}
+	}
+}
+} // namespace
+
+LoadTrace::Scope::Scope(LoadTrace& out_trace, std::string_view type, std::string_view id, Phase phase) {
+	if (out_trace.enabled()) {
+		m_pTrace = &out_trace;
+		m_event.type = type;
+		m_event.id = id;
+		m_event.phase = phase;
+		m_event.thread = thisThread();
+		m_event.begin = Time::elapsed();
+	}
+}
+
+LoadTrace::Scope::Scope(Scope&& rhs) noexcept : m_pTrace(std::exchange(rhs.m_pTrace, nullptr)), m_event(std::move(rhs.m_event)) {
+}
+
+LoadTrace::Scope& LoadTrace::Scope::operator=(Scope&& rhs) noexcept {
+	if (&rhs != this) {
+		if (m_pTrace) {
+			m_event.end = Time::elapsed();
+			m_pTrace->record(std::move(m_event));
+		}
+		m_pTrace = std::exchange(rhs.m_pTrace, nullptr);
+		m_event = std::move(rhs.m_event);
+	}
+	return *this;
+}
+
+LoadTrace::Scope::~Scope() {
+	if (m_pTrace) {
+		m_event.end = Time::elapsed();
+		m_pTrace->record(std::move(m_event));
+	}
+}
+
+u32 LoadTrace::thisThread() noexcept {
+	static std::atomic<u32> s_next = 1;
+	thread_local u32 const s_this = s_next++;
+	return s_this;
+}
+
+void LoadTrace::enable(bool bEnable, std::size_t capacity) {
+	std::scoped_lock lock(m_mutex);
+	m_capacity = capacity;
+	m_bEnabled = bEnable;
+}
+
+bool LoadTrace::enabled() const noexcept {
+	return m_bEnabled;
+}
+
+bool LoadTrace::full() const {
+	std::scoped_lock lock(m_mutex);
+	return m_bFull;
+}
+
+void LoadTrace::record(std::string_view type, std::string_view id, Phase phase, Time begin, Time end) {
+	if (enabled()) {
+		record(Event{std::string(type), std::string(id), begin, end, thisThread(), phase});
+	}
+}
+
+void LoadTrace::record(Event event) {
+	if (enabled()) {
+		std::scoped_lock lock(m_mutex);
+		if (m_events.size() >= m_capacity) {
+			m_bFull = true;
+			m_bEnabled = false;
+			return;
+		}
+		m_events.push_back(std::move(event));
+	}
+}
+
+LoadTrace::Scope LoadTrace::scope(std::string_view type, std::string_view id, Phase phase) {
+	return Scope(*this, type, id, phase);
+}
+
+std::vector<LoadTrace::Event> LoadTrace::events() const {
+	std::scoped_lock lock(m_mutex);
+	return m_events;
+}
+
+void LoadTrace::clear() {
+	std::scoped_lock lock(m_mutex);
+	m_events.clear();
+	m_bFull = false;
+}
+
+std::string LoadTrace::chromeTrace() const {
+	auto const events = this->events();
+	std::string ret = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool bFirst = true;
+	for (auto const& event : events) {
+		ret += bFirst ? "\n" : ",\n";
+		bFirst = false;
+		// complete event ("X"): one slice per phase, grouped by resource type
+		ret += "{\"name\":\"";
+		escape(ret, event.id);
+		ret += "\",\"cat\":\"";
+		escape(ret, event.type);
+		ret += fmt::format("\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":1,\"tid\":{},\"args\":{{\"phase\":\"{}\"}}}}", event.begin.to_us(),
+						   std::max(event.end - event.begin, Time()).to_us(), event.thread, phaseNames[(std::size_t)event.phase]);
+	}
+	ret += "\n]}\n";
+	return ret;
+}
+
+bool LoadTrace::writeChromeTrace(std::filesystem::path const& path) const {
+	std::ofstream file(path, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	auto const json = chromeTrace();
+	file.write(json.data(), (std::streamsize)json.size());
+	return file.good();
+}
+
+std::vector<LoadTrace::Row> LoadTrace::table() const {
+	auto const events = this->events();
+	std::map<std::pair<std::string_view, Phase>, Row> rows;
+	for (auto const& event : events) {
+		auto& row = rows[{event.type, event.phase}];
+		Time const duration = std::max(event.end - event.begin, Time());
+		row.type = event.type;
+		row.phase = event.phase;
+		++row.count;
+		row.total += duration;
+		row.max = std::max(row.max, duration);
+	}
+	std::vector<Row> ret;
+	ret.reserve(rows.size());
+	for (auto& [_, row] : rows) {
+		ret.push_back(std::move(row));
+	}
+	return ret;
+}
+
+std::string LoadTrace::summary() const {
+	auto const rows = table();
+	std::size_t width = 4;
+	for (auto const& row : rows) {
+		width = std::max(width, row.type.size());
+	}
+	std::string ret = fmt::format("{:<{}}  {:<8}  {:>6}  {:>10}  {:>10}  {:>10}\n", "type", width, "phase", "count", "total ms", "mean ms", "max ms");
+	for (auto const& row : rows) {
+		f32 const total = row.total.to_s() * 1000.0f;
+		ret += fmt::format("{:<{}}  {:<8}  {:>6}  {:>10.2f}  {:>10.2f}  {:>10.2f}\n", row.type, width, phaseNames[(std::size_t)row.phase], row.count, total,
+						   total / (f32)row.count, row.max.to_s() * 1000.0f);
+	}
+	if (full()) {
+		ret += "(capacity reached: later events were not recorded)\n";
+	}
+	return ret;
+}
+} // namespace le
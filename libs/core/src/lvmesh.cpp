@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <cstring>
+#include <core/byte_stream.hpp>
+#include <core/log.hpp>
+#include <core/lvmesh.hpp>
+
+namespace le::io {
+namespace {
+constexpr std::string_view g_tName = "lvmesh";
+// Serialised size of identifier + Header (no padding)
+constexpr u64 g_headerSize = sizeof(lvmesh::identifier) + 2 * sizeof(u32) + sizeof(u64) + 6 * sizeof(f32);
+
+struct Blobs final {
+	u64 vertexOffset = 0;
+	u64 vertexSize = 0;
+	u64 indexOffset = 0;
+	u64 indexCount = 0;
+};
+
+constexpr u64 aligned(u64 offset) noexcept {
+	return (offset + lvmesh::alignment - 1) / lvmesh::alignment * lvmesh::alignment;
+}
+
+ByteWriter& writeBounds(ByteWriter& out_writer, lvmesh::Bounds const& bounds) {
+	return out_writer.write(bounds.min.x).write(bounds.min.y).write(bounds.min.z).write(bounds.max.x).write(bounds.max.y).write(bounds.max.z);
+}
+
+ByteReader& readBounds(ByteReader& out_reader, lvmesh::Bounds& out_bounds) {
+	auto& [min, max] = out_bounds;
+	return out_reader.read(min.x).read(min.y).read(min.z).read(max.x).read(max.y).read(max.z);
+}
+
+void extend(lvmesh::Bounds& out_bounds, lvmesh::Bounds const& bounds) noexcept {
+	out_bounds.min = glm::min(out_bounds.min, bounds.min);
+	out_bounds.max = glm::max(out_bounds.max, bounds.max);
+}
+
+bytearray table(lvmesh::Model const& model, std::vector<lvmesh::Bounds> const& bounds, std::vector<Blobs> const& blobs) {
+	ByteWriter writer;
+	writer.write((u64)model.textures.size());
+	for (auto const& texture : model.textures) {
+		writer.write(texture.id).write(texture.filename);
+	}
+	writer.write((u64)model.materials.size());
+	for (auto const& mat : model.materials) {
+		writer.write(mat.id).write(mat.diffuseIndices).write(mat.specularIndices).write(mat.bumpIndices);
+		writer.write(mat.ambient).write(mat.diffuse).write(mat.specular).write(mat.shininess).write(mat.flags);
+	}
+	writer.write((u64)model.meshes.size());
+	for (std::size_t idx = 0; idx < model.meshes.size(); ++idx) {
+		auto const& mesh = model.meshes[idx];
+		writer.write(mesh.id).write(mesh.materialIndices).write(mesh.shininess);
+		writeBounds(writer, bounds[idx]);
+		writer.write(blobs[idx].vertexOffset).write(blobs[idx].vertexSize).write(blobs[idx].indexOffset).write(blobs[idx].indexCount);
+	}
+	return writer.release();
+}
+
+bool inRange(std::vector<u32> const& indices, std::size_t count) noexcept {
+	return std::all_of(indices.begin(), indices.end(), [count](u32 idx) { return (std::size_t)idx < count; });
+}
+} // namespace
+
+std::size_t lvmesh::Model::vertexCount(Mesh const& mesh) const noexcept {
+	return vertexStride > 0 ? mesh.vertices.extent / vertexStride : 0;
+}
+
+bool lvmesh::identify(Span<std::byte> bytes) noexcept {
+	return bytes.extent >= sizeof(identifier) && std::memcmp(bytes.pData, identifier, sizeof(identifier)) == 0;
+}
+
+std::optional<lvmesh::Model> lvmesh::parse(Span<std::byte> bytes) {
+	if (!identify(bytes)) {
+		logW("[{}] Invalid identifier", g_tName);
+		return std::nullopt;
+	}
+	if (reinterpret_cast<std::uintptr_t>(bytes.pData) % alignment != 0) {
+		logW("[{}] Misaligned data", g_tName);
+		return std::nullopt;
+	}
+	ByteReader reader(Span<std::byte>(bytes.pData + sizeof(identifier), bytes.extent - sizeof(identifier)));
+	Header header;
+	reader.read(header.version).read(header.vertexStride).read(header.tableSize);
+	readBounds(reader, header.bounds);
+	if (!reader || header.version != version || header.vertexStride < sizeof(glm::vec3) || header.tableSize > bytes.extent - g_headerSize) {
+		logW("[{}] Invalid / unsupported header (version [{}])", g_tName, header.version);
+		return std::nullopt;
+	}
+	Model ret;
+	ret.vertexStride = header.vertexStride;
+	ret.bounds = header.bounds;
+	reader = ByteReader(Span<std::byte>(bytes.pData + g_headerSize, (std::size_t)header.tableSize));
+	u64 count = 0;
+	reader.read(count);
+	for (u64 idx = 0; reader && idx < count; ++idx) {
+		Texture texture;
+		reader.read(texture.id).read(texture.filename);
+		ret.textures.push_back(std::move(texture));
+	}
+	reader.read(count);
+	for (u64 idx = 0; reader && idx < count; ++idx) {
+		Material mat;
+		reader.read(mat.id).read(mat.diffuseIndices).read(mat.specularIndices).read(mat.bumpIndices);
+		reader.read(mat.ambient).read(mat.diffuse).read(mat.specular).read(mat.shininess).read(mat.flags);
+		if (!inRange(mat.diffuseIndices, ret.textures.size()) || !inRange(mat.specularIndices, ret.textures.size()) ||
+			!inRange(mat.bumpIndices, ret.textures.size())) {
+			logW("[{}] Invalid texture index in material [{}]", g_tName, mat.id);
+			return std::nullopt;
+		}
+		ret.materials.push_back(std::move(mat));
+	}
+	reader.read(count);
+	for (u64 idx = 0; reader && idx < count; ++idx) {
+		Mesh mesh;
+		Blobs blobs;
+		reader.read(mesh.id).read(mesh.materialIndices).read(mesh.shininess);
+		readBounds(reader, mesh.bounds);
+		reader.read(blobs.vertexOffset).read(blobs.vertexSize).read(blobs.indexOffset).read(blobs.indexCount);
+		if (!reader) {
+			break;
+		}
+		u64 const indexSize = blobs.indexCount * sizeof(u32);
+		bool const bVertices = blobs.vertexOffset % alignment == 0 && blobs.vertexSize % ret.vertexStride == 0 && blobs.vertexOffset <= bytes.extent &&
+							   blobs.vertexSize <= bytes.extent - blobs.vertexOffset;
+		bool const bIndices = blobs.indexOffset % alignment == 0 && blobs.indexCount <= bytes.extent / sizeof(u32) && blobs.indexOffset <= bytes.extent &&
+							  indexSize <= bytes.extent - blobs.indexOffset;
+		if (!bVertices || !bIndices || !inRange(mesh.materialIndices, ret.materials.size())) {
+			logW("[{}] Invalid mesh [{}]", g_tName, mesh.id);
+			return std::nullopt;
+		}
+		mesh.vertices = Span<std::byte>(bytes.pData + blobs.vertexOffset, (std::size_t)blobs.vertexSize);
+		mesh.indices = Span<u32>(reinterpret_cast<u32 const*>(bytes.pData + blobs.indexOffset), (std::size_t)blobs.indexCount);
+		if (!std::all_of(mesh.indices.begin(), mesh.indices.end(), [count = ret.vertexCount(mesh)](u32 index) { return (std::size_t)index < count; })) {
+			logW("[{}] Out of range index in mesh [{}]", g_tName, mesh.id);
+			return std::nullopt;
+		}
+		ret.meshes.push_back(std::move(mesh));
+	}
+	if (!reader || !reader.eof()) {
+		logW("[{}] Invalid table", g_tName);
+		return std::nullopt;
+	}
+	return ret;
+}
+
+bytearray lvmesh::write(Model const& model) {
+	if (model.vertexStride < sizeof(glm::vec3) || model.meshes.empty()) {
+		logE("[{}] Invalid model", g_tName);
+		return {};
+	}
+	std::vector<Bounds> meshBounds;
+	meshBounds.reserve(model.meshes.size());
+	Bounds total;
+	bool bEmpty = true;
+	for (auto const& mesh : model.meshes) {
+		if (mesh.vertices.extent % model.vertexStride != 0 || !inRange(mesh.materialIndices, model.materials.size())) {
+			logE("[{}] Invalid mesh [{}]", g_tName, mesh.id);
+			return {};
+		}
+		meshBounds.push_back(bounds(mesh.vertices, model.vertexStride));
+		if (mesh.vertices.extent > 0) {
+			if (bEmpty) {
+				total = meshBounds.back();
+				bEmpty = false;
+			} else {
+				extend(total, meshBounds.back());
+			}
+		}
+	}
+	// first pass: table size (blob offsets are fixed width)
+	std::vector<Blobs> blobs(model.meshes.size());
+	u64 offset = aligned(g_headerSize + (u64)table(model, meshBounds, blobs).size());
+	for (std::size_t idx = 0; idx < model.meshes.size(); ++idx) {
+		auto const& mesh = model.meshes[idx];
+		blobs[idx].vertexOffset = offset;
+		blobs[idx].vertexSize = (u64)mesh.vertices.extent;
+		offset = aligned(offset + blobs[idx].vertexSize);
+		blobs[idx].indexOffset = offset;
+		blobs[idx].indexCount = (u64)mesh.indices.extent;
+		offset = aligned(offset + blobs[idx].indexCount * sizeof(u32));
+	}
+	bytearray const tableBytes = table(model, meshBounds, blobs);
+	Header header;
+	header.vertexStride = model.vertexStride;
+	header.tableSize = (u64)tableBytes.size();
+	header.bounds = total;
+	ByteWriter writer;
+	writer.write(identifier);
+	writer.write(header.version).write(header.vertexStride).write(header.tableSize);
+	writeBounds(writer, header.bounds);
+	bytearray ret = writer.release();
+	ret.insert(ret.end(), tableBytes.begin(), tableBytes.end());
+	ret.reserve((std::size_t)offset);
+	for (std::size_t idx = 0; idx < model.meshes.size(); ++idx) {
+		auto const& mesh = model.meshes[idx];
+		ret.resize((std::size_t)blobs[idx].vertexOffset);
+		ret.insert(ret.end(), mesh.vertices.begin(), mesh.vertices.end());
+		ret.resize((std::size_t)blobs[idx].indexOffset);
+		auto const pIndices = reinterpret_cast<std::byte const*>(mesh.indices.pData);
+		ret.insert(ret.end(), pIndices, pIndices + mesh.indices.extent * sizeof(u32));
+	}
+	ret.resize((std::size_t)offset);
+	return ret;
+}
+
+lvmesh::Bounds lvmesh::bounds(Span<std::byte> vertices, u32 stride) noexcept {
+	Bounds ret;
+	if (stride < sizeof(glm::vec3) || vertices.extent < stride) {
+		return ret;
+	}
+	std::memcpy(&ret.min, vertices.pData, sizeof(glm::vec3));
+	ret.max = ret.min;
+	for (std::size_t offset = stride; offset + stride <= vertices.extent; offset += stride) {
+		glm::vec3 position;
+		std::memcpy(&position, vertices.pData + offset, sizeof(glm::vec3));
+		ret.min = glm::min(ret.min, position);
+		ret.max = glm::max(ret.max, position);
+	}
+	return ret;
+}
+} // namespace le::io
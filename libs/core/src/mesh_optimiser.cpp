@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <core/mesh_optimiser.hpp>
+#include <glm/glm.hpp>
+
+namespace le::meshopt {
+namespace {
+constexpr u32 g_null = ~0U;
+
+bool valid(Span<u32> indices, u32 vertexCount) noexcept {
+	return indices.extent % 3 == 0 && std::all_of(indices.begin(), indices.end(), [vertexCount](u32 idx) { return idx < vertexCount; });
+}
+
+glm::vec3 position(Span<std::byte> vertices, u32 stride, u32 index) noexcept {
+	glm::vec3 ret;
+	std::memcpy(&ret, vertices.pData + (std::size_t)index * stride, sizeof(glm::vec3));
+	return ret;
+}
+
+///
+/// \brief Vertex => triangle adjacency (CSR)
+///
+struct Adjacency final {
+	std::vector<u32> offsets;
+	std::vector<u32> triangles;
+	std::vector<u32> live;
+
+	Adjacency(Span<u32> indices, u32 vertexCount) : offsets((std::size_t)vertexCount + 1, 0), triangles(indices.extent), live(vertexCount, 0) {
+		for (u32 const idx : indices) {
+			++live[idx];
+		}
+		for (u32 v = 0; v < vertexCount; ++v) {
+			offsets[v + 1] = offsets[v] + live[v];
+		}
+		std::vector<u32> fill(offsets.begin(), offsets.end() - 1);
+		for (std::size_t idx = 0; idx < indices.extent; ++idx) {
+			u32 const v = indices.pData[idx];
+			triangles[fill[v]++] = (u32)(idx / 3);
+		}
+	}
+};
+
+struct Tipsify final {
+	Adjacency adj;
+	std::vector<u32> stamps;
+	std::vector<u32> deadEnds;
+	std::vector<bool> emitted;
+	u32 vertexCount = 0;
+	u32 cursor = 0;
+
+	Tipsify(Span<u32> indices, u32 vertexCount)
+		: adj(indices, vertexCount), stamps(vertexCount, 0), emitted(indices.extent / 3, false), vertexCount(vertexCount) {
+	}
+
+	u32 skipDeadEnd() {
+		while (!deadEnds.empty()) {
+			u32 const d = deadEnds.back();
+			deadEnds.pop_back();
+			if (adj.live[d] > 0) {
+				return d;
+			}
+		}
+		for (; cursor < vertexCount; ++cursor) {
+			if (adj.live[cursor] > 0) {
+				return cursor;
+			}
+		}
+		return g_null;
+	}
+
+	u32 nextVertex(std::vector<u32> const& candidates, u32 time, u32 cacheSize) const {
+		u32 ret = g_null;
+		s64 best = -1;
+		for (u32 const v : candidates) {
+			if (adj.live[v] > 0) {
+				// prefer vertices that will still be in the cache after emitting their remaining triangles
+				s64 priority = 0;
+				if ((s64)time - (s64)stamps[v] + 2 * (s64)adj.live[v] <= (s64)cacheSize) {
+					priority = (s64)time - (s64)stamps[v];
+				}
+				if (priority > best) {
+					best = priority;
+					ret = v;
+				}
+			}
+		}
+		return ret;
+	}
+};
+
+struct Cluster final {
+	u32 begin = 0;
+	u32 end = 0;
+	f32 sort = 0.0f;
+};
+} // namespace
+
+f32 acmr(Span<u32> indices, u32 vertexCount, u32 cacheSize) {
+	if (indices.extent < 3 || cacheSize == 0) {
+		return 0.0f;
+	}
+	std::vector<u32> stamps(vertexCount, 0);
+	// stamps of zero are always misses
+	u32 time = cacheSize + 1;
+	u32 misses = 0;
+	for (u32 const idx : indices) {
+		if (idx < vertexCount && time - stamps[idx] > cacheSize) {
+			stamps[idx] = time++;
+			++misses;
+		}
+	}
+	return (f32)misses / (f32)(indices.extent / 3);
+}
+
+std::vector<u32> optimiseVertexCache(Span<u32> indices, u32 vertexCount, u32 cacheSize, std::vector<u32>* out_clusters) {
+	if (out_clusters) {
+		out_clusters->assign(indices.extent >= 3 ? 1 : 0, 0);
+	}
+	if (indices.extent < 3 || cacheSize == 0 || !valid(indices, vertexCount)) {
+		return std::vector<u32>(indices.begin(), indices.end());
+	}
+	std::vector<u32> ret;
+	ret.reserve(indices.extent);
+	Tipsify tipsify(indices, vertexCount);
+	std::vector<u32> candidates;
+	u32 time = cacheSize + 1;
+	u32 fan = tipsify.skipDeadEnd();
+	while (fan != g_null) {
+		candidates.clear();
+		for (u32 adj = tipsify.adj.offsets[fan]; adj < tipsify.adj.offsets[fan + 1]; ++adj) {
+			u32 const tri = tipsify.adj.triangles[adj];
+			if (tipsify.emitted[tri]) {
+				continue;
+			}
+			for (u32 corner = 0; corner < 3; ++corner) {
+				u32 const v = indices.pData[tri * 3 + corner];
+				ret.push_back(v);
+				tipsify.deadEnds.push_back(v);
+				candidates.push_back(v);
+				--tipsify.adj.live[v];
+				if (time - tipsify.stamps[v] > cacheSize) {
+					tipsify.stamps[v] = time++;
+				}
+			}
+			tipsify.emitted[tri] = true;
+		}
+		fan = tipsify.nextVertex(candidates, time, cacheSize);
+		if (fan == g_null) {
+			// dead end: start a new cluster
+			fan = tipsify.skipDeadEnd();
+			u32 const tri = (u32)(ret.size() / 3);
+			if (out_clusters && fan != g_null && tri > out_clusters->back()) {
+				out_clusters->push_back(tri);
+			}
+		}
+	}
+	return ret;
+}
+
+std::vector<u32> optimiseOverdraw(Span<u32> indices, Span<std::byte> vertices, u32 stride, Span<u32> clusters, f32 threshold, u32 cacheSize) {
+	std::vector<u32> ret(indices.begin(), indices.end());
+	u32 const vertexCount = stride >= sizeof(glm::vec3) ? (u32)(vertices.extent / stride) : 0;
+	u32 const triCount = (u32)(indices.extent / 3);
+	if (clusters.extent < 2 || !valid(indices, vertexCount)) {
+		return ret;
+	}
+	std::vector<Cluster> sorted;
+	sorted.reserve(clusters.extent);
+	for (std::size_t idx = 0; idx < clusters.extent; ++idx) {
+		u32 const end = idx + 1 < clusters.extent ? clusters.pData[idx + 1] : triCount;
+		if (clusters.pData[idx] < end && end <= triCount) {
+			sorted.push_back({clusters.pData[idx], end, 0.0f});
+		}
+	}
+	// area weighted centroid and normal of each cluster
+	std::vector<std::pair<glm::vec3, glm::vec3>> centroidNormals(sorted.size());
+	glm::vec3 meshCentroid(0.0f);
+	f32 meshArea = 0.0f;
+	for (std::size_t idx = 0; idx < sorted.size(); ++idx) {
+		glm::vec3 centroid(0.0f);
+		glm::vec3 normal(0.0f);
+		f32 area = 0.0f;
+		for (u32 tri = sorted[idx].begin; tri < sorted[idx].end; ++tri) {
+			auto const p0 = position(vertices, stride, indices.pData[tri * 3 + 0]);
+			auto const p1 = position(vertices, stride, indices.pData[tri * 3 + 1]);
+			auto const p2 = position(vertices, stride, indices.pData[tri * 3 + 2]);
+			auto const cross = glm::cross(p1 - p0, p2 - p0);
+			f32 const a = std::sqrt(glm::dot(cross, cross)) * 0.5f;
+			centroid = centroid + (p0 + p1 + p2) * (a / 3.0f);
+			normal = normal + cross;
+			area += a;
+		}
+		meshCentroid = meshCentroid + centroid;
+		meshArea += area;
+		centroidNormals[idx] = {area > 0.0f ? centroid * (1.0f / area) : centroid, normal};
+	}
+	if (meshArea > 0.0f) {
+		meshCentroid = meshCentroid * (1.0f / meshArea);
+	}
+	for (std::size_t idx = 0; idx < sorted.size(); ++idx) {
+		auto const& [centroid, normal] = centroidNormals[idx];
+		f32 const length = std::sqrt(glm::dot(normal, normal));
+		sorted[idx].sort = length > 0.0f ? glm::dot(centroid - meshCentroid, normal) / length : 0.0f;
+	}
+	// outward facing clusters far from the centre occlude the rest: draw them first
+	std::stable_sort(sorted.begin(), sorted.end(), [](Cluster const& lhs, Cluster const& rhs) { return lhs.sort > rhs.sort; });
+	std::vector<u32> reordered;
+	reordered.reserve(indices.extent);
+	for (auto const& cluster : sorted) {
+		reordered.insert(reordered.end(), indices.pData + cluster.begin * 3, indices.pData + cluster.end * 3);
+	}
+	if (reordered.size() != indices.extent || acmr(reordered, vertexCount, cacheSize) > acmr(indices, vertexCount, cacheSize) * threshold) {
+		return ret;
+	}
+	return reordered;
+}
+
+std::vector<u32> fetchRemap(Span<u32> indices, u32 vertexCount) {
+	std::vector<u32> ret(vertexCount, g_null);
+	u32 next = 0;
+	for (u32 const idx : indices) {
+		if (idx < vertexCount && ret[idx] == g_null) {
+			ret[idx] = next++;
+		}
+	}
+	return ret;
+}
+
+u32 remap(std::vector<u32>& out_indices, std::byte* pVertices, u32 vertexCount, u32 stride, Span<u32> table) {
+	if (table.extent != vertexCount) {
+		return vertexCount;
+	}
+	u32 ret = 0;
+	std::vector<std::byte> const source(pVertices, pVertices + (std::size_t)vertexCount * stride);
+	for (u32 v = 0; v < vertexCount; ++v) {
+		if (u32 const to = table.pData[v]; to != g_null) {
+			std::memcpy(pVertices + (std::size_t)to * stride, source.data() + (std::size_t)v * stride, stride);
+			ret = std::max(ret, to + 1);
+		}
+	}
+	for (u32& idx : out_indices) {
+		idx = table.pData[idx];
+	}
+	return ret;
+}
+
+Stats optimise(std::vector<u32>& out_indices, std::byte* pVertices, u32 vertexCount, u32 stride, Options const& options) {
+	Stats ret;
+	ret.vertexCount = vertexCount;
+	if (!valid(out_indices, vertexCount) || out_indices.size() < 3 || stride < sizeof(glm::vec3)) {
+		return ret;
+	}
+	ret.acmrBefore = acmr(out_indices, vertexCount, options.cacheSize);
+	std::vector<u32> clusters;
+	auto indices = optimiseVertexCache(out_indices, vertexCount, options.cacheSize, &clusters);
+	if (options.bOverdraw) {
+		Span<std::byte> const vertices(pVertices, (std::size_t)vertexCount * stride);
+		indices = optimiseOverdraw(indices, vertices, stride, clusters, options.overdrawThreshold, options.cacheSize);
+	}
+	// keep the source order if already better (eg generated strips)
+	if (acmr(indices, vertexCount, options.cacheSize) <= ret.acmrBefore) {
+		out_indices = std::move(indices);
+	}
+	auto const table = fetchRemap(out_indices, vertexCount);
+	ret.vertexCount = remap(out_indices, pVertices, vertexCount, stride, table);
+	ret.acmrAfter = acmr(out_indices, ret.vertexCount, options.cacheSize);
+	return ret;
+}
+} // namespace le::meshopt
@@ -0,0 +1,386 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <core/mesh_simplifier.hpp>
+#include <glm/glm.hpp>
+
+namespace le::meshopt {
+namespace {
+constexpr u32 g_null = ~0U;
+// border planes dominate interior planes so that silhouettes of open meshes are preserved
+constexpr f64 g_borderWeight = 10.0;
+// levels that keep more than this fraction of the previous level are not worth drawing
+constexpr f32 g_minReduction = 0.9f;
+
+bool valid(Span<u32> indices, u32 vertexCount) noexcept {
+	return indices.extent % 3 == 0 && std::all_of(indices.begin(), indices.end(), [vertexCount](u32 idx) { return idx < vertexCount; });
+}
+
+///
+/// \brief Symmetric 4x4 quadric (Garland, Heckbert), with accumulated weight (area) for normalisation
+///
+struct Quadric final {
+	f64 a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+	f64 b0 = 0.0, b1 = 0.0, b2 = 0.0;
+	f64 c = 0.0;
+	f64 w = 0.0;
+
+	// plane: dot(n, p) + d = 0, n normalised
+	static Quadric plane(glm::vec3 const& n, f32 d, f64 weight) noexcept {
+		Quadric ret;
+		f64 const x = n.x, y = n.y, z = n.z, dd = d;
+		ret.a00 = weight * x * x;
+		ret.a01 = weight * x * y;
+		ret.a02 = weight * x * z;
+		ret.a11 = weight * y * y;
+		ret.a12 = weight * y * z;
+		ret.a22 = weight * z * z;
+		ret.b0 = weight * x * dd;
+		ret.b1 = weight * y * dd;
+		ret.b2 = weight * z * dd;
+		ret.c = weight * dd * dd;
+		ret.w = weight;
+		return ret;
+	}
+
+	Quadric& operator+=(Quadric const& rhs) noexcept {
+		a00 += rhs.a00;
+		a01 += rhs.a01;
+		a02 += rhs.a02;
+		a11 += rhs.a11;
+		a12 += rhs.a12;
+		a22 += rhs.a22;
+		b0 += rhs.b0;
+		b1 += rhs.b1;
+		b2 += rhs.b2;
+		c += rhs.c;
+		w += rhs.w;
+		return *this;
+	}
+
+	// weighted mean squared distance of `p` to the accumulated planes
+	f64 error(glm::vec3 const& p) const noexcept {
+		f64 const x = p.x, y = p.y, z = p.z;
+		f64 const r = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+		return w > 0.0 ? std::abs(r) / w : 0.0;
+	}
+};
+
+Quadric operator+(Quadric lhs, Quadric const& rhs) noexcept {
+	return lhs += rhs;
+}
+
+u64 edgeKey(u32 a, u32 b) noexcept {
+	return ((u64)std::min(a, b) << 32) | (u64)std::max(a, b);
+}
+
+///
+/// \brief Vertices grouped by (exact) position: collapses operate on classes so that attribute seams stay closed
+///
+struct Classes final {
+	std::vector<glm::vec3> positions;
+	std::vector<u32> classOf;
+
+	Classes(Span<std::byte> vertices, u32 stride, u32 vertexCount) : classOf(vertexCount, g_null) {
+		std::vector<glm::vec3> source(vertexCount);
+		for (u32 v = 0; v < vertexCount; ++v) {
+			std::memcpy(&source[v], vertices.pData + (std::size_t)v * stride, sizeof(glm::vec3));
+		}
+		std::vector<u32> order(vertexCount);
+		for (u32 v = 0; v < vertexCount; ++v) {
+			order[v] = v;
+		}
+		auto const less = [&source](u32 lhs, u32 rhs) {
+			auto const& l = source[lhs];
+			auto const& r = source[rhs];
+			return l.x != r.x ? l.x < r.x : l.y != r.y ? l.y < r.y : l.z < r.z;
+		};
+		std::sort(order.begin(), order.end(), less);
+		for (std::size_t idx = 0; idx < order.size(); ++idx) {
+			if (idx == 0 || less(order[idx - 1], order[idx])) {
+				positions.push_back(source[order[idx]]);
+			}
+			classOf[order[idx]] = (u32)positions.size() - 1;
+		}
+	}
+
+	u32 operator[](u32 vertex) const noexcept {
+		return classOf[vertex];
+	}
+
+	bool degenerate(u32 const* pTri) const noexcept {
+		u32 const c0 = classOf[pTri[0]], c1 = classOf[pTri[1]], c2 = classOf[pTri[2]];
+		return c0 == c1 || c1 == c2 || c2 == c0;
+	}
+};
+
+///
+/// \brief Class => triangle adjacency (CSR) over the current indices
+///
+struct Adjacency final {
+	std::vector<u32> offsets;
+	std::vector<u32> triangles;
+
+	Adjacency(std::vector<u32> const& indices, Classes const& classes) : offsets(classes.positions.size() + 1, 0), triangles(indices.size()) {
+		for (u32 const idx : indices) {
+			++offsets[classes[idx] + 1];
+		}
+		for (std::size_t c = 1; c < offsets.size(); ++c) {
+			offsets[c] += offsets[c - 1];
+		}
+		std::vector<u32> fill(offsets.begin(), offsets.end() - 1);
+		for (std::size_t idx = 0; idx < indices.size(); ++idx) {
+			triangles[fill[classes[indices[idx]]]++] = (u32)(idx / 3);
+		}
+	}
+};
+
+struct Collapse final {
+	u32 from = g_null;
+	u32 to = g_null;
+	f64 cost = std::numeric_limits<f64>::max();
+};
+
+glm::vec3 normal(glm::vec3 const& p0, glm::vec3 const& p1, glm::vec3 const& p2) noexcept {
+	return glm::cross(p1 - p0, p2 - p0);
+}
+
+void removeDegenerate(std::vector<u32>& out_indices, Classes const& classes) {
+	std::size_t write = 0;
+	for (std::size_t read = 0; read < out_indices.size(); read += 3) {
+		if (!classes.degenerate(out_indices.data() + read)) {
+			std::copy(out_indices.begin() + (std::ptrdiff_t)read, out_indices.begin() + (std::ptrdiff_t)read + 3, out_indices.begin() + (std::ptrdiff_t)write);
+			write += 3;
+		}
+	}
+	out_indices.resize(write);
+}
+} // namespace
+
+std::vector<u32> simplify(Span<u32> indices, Span<std::byte> vertices, u32 stride, std::size_t targetIndexCount, f32 maxError, f32* out_error) {
+	std::vector<u32> ret(indices.begin(), indices.end());
+	if (out_error) {
+		*out_error = 0.0f;
+	}
+	u32 const vertexCount = stride >= sizeof(glm::vec3) ? (u32)(vertices.extent / stride) : 0;
+	if (ret.size() <= targetIndexCount || !valid(indices, vertexCount)) {
+		return ret;
+	}
+	Classes const classes(vertices, stride, vertexCount);
+	auto const& pos = classes.positions;
+	removeDegenerate(ret, classes);
+	glm::vec3 lo(std::numeric_limits<f32>::max()), hi(std::numeric_limits<f32>::lowest());
+	for (u32 const idx : ret) {
+		lo = glm::min(lo, pos[classes[idx]]);
+		hi = glm::max(hi, pos[classes[idx]]);
+	}
+	f32 const extent = ret.empty() ? 0.0f : std::sqrt(glm::dot(hi - lo, hi - lo));
+	if (extent <= 0.0f) {
+		return ret;
+	}
+	// quadrics of incident triangle planes (area weighted), and of planes perpendicular to open edges
+	std::vector<Quadric> quadrics(pos.size());
+	std::vector<std::pair<u64, u32>> edges;
+	edges.reserve(ret.size());
+	for (std::size_t tri = 0; tri < ret.size(); tri += 3) {
+		u32 const c[] = {classes[ret[tri]], classes[ret[tri + 1]], classes[ret[tri + 2]]};
+		auto const n = normal(pos[c[0]], pos[c[1]], pos[c[2]]);
+		f32 const length = std::sqrt(glm::dot(n, n));
+		if (length > 0.0f) {
+			auto const unit = n * (1.0f / length);
+			auto const q = Quadric::plane(unit, -glm::dot(unit, pos[c[0]]), (f64)length * 0.5);
+			for (u32 const cls : c) {
+				quadrics[cls] += q;
+			}
+		}
+		for (u32 e = 0; e < 3; ++e) {
+			edges.push_back({edgeKey(c[e], c[(e + 1) % 3]), (u32)tri});
+		}
+	}
+	std::sort(edges.begin(), edges.end());
+	std::vector<u64> borders;
+	std::vector<bool> bBorder(pos.size(), false);
+	for (std::size_t idx = 0; idx < edges.size();) {
+		std::size_t end = idx + 1;
+		while (end < edges.size() && edges[end].first == edges[idx].first) {
+			++end;
+		}
+		if (end - idx == 1) {
+			u32 const a = (u32)(edges[idx].first >> 32), b = (u32)edges[idx].first;
+			u32 const tri = edges[idx].second;
+			auto const n = normal(pos[classes[ret[tri]]], pos[classes[ret[tri + 1]]], pos[classes[ret[tri + 2]]]);
+			auto const dir = pos[b] - pos[a];
+			auto const perp = glm::cross(dir, n);
+			f32 const length = std::sqrt(glm::dot(perp, perp));
+			if (length > 0.0f) {
+				auto const unit = perp * (1.0f / length);
+				auto const q = Quadric::plane(unit, -glm::dot(unit, pos[a]), (f64)glm::dot(dir, dir) * g_borderWeight);
+				quadrics[a] += q;
+				quadrics[b] += q;
+			}
+			borders.push_back(edges[idx].first);
+			bBorder[a] = bBorder[b] = true;
+		}
+		idx = end;
+	}
+	edges = {};
+	auto const bBorderEdge = [&borders](u32 a, u32 b) { return std::binary_search(borders.begin(), borders.end(), edgeKey(a, b)); };
+	f64 const maxCost = (f64)maxError * extent * (f64)maxError * extent;
+	f64 cost = 0.0;
+	std::vector<Collapse> best(pos.size());
+	std::vector<Collapse> candidates;
+	std::vector<bool> locked(pos.size());
+	std::vector<u32> remap(vertexCount);
+	std::vector<std::pair<u32, u32>> moves;
+	bool bDone = false;
+	while (!bDone && ret.size() > targetIndexCount) {
+		Adjacency const adj(ret, classes);
+		std::fill(best.begin(), best.end(), Collapse{});
+		for (std::size_t tri = 0; tri < ret.size(); tri += 3) {
+			for (u32 corner = 0; corner < 3; ++corner) {
+				u32 const from = classes[ret[tri + corner]];
+				for (u32 const other : {(corner + 1) % 3, (corner + 2) % 3}) {
+					u32 const to = classes[ret[tri + other]];
+					if (bBorder[from] && !bBorderEdge(from, to)) {
+						continue;
+					}
+					f64 const c = (quadrics[from] + quadrics[to]).error(pos[to]);
+					if (c < best[from].cost) {
+						best[from] = {from, to, c};
+					}
+				}
+			}
+		}
+		candidates.clear();
+		for (auto const& collapse : best) {
+			if (collapse.to != g_null && collapse.cost <= maxCost) {
+				candidates.push_back(collapse);
+			}
+		}
+		std::sort(candidates.begin(), candidates.end(), [](Collapse const& lhs, Collapse const& rhs) { return lhs.cost < rhs.cost; });
+		std::fill(locked.begin(), locked.end(), false);
+		for (u32 v = 0; v < vertexCount; ++v) {
+			remap[v] = v;
+		}
+		std::size_t remaining = ret.size();
+		u32 collapsed = 0;
+		for (auto const& [from, to, c] : candidates) {
+			if (remaining <= targetIndexCount) {
+				break;
+			}
+			if (locked[from] || locked[to]) {
+				continue;
+			}
+			// every vertex of `from` must move to a vertex of `to` it shares a triangle with (seams collapse along themselves)
+			moves.clear();
+			u32 removed = 0;
+			for (u32 a = adj.offsets[from]; a < adj.offsets[from + 1]; ++a) {
+				u32 const* pTri = ret.data() + (std::size_t)adj.triangles[a] * 3;
+				u32 v = g_null, w = g_null;
+				for (u32 corner = 0; corner < 3; ++corner) {
+					if (classes[pTri[corner]] == from) {
+						v = pTri[corner];
+					} else if (classes[pTri[corner]] == to) {
+						w = pTri[corner];
+					}
+				}
+				if (w != g_null) {
+					++removed;
+					if (std::none_of(moves.begin(), moves.end(), [v](auto const& move) { return move.first == v; })) {
+						moves.push_back({v, w});
+					}
+				}
+			}
+			bool bValid = removed > 0;
+			for (u32 a = adj.offsets[from]; bValid && a < adj.offsets[from + 1]; ++a) {
+				u32 const* pTri = ret.data() + (std::size_t)adj.triangles[a] * 3;
+				glm::vec3 p[3], q[3];
+				bool bTouches = false;
+				for (u32 corner = 0; corner < 3; ++corner) {
+					u32 const cls = classes[pTri[corner]];
+					bTouches |= cls == to;
+					p[corner] = q[corner] = pos[cls];
+					if (cls == from) {
+						q[corner] = pos[to];
+						bValid &= std::any_of(moves.begin(), moves.end(), [v = pTri[corner]](auto const& move) { return move.first == v; });
+					}
+				}
+				// surviving triangles must not flip
+				if (!bTouches) {
+					bValid &= glm::dot(normal(p[0], p[1], p[2]), normal(q[0], q[1], q[2])) > 0.0f;
+				}
+			}
+			if (!bValid) {
+				continue;
+			}
+			for (auto const& [v, w] : moves) {
+				remap[v] = w;
+			}
+			quadrics[to] += quadrics[from];
+			for (u32 a = adj.offsets[from]; a < adj.offsets[from + 1]; ++a) {
+				u32 const* pTri = ret.data() + (std::size_t)adj.triangles[a] * 3;
+				for (u32 corner = 0; corner < 3; ++corner) {
+					locked[classes[pTri[corner]]] = true;
+				}
+			}
+			remaining -= (std::size_t)removed * 3;
+			cost = std::max(cost, c);
+			++collapsed;
+		}
+		if (collapsed == 0) {
+			bDone = true;
+		}
+		for (u32& idx : ret) {
+			idx = remap[idx];
+		}
+		removeDegenerate(ret, classes);
+	}
+	if (out_error) {
+		*out_error = (f32)(std::sqrt(cost) / extent);
+	}
+	return ret;
+}
+
+std::vector<Lod> lods(Span<u32> indices, Span<std::byte> vertices, u32 stride, u32 count, f32 ratio, f32 maxError) {
+	std::vector<Lod> ret;
+	ret.push_back({std::vector<u32>(indices.begin(), indices.end()), 0.0f});
+	for (u32 level = 1; level < count; ++level) {
+		auto const& prev = ret.back();
+		f32 const budget = maxError - prev.error;
+		if (budget <= 0.0f) {
+			break;
+		}
+		std::size_t const target = (std::size_t)((f32)(prev.indices.size() / 3) * ratio) * 3;
+		f32 error = 0.0f;
+		auto next = simplify(prev.indices, vertices, stride, target, budget, &error);
+		if (next.empty() || (f32)next.size() > (f32)prev.indices.size() * g_minReduction) {
+			break;
+		}
+		// errors of chained levels are bounded by their sum
+		f32 const total = prev.error + error;
+		ret.push_back({std::move(next), total});
+	}
+	return ret;
+}
+
+f32 screenSize(f32 radius, f32 distance, f32 fov) noexcept {
+	f32 const t = std::tan(fov * 0.5f);
+	if (distance <= radius || t <= 0.0f) {
+		return std::numeric_limits<f32>::max();
+	}
+	return radius / (distance * t);
+}
+
+u32 selectLod(Span<f32> errors, f32 screenSize, f32 maxError) noexcept {
+	u32 ret = 0;
+	for (u32 level = 1; level < (u32)errors.extent; ++level) {
+		if (errors.pData[level] * screenSize > maxError) {
+			break;
+		}
+		ret = level;
+	}
+	return ret;
+}
+} // namespace le::meshopt
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <core/ensure.hpp>
+#include <core/mip_chain.hpp>
+#include <core/tasks.hpp>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LEVK_MIPS_SSE2
+#endif
+
+namespace le::mips {
+namespace {
+// Levels smaller than this are not worth distributing
+constexpr std::size_t g_minParallelTexels = 128 * 128;
+constexpr u32 g_minBandRows = 16;
+
+struct SRGB final {
+	std::array<f32, 256> toLinear;
+	// Linear values at the midpoints between consecutive sRGB codes: encoding rounds to nearest in sRGB space
+	std::array<f32, 255> thresholds;
+
+	SRGB() {
+		auto decode = [](f64 c) { return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4); };
+		for (std::size_t idx = 0; idx < toLinear.size(); ++idx) {
+			toLinear[idx] = (f32)decode((f64)idx / 255.0);
+		}
+		for (std::size_t idx = 0; idx < thresholds.size(); ++idx) {
+			thresholds[idx] = (f32)decode(((f64)idx + 0.5) / 255.0);
+		}
+	}
+
+	u8 encode(f32 linear) const noexcept {
+		return (u8)(std::upper_bound(thresholds.begin(), thresholds.end(), linear) - thresholds.begin());
+	}
+};
+
+SRGB const& srgb() {
+	static SRGB const s_srgb;
+	return s_srgb;
+}
+
+constexpr u8 average(u8 a, u8 b, u8 c, u8 d, u8 bias) noexcept {
+	// bias = 0x80 maps two's complement onto offset binary: rounding stays symmetric about zero
+	u32 const sum = (u32)(a ^ bias) + (u32)(b ^ bias) + (u32)(c ^ bias) + (u32)(d ^ bias);
+	return (u8)((sum + 2) >> 2) ^ bias;
+}
+
+#if defined(LEVK_MIPS_SSE2)
+// Averages 2x2 blocks of 8 source texels (2 rows of 4) into 2 destination texels (16-bit lanes)
+inline __m128i average2(u8 const* pRow0, u8 const* pRow1, __m128i bias) noexcept {
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const r0 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(pRow0)), bias);
+	__m128i const r1 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const*>(pRow1)), bias);
+	// [t0, t1] and [t2, t3]: vertical sums per texel
+	__m128i const lo = _mm_add_epi16(_mm_unpacklo_epi8(r0, zero), _mm_unpacklo_epi8(r1, zero));
+	__m128i const hi = _mm_add_epi16(_mm_unpackhi_epi8(r0, zero), _mm_unpackhi_epi8(r1, zero));
+	// [t0 + t1, t2 + t3]: horizontal sums
+	__m128i const sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+	return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+}
+#endif
+
+void downsampleRows(u8 const* pSrc, u32 width, u32 height, u8* pDst, Encoding encoding, u32 rowBegin, u32 rowEnd) {
+	u32 const dstWidth = std::max(width / 2, 1U);
+	std::size_t const srcStride = (std::size_t)width * 4;
+	std::size_t const dstStride = (std::size_t)dstWidth * 4;
+	u8 const bias = encoding == Encoding::eSNorm ? 0x80 : 0x00;
+	for (u32 y = rowBegin; y < rowEnd; ++y) {
+		u8 const* pRow0 = pSrc + (std::size_t)std::min(y * 2, height - 1) * srcStride;
+		u8 const* pRow1 = pSrc + (std::size_t)std::min(y * 2 + 1, height - 1) * srcStride;
+		u8* pOut = pDst + (std::size_t)y * dstStride;
+		u32 x = 0;
+		if (encoding == Encoding::eSRGB) {
+			SRGB const& table = srgb();
+			for (; x < dstWidth; ++x) {
+				std::size_t const x0 = (std::size_t)std::min(x * 2, width - 1) * 4;
+				std::size_t const x1 = (std::size_t)std::min(x * 2 + 1, width - 1) * 4;
+				for (std::size_t c = 0; c < 3; ++c) {
+					f32 const sum = table.toLinear[pRow0[x0 + c]] + table.toLinear[pRow0[x1 + c]] + table.toLinear[pRow1[x0 + c]] + table.toLinear[pRow1[x1 + c]];
+					pOut[x * 4 + c] = table.encode(sum * 0.25f);
+				}
+				pOut[x * 4 + 3] = average(pRow0[x0 + 3], pRow0[x1 + 3], pRow1[x0 + 3], pRow1[x1 + 3], 0);
+			}
+			continue;
+		}
+#if defined(LEVK_MIPS_SSE2)
+		// 4 destination texels per iteration while all 8 source columns are in range
+		__m128i const vBias = _mm_set1_epi8((char)bias);
+		for (; (x + 4) * 2 <= width; x += 4) {
+			u8 const* pIn0 = pRow0 + (std::size_t)x * 8;
+			u8 const* pIn1 = pRow1 + (std::size_t)x * 8;
+			__m128i const packed = _mm_packus_epi16(average2(pIn0, pIn1, vBias), average2(pIn0 + 16, pIn1 + 16, vBias));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pOut + (std::size_t)x * 4), _mm_xor_si128(packed, vBias));
+		}
+#endif
+		for (; x < dstWidth; ++x) {
+			std::size_t const x0 = (std::size_t)std::min(x * 2, width - 1) * 4;
+			std::size_t const x1 = (std::size_t)std::min(x * 2 + 1, width - 1) * 4;
+			for (std::size_t c = 0; c < 4; ++c) {
+				pOut[x * 4 + c] = average(pRow0[x0 + c], pRow0[x1 + c], pRow1[x0 + c], pRow1[x1 + c], bias);
+			}
+		}
+	}
+}
+} // namespace
+
+Span<u8> Chain::level(std::size_t idx) const {
+	ENSURE(idx < levels.size(), "Invalid level!");
+	return Span<u8>(bytes.data() + levels[idx].offset, levels[idx].size);
+}
+
+u32 levelCount(u32 width, u32 height) noexcept {
+	u32 ret = 1;
+	for (u32 extent = std::max(width, height); extent > 1; extent /= 2) {
+		++ret;
+	}
+	return ret;
+}
+
+void downsample(u8 const* pSrc, u32 width, u32 height, u8* pDst, Encoding encoding) {
+	downsampleRows(pSrc, width, height, pDst, encoding, 0, std::max(height / 2, 1U));
+}
+
+Chain generate(Span<u8> rgba, u32 width, u32 height, Encoding encoding, u32 maxLevels, bool bParallel) {
+	Chain ret;
+	ENSURE(rgba.extent >= (std::size_t)width * height * 4, "Invalid image data!");
+	if (width == 0 || height == 0 || rgba.extent < (std::size_t)width * height * 4) {
+		return ret;
+	}
+	u32 count = levelCount(width, height);
+	if (maxLevels > 0) {
+		count = std::min(count, maxLevels);
+	}
+	std::size_t total = 0;
+	for (u32 level = 1, w = width, h = height; level < count; ++level) {
+		w = std::max(w / 2, 1U);
+		h = std::max(h / 2, 1U);
+		Level entry;
+		entry.width = w;
+		entry.height = h;
+		entry.offset = total;
+		entry.size = (std::size_t)w * h * 4;
+		total += entry.size;
+		ret.levels.push_back(entry);
+	}
+	ret.bytes.resize(total);
+	u32 const workers = bParallel ? (u32)tasks::workerCount() : 0;
+	u8 const* pSrc = rgba.pData;
+	u32 srcWidth = width;
+	u32 srcHeight = height;
+	for (auto const& level : ret.levels) {
+		u8* pDst = ret.bytes.data() + level.offset;
+		u32 const bandCount = std::min(workers + 1, level.height / g_minBandRows);
+		if (workers > 0 && bandCount > 1 && (std::size_t)level.width * level.height >= g_minParallelTexels) {
+			auto work = [pSrc, srcWidth, srcHeight, pDst, encoding](u32 begin, u32 end) {
+				downsampleRows(pSrc, srcWidth, srcHeight, pDst, encoding, begin, end);
+			};
+			tasks::forBands(level.height, bandCount, work);
+		} else {
+			downsampleRows(pSrc, srcWidth, srcHeight, pDst, encoding, 0, level.height);
+		}
+		pSrc = pDst;
+		srcWidth = level.width;
+		srcHeight = level.height;
+	}
+	return ret;
+}
+} // namespace le::mips
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <fstream>
+#include <core/log.hpp>
+#include <core/pack.hpp>
+#include <core/utils.hpp>
+
+namespace le::io {
+namespace {
+constexpr std::string_view g_tName = "pack";
+
+constexpr u64 aligned(u64 offset) noexcept {
+	return (offset + pack::alignment - 1) & ~(pack::alignment - 1);
+}
+} // namespace
+
+u64 pack::hash(std::string_view id) noexcept {
+	u64 ret = 0xcbf29ce484222325;
+	for (char const c : id) {
+		ret ^= (u64)(u8)c;
+		ret *= 0x100000001b3;
+	}
+	return ret;
+}
+
+bool pack::Writer::add(std::string id, stdfs::path file) {
+	std::error_code errCode;
+	if (id.empty() || !stdfs::is_regular_file(file, errCode)) {
+		logE("[{}] Invalid entry [{}] ([{}])", g_tName, id, file.generic_string());
+		return false;
+	}
+	if (!m_ids.insert(id).second) {
+		logD("[{}] Duplicate entry [{}] ignored", g_tName, id);
+		return false;
+	}
+	m_files.push_back({std::move(id), std::move(file)});
+	return true;
+}
+
+std::size_t pack::Writer::addAll(stdfs::path const& directory) {
+	std::size_t ret = 0;
+	std::error_code errCode;
+	auto iter = stdfs::recursive_directory_iterator(directory, stdfs::directory_options::skip_permission_denied, errCode);
+	for (; !errCode && iter != stdfs::recursive_directory_iterator(); iter.increment(errCode)) {
+		if (iter->is_regular_file(errCode) && add(iter->path().lexically_relative(directory).generic_string(), iter->path())) {
+			++ret;
+		}
+	}
+	return ret;
+}
+
+bool pack::Writer::write(stdfs::path const& path) const {
+	std::vector<std::pair<u64, File const*>> files;
+	files.reserve(m_files.size());
+	for (auto const& file : m_files) {
+		files.push_back({hash(file.id), &file});
+	}
+	std::sort(files.begin(), files.end(), [](auto const& lhs, auto const& rhs) {
+		return lhs.first == rhs.first ? lhs.second->id < rhs.second->id : lhs.first < rhs.first;
+	});
+	Header header;
+	header.entryCount = (u32)files.size();
+	header.namesOffset = sizeof(Header) + sizeof(Entry) * files.size();
+	std::vector<Entry> entries;
+	entries.reserve(files.size());
+	std::string names;
+	for (auto const& [idHash, pFile] : files) {
+		std::error_code errCode;
+		auto const size = stdfs::file_size(pFile->path, errCode);
+		if (errCode) {
+			logE("[{}] Failed to read [{}]", g_tName, pFile->path.generic_string());
+			return false;
+		}
+		Entry entry;
+		entry.hash = idHash;
+		entry.size = entry.storedSize = (u64)size;
+		entry.nameOffset = (u32)names.size();
+		entry.nameSize = (u32)pFile->id.size();
+		entry.codec = Codec::eNone;
+		names += pFile->id;
+		entries.push_back(entry);
+	}
+	header.namesSize = names.size();
+	u64 offset = aligned(header.namesOffset + header.namesSize);
+	for (auto& entry : entries) {
+		entry.offset = offset;
+		offset = aligned(offset + entry.storedSize);
+	}
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		logE("[{}] Failed to open [{}] for writing", g_tName, path.generic_string());
+		return false;
+	}
+	out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	out.write(reinterpret_cast<char const*>(entries.data()), (std::streamsize)(sizeof(Entry) * entries.size()));
+	out.write(names.data(), (std::streamsize)names.size());
+	for (std::size_t idx = 0; idx < files.size(); ++idx) {
+		std::string const padding((std::size_t)entries[idx].offset - (std::size_t)out.tellp(), '\0');
+		out.write(padding.data(), (std::streamsize)padding.size());
+		std::ifstream in(files[idx].second->path, std::ios::binary);
+		if (entries[idx].size > 0 && !(out << in.rdbuf())) {
+			logE("[{}] Failed to pack [{}]", g_tName, files[idx].second->path.generic_string());
+			return false;
+		}
+	}
+	logI("[{}] [{}] entries packed into [{}] ({} bytes)", g_tName, entries.size(), path.generic_string(), (u64)out.tellp());
+	return out.good();
+}
+
+std::size_t pack::Writer::size() const noexcept {
+	return m_files.size();
+}
+} // namespace le::io
@@ -1,5 +1,6 @@
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <optional>
 #include <physfs/physfs.h>
 #include <core/ensure.hpp>
@@ -7,7 +8,14 @@
 #include <core/os.hpp>
 #include <core/reader.hpp>
 #include <core/utils.hpp>
+#include <core/xxhash.hpp>
 #include <io_impl.hpp>
+#if defined(LEVK_OS_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace le::io {
 namespace {
@@ -35,8 +43,212 @@ PhysfsHandle::~PhysfsHandle() {
 }
 
 std::optional<PhysfsHandle> g_physfsHandle;
+
+class BufferStream final : public Stream {
+  public:
+	BufferStream(bytearray buffer) : m_buffer(std::move(buffer)) {
+	}
+
+	std::size_t read(std::byte* pOut, std::size_t count) override {
+		count = std::min(count, m_buffer.size() - m_position);
+		std::copy(m_buffer.begin() + (std::ptrdiff_t)m_position, m_buffer.begin() + (std::ptrdiff_t)(m_position + count), pOut);
+		m_position += count;
+		return count;
+	}
+	bool seek(std::size_t position) override {
+		m_position = std::min(position, m_buffer.size());
+		return true;
+	}
+	std::size_t tell() const override {
+		return m_position;
+	}
+	std::size_t size() const override {
+		return m_buffer.size();
+	}
+
+  private:
+	bytearray m_buffer;
+	std::size_t m_position = 0;
+};
+
+// Reads [offset, offset + size) of a file (whole files / pack entries)
+class FileStream final : public Stream {
+  public:
+	FileStream(stdfs::path const& path, std::size_t offset, std::size_t size) : m_file(path, std::ios::binary), m_offset(offset), m_size(size) {
+		m_file.seekg((std::streamoff)m_offset);
+	}
+
+	bool good() const {
+		return m_file.good();
+	}
+
+	std::size_t read(std::byte* pOut, std::size_t count) override {
+		count = std::min(count, m_size - m_position);
+		m_file.read(reinterpret_cast<char*>(pOut), (std::streamsize)count);
+		auto const ret = (std::size_t)m_file.gcount();
+		m_position += ret;
+		return ret;
+	}
+	bool seek(std::size_t position) override {
+		m_position = std::min(position, m_size);
+		m_file.clear();
+		return (bool)m_file.seekg((std::streamoff)(m_offset + m_position));
+	}
+	std::size_t tell() const override {
+		return m_position;
+	}
+	std::size_t size() const override {
+		return m_size;
+	}
+
+  private:
+	std::ifstream m_file;
+	std::size_t m_offset = 0;
+	std::size_t m_size = 0;
+	std::size_t m_position = 0;
+};
+
+class PhysfsStream final : public Stream {
+  public:
+	PhysfsStream(PHYSFS_File* pFile) : m_pFile(pFile) {
+		auto const length = PHYSFS_fileLength(m_pFile);
+		m_size = length > 0 ? (std::size_t)length : 0;
+	}
+	~PhysfsStream() override {
+		PHYSFS_close(m_pFile);
+	}
+
+	std::size_t read(std::byte* pOut, std::size_t count) override {
+		auto const ret = PHYSFS_readBytes(m_pFile, pOut, (PHYSFS_uint64)count);
+		return ret > 0 ? (std::size_t)ret : 0;
+	}
+	bool seek(std::size_t position) override {
+		return PHYSFS_seek(m_pFile, (PHYSFS_uint64)std::min(position, m_size)) != 0;
+	}
+	std::size_t tell() const override {
+		auto const ret = PHYSFS_tell(m_pFile);
+		return ret > 0 ? (std::size_t)ret : 0;
+	}
+	std::size_t size() const override {
+		return m_size;
+	}
+
+  private:
+	PHYSFS_File* m_pFile;
+	std::size_t m_size = 0;
+};
 } // namespace
 
+Stream::~Stream() = default;
+
+bool Stream::eof() const {
+	return tell() >= size();
+}
+
+Mapped::Mapped(bytearray buffer) noexcept : m_buffer(std::move(buffer)) {
+	m_size = m_buffer.size();
+}
+
+Mapped::Mapped(Mapped&& rhs) noexcept
+	: m_buffer(std::move(rhs.m_buffer)), m_pMap(rhs.m_pMap), m_mapSize(rhs.m_mapSize), m_offset(rhs.m_offset), m_size(rhs.m_size) {
+	rhs.m_pMap = nullptr;
+	rhs.m_mapSize = rhs.m_offset = rhs.m_size = 0;
+}
+
+Mapped& Mapped::operator=(Mapped&& rhs) noexcept {
+	if (&rhs != this) {
+		unmap();
+		m_buffer = std::move(rhs.m_buffer);
+		m_pMap = rhs.m_pMap;
+		m_mapSize = rhs.m_mapSize;
+		m_offset = rhs.m_offset;
+		m_size = rhs.m_size;
+		rhs.m_pMap = nullptr;
+		rhs.m_mapSize = rhs.m_offset = rhs.m_size = 0;
+	}
+	return *this;
+}
+
+Mapped::~Mapped() {
+	unmap();
+}
+
+kt::result_void<Mapped> Mapped::file(stdfs::path const& path) {
+	std::error_code errCode;
+	auto const size = stdfs::file_size(path, errCode);
+	if (errCode) {
+		return {};
+	}
+	return file(path, 0, (std::size_t)size);
+}
+
+kt::result_void<Mapped> Mapped::file(stdfs::path const& path, std::size_t offset, std::size_t size) {
+	if (size == 0) {
+		return Mapped();
+	}
+#if defined(LEVK_OS_LINUX)
+	if (auto const fd = ::open(path.string().data(), O_RDONLY); fd >= 0) {
+		// mapping must begin on a page boundary
+		auto const pageSize = (std::size_t)::sysconf(_SC_PAGESIZE);
+		auto const base = offset - (offset % pageSize);
+		Mapped ret;
+		void* pMap = ::mmap(nullptr, size + offset - base, PROT_READ, MAP_PRIVATE, fd, (off_t)base);
+		::close(fd);
+		if (pMap != MAP_FAILED) {
+			ret.m_pMap = pMap;
+			ret.m_mapSize = size + offset - base;
+			ret.m_offset = offset - base;
+			ret.m_size = size;
+			return ret;
+		}
+	}
+#endif
+	std::ifstream file(path, std::ios::binary);
+	if (file.good()) {
+		auto buf = bytearray(size);
+		file.seekg((std::streamoff)offset, std::ios::beg);
+		if (file.read((char*)buf.data(), (std::streamsize)size)) {
+			return Mapped(std::move(buf));
+		}
+	}
+	return {};
+}
+
+Span<std::byte> Mapped::bytes() const noexcept {
+	if (m_pMap) {
+		return Span<std::byte>(reinterpret_cast<std::byte const*>(m_pMap) + m_offset, m_size);
+	}
+	return Span<std::byte>(m_buffer);
+}
+
+std::string_view Mapped::text() const noexcept {
+	auto const data = bytes();
+	return data.empty() ? std::string_view() : std::string_view(reinterpret_cast<char const*>(data.pData), data.size());
+}
+
+std::size_t Mapped::size() const noexcept {
+	return m_size;
+}
+
+bool Mapped::empty() const noexcept {
+	return m_size == 0;
+}
+
+bool Mapped::mapped() const noexcept {
+	return m_pMap != nullptr;
+}
+
+void Mapped::unmap() noexcept {
+#if defined(LEVK_OS_LINUX)
+	if (m_pMap) {
+		::munmap(m_pMap, m_mapSize);
+	}
+#endif
+	m_pMap = nullptr;
+	m_mapSize = m_offset = m_size = 0;
+	m_buffer.clear();
+}
+
 Reader::Reader() noexcept = default;
 Reader::Reader(Reader&&) noexcept = default;
 Reader& Reader::operator=(Reader&&) noexcept = default;
@@ -51,10 +263,32 @@ Reader::Result<std::string> Reader::string(stdfs::path const& id) const {
 	return {};
 }
 
+Reader::Result<Mapped> Reader::map(stdfs::path const& id) const {
+	if (auto buf = bytes(id)) {
+		return Mapped(buf.move());
+	}
+	return {};
+}
+
+std::unique_ptr<Stream> Reader::open(stdfs::path const& id) const {
+	if (auto buf = bytes(id)) {
+		return std::make_unique<BufferStream>(buf.move());
+	}
+	return {};
+}
+
 bool Reader::isPresent(const stdfs::path& id) const {
 	return findPrefixed(id).has_result();
 }
 
+bool Reader::refresh(stdfs::path const& id) const {
+	forget(id);
+	return isPresent(id);
+}
+
+void Reader::forget(stdfs::path const&) const {
+}
+
 bool Reader::checkPresence(stdfs::path const& id) const {
 	if (!isPresent(id)) {
 		logE("[{}] [{}] not found in {}!", utils::tName(this), id.generic_string(), m_medium);
@@ -104,7 +338,8 @@ bool FileReader::mount(stdfs::path path) {
 			logE("[{}] [{}] not found on Filesystem!", utils::tName<FileReader>(), pathStr);
 			return false;
 		}
-		logD("[{}] [{}] directory mounted", utils::tName<FileReader>(), pathStr);
+		auto const count = index(path);
+		logD("[{}] [{}] directory mounted ({} files indexed)", utils::tName<FileReader>(), pathStr, count);
 		m_dirs.push_back(std::move(path));
 		return true;
 	}
@@ -138,16 +373,112 @@ Reader::Result<std::stringstream> FileReader::sstream(stdfs::path const& id) con
 	return {};
 }
 
+Reader::Result<Mapped> FileReader::map(stdfs::path const& id) const {
+	if (auto path = findPrefixed(id)) {
+		return Mapped::file(*path);
+	}
+	return {};
+}
+
+std::unique_ptr<Stream> FileReader::open(stdfs::path const& id) const {
+	if (auto path = findPrefixed(id)) {
+		std::error_code errCode;
+		auto const size = stdfs::file_size(*path, errCode);
+		if (!errCode) {
+			if (auto ret = std::make_unique<FileStream>(*path, 0, (std::size_t)size); ret->good()) {
+				return ret;
+			}
+		}
+	}
+	return {};
+}
+
 Reader::Result<stdfs::path> FileReader::findPrefixed(stdfs::path const& id) const {
+	if (id.has_root_directory()) {
+		if (stdfs::is_regular_file(id)) {
+			return stdfs::path(id);
+		}
+		return {};
+	}
+	auto const key = id.lexically_normal().generic_string();
+	stdfs::path indexed;
+	{
+		std::shared_lock lock(m_index.mutex);
+		if (auto search = m_index.paths.find(key); search != m_index.paths.end()) {
+			indexed = search->second;
+		}
+	}
+	if (!indexed.empty()) {
+		// the index is only refreshed by hot reload: verify the hit (one stat instead of one per prefix)
+		std::error_code errCode;
+		if (stdfs::is_regular_file(indexed, errCode)) {
+			return indexed;
+		}
+		std::unique_lock lock(m_index.mutex);
+		if (auto search = m_index.paths.find(key); search != m_index.paths.end() && search->second == indexed) {
+			m_index.paths.erase(search);
+		}
+	}
+	// not indexed (created after mount? deleted / moved since?): search and cache if found
 	auto const paths = finalPaths(id);
 	for (auto const& path : paths) {
 		if (stdfs::is_regular_file(path)) {
+			std::unique_lock lock(m_index.mutex);
+			m_index.paths.emplace(key, path);
 			return stdfs::path(path);
 		}
 	}
 	return {};
 }
 
+void FileReader::forget(stdfs::path const& id) const {
+	std::unique_lock lock(m_index.mutex);
+	m_index.paths.erase(id.lexically_normal().generic_string());
+}
+
+std::size_t FileReader::index(stdfs::path const& dir) {
+	std::size_t ret = 0;
+	std::error_code errCode;
+	auto iter = stdfs::recursive_directory_iterator(dir, stdfs::directory_options::skip_permission_denied, errCode);
+	std::unique_lock lock(m_index.mutex);
+	for (; !errCode && iter != stdfs::recursive_directory_iterator(); iter.increment(errCode)) {
+		if (iter->is_regular_file(errCode)) {
+			// earlier mounts take precedence
+			if (m_index.paths.emplace(iter->path().lexically_relative(dir).generic_string(), iter->path()).second) {
+				++ret;
+			}
+		}
+	}
+	logW_if(errCode, "[{}] Error indexing [{}]: {}", utils::tName<FileReader>(), dir.generic_string(), errCode.message());
+	return ret;
+}
+
+FileReader::Index::Index(Index&& rhs) noexcept : paths(std::move(rhs.paths)) {
+}
+
+FileReader::Index& FileReader::Index::operator=(Index&& rhs) noexcept {
+	if (&rhs != this) {
+		std::scoped_lock lock(mutex, rhs.mutex);
+		paths = std::move(rhs.paths);
+	}
+	return *this;
+}
+
+FileReader::Index::Index(Index const& rhs) {
+	std::shared_lock lock(rhs.mutex);
+	paths = rhs.paths;
+}
+
+FileReader::Index& FileReader::Index::operator=(Index const& rhs) {
+	if (&rhs != this) {
+		std::unique_lock lock(mutex, std::defer_lock);
+		std::shared_lock rlock(rhs.mutex, std::defer_lock);
+		std::lock(lock, rlock);
+		paths = rhs.paths;
+	}
+	return *this;
+}
+
 std::vector<stdfs::path> FileReader::finalPaths(stdfs::path const& id) const {
 	if (id.has_root_directory()) {
 		return {id};
@@ -225,6 +556,141 @@ Reader::Result<bytearray> ZIPReader::bytes(stdfs::path const& id) const {
 	return {};
 }
 
+PackReader::PackReader() {
+	m_medium = "Pack";
+}
+
+bool PackReader::mount(stdfs::path path) {
+	auto const pathStr = path.generic_string();
+	auto const search = std::find_if(m_packs.begin(), m_packs.end(), [&path](Pack const& pack) { return pack.path == path; });
+	if (search != m_packs.end()) {
+		logW("[{}] [{}] pack already mounted", utils::tName<PackReader>(), pathStr);
+		return false;
+	}
+	std::error_code errCode;
+	auto const fileSize = (u64)stdfs::file_size(path, errCode);
+	std::ifstream file(path, std::ios::binary);
+	if (errCode || !file) {
+		logE("[{}] [{}] not found on Filesystem!", utils::tName<PackReader>(), pathStr);
+		return false;
+	}
+	pack::Header header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != pack::magic || header.version != pack::version) {
+		logE("[{}] [{}] is not a (compatible) pack!", utils::tName<PackReader>(), pathStr);
+		return false;
+	}
+	u64 const entriesSize = (u64)header.entryCount * sizeof(pack::Entry);
+	bool const bHeaderValid = entriesSize <= fileSize - sizeof(header) && header.namesOffset <= fileSize && header.namesSize <= fileSize - header.namesOffset;
+	if (!bHeaderValid) {
+		logE("[{}] [{}] is corrupted!", utils::tName<PackReader>(), pathStr);
+		return false;
+	}
+	Pack pack;
+	pack.entries.resize(header.entryCount);
+	pack.names.resize((std::size_t)header.namesSize);
+	file.read(reinterpret_cast<char*>(pack.entries.data()), (std::streamsize)(sizeof(pack::Entry) * pack.entries.size()));
+	file.seekg((std::streamoff)header.namesOffset);
+	file.read(pack.names.data(), (std::streamsize)pack.names.size());
+	bool const bValid = file && std::all_of(pack.entries.begin(), pack.entries.end(), [&](pack::Entry const& entry) {
+		if (entry.offset > fileSize || entry.storedSize > fileSize - entry.offset) {
+			return false;
+		}
+		if (entry.codec == pack::Codec::eNone && entry.size != entry.storedSize) {
+			return false;
+		}
+		return entry.nameOffset <= header.namesSize && entry.nameSize <= header.namesSize - entry.nameOffset;
+	});
+	if (!bValid) {
+		logE("[{}] [{}] is corrupted!", utils::tName<PackReader>(), pathStr);
+		return false;
+	}
+	logD("[{}] [{}] pack mounted ({} entries)", utils::tName<PackReader>(), pathStr, pack.entries.size());
+	pack.path = std::move(path);
+	m_packs.push_back(std::move(pack));
+	return true;
+}
+
+Reader::Result<bytearray> PackReader::bytes(stdfs::path const& id) const {
+	if (auto found = find(id)) {
+		auto const& entry = *found->pEntry;
+		if (entry.codec != pack::Codec::eNone) {
+			logE("[{}] [{}] Unsupported codec: [{}]", utils::tName<PackReader>(), id.generic_string(), (u32)entry.codec);
+			return {};
+		}
+		std::ifstream file(found->pPack->path, std::ios::binary);
+		auto buf = bytearray((std::size_t)entry.size);
+		file.seekg((std::streamoff)entry.offset);
+		if (file.read(reinterpret_cast<char*>(buf.data()), (std::streamsize)buf.size())) {
+			return buf;
+		}
+	}
+	return {};
+}
+
+Reader::Result<std::stringstream> PackReader::sstream(stdfs::path const& id) const {
+	if (auto buf = bytes(id)) {
+		std::stringstream ret;
+		ret.write(reinterpret_cast<char const*>(buf->data()), (std::streamsize)buf->size());
+		return ret;
+	}
+	return {};
+}
+
+Reader::Result<Mapped> PackReader::map(stdfs::path const& id) const {
+	if (auto found = find(id)) {
+		auto const& entry = *found->pEntry;
+		if (entry.codec == pack::Codec::eNone) {
+			return Mapped::file(found->pPack->path, (std::size_t)entry.offset, (std::size_t)entry.size);
+		}
+		return Reader::map(id);
+	}
+	return {};
+}
+
+std::unique_ptr<Stream> PackReader::open(stdfs::path const& id) const {
+	if (auto found = find(id)) {
+		auto const& entry = *found->pEntry;
+		if (entry.codec == pack::Codec::eNone) {
+			if (auto ret = std::make_unique<FileStream>(found->pPack->path, (std::size_t)entry.offset, (std::size_t)entry.size); ret->good()) {
+				return ret;
+			}
+			return {};
+		}
+		return Reader::open(id);
+	}
+	return {};
+}
+
+Reader::Result<stdfs::path> PackReader::findPrefixed(stdfs::path const& id) const {
+	if (find(id)) {
+		return stdfs::path(id);
+	}
+	return {};
+}
+
+Reader::Result<PackReader::Found> PackReader::find(stdfs::path const& id) const {
+	auto const idStr = id.lexically_normal().generic_string();
+	auto const hash = pack::hash(idStr);
+	for (auto const& pack : m_packs) {
+		auto iter = std::lower_bound(pack.entries.begin(), pack.entries.end(), hash, [](pack::Entry const& lhs, u64 rhs) { return lhs.hash < rhs; });
+		for (; iter != pack.entries.end() && iter->hash == hash; ++iter) {
+			if (std::string_view(pack.names).substr(iter->nameOffset, iter->nameSize) == idStr) {
+				return Found{&pack, &*iter};
+			}
+		}
+	}
+	return {};
+}
+
+std::unique_ptr<Stream> ZIPReader::open(stdfs::path const& id) const {
+	if (checkPresence(id)) {
+		if (auto pFile = PHYSFS_openRead(id.generic_string().data())) {
+			return std::make_unique<PhysfsStream>(pFile);
+		}
+	}
+	return {};
+}
+
 void impl::initPhysfs() {
 	if (!g_physfsHandle) {
 		g_physfsHandle = PhysfsHandle();
@@ -235,7 +701,7 @@ void impl::deinitPhysfs() {
 	g_physfsHandle.reset();
 }
 
-FileMonitor::FileMonitor(stdfs::path const& path, Mode mode) : m_path(path), m_mode(mode) {
+FileMonitor::FileMonitor(stdfs::path const& path, Mode mode) : m_path(path), m_changed(watcher::watch(path)), m_mode(mode) {
 }
 
 FileMonitor::FileMonitor(FileMonitor&&) = default;
@@ -243,6 +709,10 @@ FileMonitor& FileMonitor::operator=(FileMonitor&&) = default;
 FileMonitor::~FileMonitor() = default;
 
 FileMonitor::Status FileMonitor::update() {
+	if (m_changed && m_status != Status::eNotFound && !m_changed->exchange(false)) {
+		// no change notifications: nothing to query
+		return m_status = Status::eUpToDate;
+	}
 	std::error_code errCode;
 	if (stdfs::is_regular_file(m_path, errCode)) {
 		auto const lastWriteTime = stdfs::last_write_time(m_path, errCode);
@@ -270,6 +740,15 @@ FileMonitor::Status FileMonitor::update() {
 						m_lastModifiedTime = m_lastWriteTime;
 					}
 				}
+			} else if (m_mode == Mode::eContentHash) {
+				if (auto hash = hashContents()) {
+					if (*hash == m_hash) {
+						bDirty = false;
+					} else {
+						m_hash = *hash;
+						m_lastModifiedTime = m_lastWriteTime;
+					}
+				}
 			}
 			m_status = bDirty ? Status::eModified : Status::eUpToDate;
 		} else {
@@ -312,4 +791,25 @@ bytearray const& FileMonitor::bytes() const {
 	}
 	return m_bytes;
 }
+
+u64 FileMonitor::hash() const {
+	ENSURE(m_mode == Mode::eContentHash, "Monitor not in Content Hash mode!");
+	if (m_mode != Mode::eContentHash) {
+		logE("[{}] not monitoring file contents hash [{}]!", utils::tName<FileReader>(), m_path.generic_string());
+	}
+	return m_hash;
+}
+
+std::optional<u64> FileMonitor::hashContents() const {
+	auto stream = s_reader.open(m_path);
+	if (!stream) {
+		return std::nullopt;
+	}
+	XXH64 hasher;
+	std::array<std::byte, 64 * 1024> buffer;
+	for (auto count = stream->read(buffer.data(), buffer.size()); count > 0; count = stream->read(buffer.data(), buffer.size())) {
+		hasher.update(buffer.data(), count);
+	}
+	return hasher.digest();
+}
 } // namespace le::io
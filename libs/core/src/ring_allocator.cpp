@@ -0,0 +1,50 @@
+#include <core/ring_allocator.hpp>
+
+namespace le {
+RingAllocator::RingAllocator(u64 capacity, u64 alignment) noexcept : m_alignment(alignment > 0 ? alignment : 1) {
+	m_capacity = capacity & ~(m_alignment - 1);
+}
+
+std::optional<RingAllocator::Block> RingAllocator::allocate(u64 size) noexcept {
+	u64 const aligned = align(size > 0 ? size : 1);
+	if (aligned > m_capacity) {
+		return std::nullopt;
+	}
+	if (m_used == 0) {
+		// empty: restart at the front to avoid needless wrapping
+		m_head = 0;
+	}
+	Block ret{m_head, aligned};
+	if (ret.offset + aligned > m_capacity) {
+		// skip the tail end of the ring
+		ret.consumed += m_capacity - ret.offset;
+		ret.offset = 0;
+	}
+	if (m_used + ret.consumed > m_capacity) {
+		return std::nullopt;
+	}
+	m_head = ret.offset + aligned;
+	m_used += ret.consumed;
+	return ret;
+}
+
+void RingAllocator::release(u64 consumed) noexcept {
+	m_used = consumed < m_used ? m_used - consumed : 0;
+}
+
+void RingAllocator::reset() noexcept {
+	m_head = m_used = 0;
+}
+
+u64 RingAllocator::capacity() const noexcept {
+	return m_capacity;
+}
+
+u64 RingAllocator::used() const noexcept {
+	return m_used;
+}
+
+u64 RingAllocator::align(u64 size) const noexcept {
+	return (size + m_alignment - 1) & ~(m_alignment - 1);
+}
+} // namespace le
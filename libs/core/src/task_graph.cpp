@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <core/ensure.hpp>
+#include <core/task_graph.hpp>
+
+namespace le::tasks {
+namespace {
+struct Current final {
+	Graph const* pGraph = nullptr;
+	Graph::ID id = 0;
+};
+
+thread_local Current t_current;
+} // namespace
+
+Graph::~Graph() {
+	discard();
+	wait();
+}
+
+Graph::ID Graph::add(std::function<void()> task, std::string name, std::vector<ID> const& dependencies) {
+	std::unique_lock lock(m_mutex);
+	ID const id = m_nodes.size();
+	if (id == 0 || m_done == id) {
+		// (re)starting from idle
+		m_start = Time::elapsed();
+	}
+	Node node;
+	node.task = std::move(task);
+	node.name = std::move(name);
+	node.dependencies = dependencies;
+	for (ID const dependency : dependencies) {
+		ENSURE(dependency < id, "Invalid dependency!");
+		Node& dep = m_nodes[dependency];
+		if (!dep.bDone) {
+			dep.dependents.push_back(id);
+			++node.pending;
+		}
+	}
+	m_nodes.push_back(std::move(node));
+	if (m_nodes.back().pending == 0) {
+		launch(id);
+	}
+	return id;
+}
+
+std::optional<Graph::ID> Graph::current() const {
+	if (t_current.pGraph == this) {
+		return t_current.id;
+	}
+	return std::nullopt;
+}
+
+bool Graph::done() const {
+	std::unique_lock lock(m_mutex);
+	return m_done == m_nodes.size();
+}
+
+void Graph::wait() {
+	std::unique_lock lock(m_mutex);
+	m_cv.wait(lock, [this]() { return m_done == m_nodes.size(); });
+}
+
+void Graph::discard() {
+	std::unique_lock lock(m_mutex);
+	m_bDiscard = true;
+	for (ID id = 0; id < m_nodes.size(); ++id) {
+		Node& node = m_nodes[id];
+		if (!node.bDone && node.handle && (node.handle->discard() || node.handle->status() == Handle::Status::eDiscarded)) {
+			finish(id, true);
+		}
+	}
+}
+
+Graph::Stats Graph::stats() const {
+	std::unique_lock lock(m_mutex);
+	Stats ret;
+	ret.nodes = m_nodes.size();
+	ret.elapsed = m_end - m_start;
+	for (Node const& node : m_nodes) {
+		ret.total += node.duration;
+		if (ret.criticalPath < node.path) {
+			ret.criticalPath = node.path;
+		}
+		if (node.bDiscarded) {
+			++ret.discarded;
+		}
+	}
+	return ret;
+}
+
+// Called with m_mutex locked
+void Graph::launch(ID id) {
+	Node& node = m_nodes[id];
+	if (!m_bDiscard) {
+		node.handle = tasks::enqueue([this, id]() { run(id); }, node.name);
+	}
+	if (!node.handle) {
+		// discarding / tasks not running
+		finish(id, true);
+	}
+}
+
+void Graph::run(ID id) {
+	std::function<void()> task;
+	{
+		std::unique_lock lock(m_mutex);
+		task = std::move(m_nodes[id].task);
+	}
+	Time const start = Time::elapsed();
+	auto const previous = t_current;
+	t_current = {this, id};
+	auto complete = [this, id, start, previous]() {
+		t_current = previous;
+		Time const duration = Time::elapsed() - start;
+		std::unique_lock lock(m_mutex);
+		m_nodes[id].duration = duration;
+		finish(id, false);
+	};
+	try {
+		task();
+	} catch (...) {
+		complete();
+		throw;
+	}
+	complete();
+}
+
+// Called with m_mutex locked
+void Graph::finish(ID id, bool bDiscarded) {
+	std::vector<ID> ready;
+	{
+		Node& node = m_nodes[id];
+		node.bDone = true;
+		node.bDiscarded = bDiscarded;
+		node.task = {};
+		Time longest;
+		for (ID const dependency : node.dependencies) {
+			if (longest < m_nodes[dependency].path) {
+				longest = m_nodes[dependency].path;
+			}
+		}
+		node.path = longest;
+		node.path += node.duration;
+		for (ID const dependent : node.dependents) {
+			if (--m_nodes[dependent].pending == 0) {
+				ready.push_back(dependent);
+			}
+		}
+		++m_done;
+	}
+	for (ID const dependent : ready) {
+		launch(dependent);
+	}
+	if (m_done == m_nodes.size()) {
+		m_end = Time::elapsed();
+		m_cv.notify_all();
+	}
+}
+} // namespace le::tasks
@@ -1,23 +1,84 @@
 #include <algorithm>
-#include <array>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 #include <core/counter.hpp>
+#include <core/deferred_log.hpp>
 #include <core/log.hpp>
+#include <core/maths.hpp>
 #include <core/tasks.hpp>
 #include <core/threads.hpp>
+#include <core/timer_wheel.hpp>
 #include <core/utils.hpp>
 #include <kt/async_queue/async_queue.hpp>
 
 namespace le {
 namespace tasks {
 struct Worker final {
+	std::atomic<bool> bBusy;
+	std::atomic<bool> bRetired;
 	threads::TScoped thread;
 
-	Worker(std::size_t idx);
+	Worker(std::size_t id);
+
+	static void execute(Handle& out_handle, std::function<void()> const& task, std::string_view name);
+};
+
+struct Scheduler final {
+	struct Entry final {
+		std::shared_ptr<Timer> timer;
+		std::function<void()> task;
+		std::string name;
+		u64 period = 0;
+	};
+	using Wheel = TTimerWheel<Entry>;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	Wheel wheel;
+	TCounter<s64> nextID;
+	Time tick;
+	Time epoch;
+	std::atomic<bool> bWork;
+	threads::TScoped thread;
+
+	Scheduler();
+
+	std::shared_ptr<Timer> schedule(Time delay, std::function<void()> task, std::string name, bool bRepeat);
+	void fire(Entry&& entry);
+	// advance the wheel up to the current time (mutex must be held)
+	void advance();
+
+	void init(Time tick);
+	void deinit();
 };
 
 namespace {
+struct Bands final {
+	std::function<void(u32, u32)> work;
+	std::atomic<u32> next = 0;
+	u32 count = 0;
+	u32 rows = 0;
+	u32 rowsPerBand = 0;
+	std::mutex mutex;
+	std::condition_variable cv;
+	u32 done = 0;
+
+	void process() {
+		for (u32 band = next++; band < count; band = next++) {
+			u32 const begin = band * rowsPerBand;
+			work(begin, std::min(begin + rowsPerBand, rows));
+			std::unique_lock lock(mutex);
+			if (++done == count) {
+				cv.notify_all();
+			}
+		}
+	}
+};
+
 struct Task final {
 	std::function<void()> task;
 	std::shared_ptr<Handle> handle;
@@ -38,6 +99,8 @@ class Queue final {
 	std::optional<Task> popTask();
 	std::shared_ptr<Handle> pushTask(std::function<void()> task, std::string name);
 	std::vector<std::shared_ptr<Handle>> pushTasks(List taskList);
+	void pushRetire(std::size_t count);
+	std::shared_ptr<Handle> newHandle();
 
 	bool active() const;
 
@@ -48,11 +111,24 @@ class Queue final {
 	void deinit();
 };
 
+struct MainQueue final {
+	EnumArray<Phase, std::deque<Task>> queues;
+	kt::lockable<std::mutex> mutex;
+
+	void clear();
+};
+
 constexpr std::string_view g_tName = "tasks";
 Queue g_queue;
-std::vector<Worker> g_workers;
-constexpr std::size_t maxWorkers = 256;
-std::array<std::atomic<bool>, maxWorkers> g_busy;
+// guards g_workers; workers never lock it (so it may be held while joining them)
+std::mutex g_workersMutex;
+std::vector<std::unique_ptr<Worker>> g_workers;
+// live workers, excluding those signalled to retire
+std::atomic<std::size_t> g_workerCount = 0;
+std::size_t g_nextWorkerID = 0;
+Config g_config;
+Scheduler g_scheduler;
+MainQueue g_main;
 
 Queue::Queue() {
 	m_bWork.store(true);
@@ -101,12 +177,29 @@ std::vector<std::shared_ptr<Handle>> Queue::pushTasks(List taskList) {
 	return ret;
 }
 
+void Queue::pushRetire(std::size_t count) {
+	// tasks without handles signal workers to retire
+	m_queue.push(std::vector<Task>(count));
+}
+
+std::shared_ptr<Handle> Queue::newHandle() {
+	return std::make_shared<Handle>(++m_nextID);
+}
+
 bool Queue::active() const {
 	return m_bWork.load();
 }
 
 void Queue::clear() {
-	m_queue.clear(m_bWork.load());
+	bool const bActive = m_bWork.load();
+	auto residue = m_queue.clear(bActive);
+	if (bActive) {
+		// retire signals are not tasks: workers are already counted out, so restore them
+		auto const retire = std::count_if(residue.begin(), residue.end(), [](Task const& task) { return !task.handle; });
+		if (retire > 0) {
+			pushRetire((std::size_t)retire);
+		}
+	}
 }
 
 void Queue::waitIdle() {
@@ -125,38 +218,147 @@ void Queue::deinit() {
 }
 } // namespace
 
-Worker::Worker(std::size_t idx) {
-	ENSURE(idx < g_busy.size(), "Invariant violated");
-	thread = threads::newThread([idx]() {
+Worker::Worker(std::size_t id) : bBusy(false), bRetired(false) {
+	thread = threads::newThread([this, id]() {
+		threads::setName(fmt::format("levk-task-{}", id));
+		if (g_config.bPinWorkers) {
+			if (auto const hardware = threads::maxHardwareThreads(); hardware > 0) {
+				auto const target = (u32)((g_config.reserve + id) % hardware);
+				logW_if(!threads::pin(target), "[{}] Failed to pin worker_{} to hardware thread [{}]", g_tName, id, target);
+			}
+		}
 		while (g_queue.active()) {
-			g_busy[idx] = false;
+			bBusy = false;
 			auto task = g_queue.popTask();
+			if (task && !task->handle) {
+				break;
+			}
 			if (task && task->handle && task->task) {
-				auto const id = task->handle->id();
 				if (task->handle->status() == Handle::Status::eDiscarded) {
-					logI("[{}] task_{} [{}] discarded", g_tName, task->handle->id(), task->name);
+					deferred::logI("[{}] task_{} [{}] discarded", g_tName, task->handle->id(), task->name);
 					continue;
 				}
-				Handle::Status status = Handle::Status::eWaiting;
-				if (task->handle->m_status.compare_exchange_strong(status, Handle::Status::eExecuting)) {
-					g_busy[idx] = true;
-					task->handle->m_status.store(Handle::Status::eExecuting);
-					try {
-						logD_if(!task->name.empty(), "[{}] starting task_{} [{}]...", g_tName, id, task->name);
-						task->task();
-						logD_if(!task->name.empty(), "[{}] task_{} [{}] completed", g_tName, id, task->name);
-						task->handle->m_status.store(Handle::Status::eCompleted);
-					} catch (std::exception const& e) {
-						logE("[{}] task_{} [{}] threw an exception: {}", g_tName, id, task->name.empty() ? "Unnamed" : task->name, e.what());
-						task->handle->m_exception = e.what();
-						task->handle->m_status.store(Handle::Status::eError);
-					}
-				}
+				bBusy = true;
+				execute(*task->handle, task->task, task->name);
+			}
+		}
+		bBusy = false;
+		bRetired = true;
+	});
+}
+
+Scheduler::Scheduler() : bWork(false) {
+}
+
+std::shared_ptr<Timer> Scheduler::schedule(Time delay, std::function<void()> task, std::string name, bool bRepeat) {
+	if (!bWork.load() || !task) {
+		return {};
+	}
+	Entry entry;
+	entry.timer = std::make_shared<Timer>(++nextID);
+	entry.task = std::move(task);
+	entry.name = std::move(name);
+	// round up: never fire early
+	auto const ticks = (u64)std::max((delay.to_us() + tick.to_us() - 1) / tick.to_us(), (s64)1);
+	if (bRepeat) {
+		entry.period = ticks;
+	}
+	auto ret = entry.timer;
+	logD_if(!entry.name.empty(), "[{}] timer_{} [{}] scheduled ({} ticks{})", g_tName, ret->id(), entry.name, ticks, bRepeat ? ", periodic" : "");
+	{
+		std::scoped_lock lock(mutex);
+		// the wheel does not advance while idle: catch up first so `ticks` is relative to now
+		advance();
+		// the current tick is partially elapsed: one more to never fire early
+		wheel.schedule(ticks + 1, std::move(entry));
+	}
+	cv.notify_one();
+	return ret;
+}
+
+void Scheduler::fire(Entry&& entry) {
+	if (entry.timer->cancelled()) {
+		logD_if(!entry.name.empty(), "[{}] timer_{} [{}] cancelled", g_tName, entry.timer->id(), entry.name);
+		return;
+	}
+	++entry.timer->m_fireCount;
+	if (entry.period > 0) {
+		// entry fires on its expiry tick, so rescheduling by `period` does not drift
+		g_queue.pushTask(entry.task, entry.name);
+		auto const period = entry.period;
+		wheel.schedule(period, std::move(entry));
+	} else {
+		g_queue.pushTask(std::move(entry.task), std::move(entry.name));
+	}
+}
+
+void Scheduler::advance() {
+	Time elapsed = Time::elapsed();
+	elapsed -= epoch;
+	auto const target = (u64)(elapsed.to_us() / tick.to_us());
+	if (target > wheel.now()) {
+		wheel.advance(target - wheel.now(), [this](Wheel::Tick, Entry&& entry) { fire(std::move(entry)); });
+	}
+}
+
+void Scheduler::init(Time tick) {
+	this->tick = tick.to_us() > 0 ? tick : Time(1ms);
+	epoch = Time::elapsed();
+	bWork.store(true);
+	thread = threads::newThread([this]() {
+		threads::setName("levk-timers");
+		auto const period = stdch::microseconds(this->tick.to_us());
+		std::unique_lock lock(mutex);
+		while (bWork.load()) {
+			if (wheel.empty()) {
+				// idle: sleep until something is scheduled
+				cv.wait(lock, [this]() { return !bWork.load() || !wheel.empty(); });
+			} else {
+				cv.wait_for(lock, period, [this]() { return !bWork.load(); });
 			}
+			advance();
 		}
 	});
 }
 
+void Scheduler::deinit() {
+	{
+		std::scoped_lock lock(mutex);
+		bWork.store(false);
+	}
+	cv.notify_all();
+	thread = {};
+	std::scoped_lock lock(mutex);
+	wheel = {};
+}
+
+void Worker::execute(Handle& out_handle, std::function<void()> const& task, std::string_view name) {
+	auto const id = out_handle.id();
+	Handle::Status status = Handle::Status::eWaiting;
+	if (out_handle.m_status.compare_exchange_strong(status, Handle::Status::eExecuting)) {
+		try {
+			logD_if(!name.empty(), "[{}] starting task_{} [{}]...", g_tName, id, name);
+			task();
+			logD_if(!name.empty(), "[{}] task_{} [{}] completed", g_tName, id, name);
+			out_handle.m_status.store(Handle::Status::eCompleted);
+		} catch (std::exception const& e) {
+			logE("[{}] task_{} [{}] threw an exception: {}", g_tName, id, name.empty() ? "Unnamed" : name, e.what());
+			out_handle.m_exception = e.what();
+			out_handle.m_status.store(Handle::Status::eError);
+		}
+	}
+}
+
+void MainQueue::clear() {
+	auto lock = mutex.lock();
+	for (auto& queue : queues) {
+		for (auto& task : queue) {
+			task.handle->discard();
+		}
+		queue.clear();
+	}
+}
+
 Handle::Handle(s64 id) : m_id(id), m_status(Status::eWaiting) {
 }
 
@@ -195,12 +397,37 @@ std::string_view Handle::exception() const noexcept {
 	return m_exception;
 }
 
+Timer::Timer(s64 id) : m_id(id), m_bCancelled(false), m_fireCount(0) {
+}
+
+s64 Timer::id() const noexcept {
+	return m_id;
+}
+
+bool Timer::cancel() noexcept {
+	return !m_bCancelled.exchange(true);
+}
+
+bool Timer::cancelled() const noexcept {
+	return m_bCancelled.load();
+}
+
+u64 Timer::fireCount() const noexcept {
+	return m_fireCount.load();
+}
+
 Service::Service(u8 workerCount) {
 	if (!init(workerCount)) {
 		logE("[{}] Failed to initialise task workers!", g_tName);
 	}
 }
 
+Service::Service(Config config) {
+	if (!init(config)) {
+		logE("[{}] Failed to initialise task workers!", g_tName);
+	}
+}
+
 Service::~Service() {
 	deinit();
 }
@@ -214,31 +441,173 @@ std::vector<std::shared_ptr<tasks::Handle>> tasks::enqueue(List taskList) {
 	return g_queue.pushTasks(std::move(taskList));
 }
 
+std::shared_ptr<tasks::Timer> tasks::enqueueAfter(Time delay, std::function<void()> task, std::string name) {
+	return g_scheduler.schedule(delay, std::move(task), std::move(name), false);
+}
+
+std::shared_ptr<tasks::Timer> tasks::enqueueEvery(Time period, std::function<void()> task, std::string name) {
+	return g_scheduler.schedule(period, std::move(task), std::move(name), true);
+}
+
+std::shared_ptr<tasks::Handle> tasks::enqueueMain(Phase phase, std::function<void()> task, std::string name) {
+	if (!task || !g_queue.active()) {
+		return {};
+	}
+	Task newTask;
+	newTask.handle = g_queue.newHandle();
+	logD_if(!name.empty(), "[{}] task_{} [{}] enqueued (main thread)", g_tName, newTask.handle->id(), name);
+	newTask.task = std::move(task);
+	newTask.name = std::move(name);
+	auto ret = newTask.handle;
+	auto lock = g_main.mutex.lock();
+	g_main.queues[(std::size_t)phase].push_back(std::move(newTask));
+	return ret;
+}
+
+std::size_t tasks::runMain(Phase phase, Time budget) {
+	ENSURE(threads::isMainThread(), "Main thread tasks run on a different thread!");
+	std::deque<Task> pending;
+	{
+		auto lock = g_main.mutex.lock();
+		std::swap(pending, g_main.queues[(std::size_t)phase]);
+	}
+	std::size_t ret = 0;
+	Time const start = Time::elapsed();
+	while (!pending.empty()) {
+		if (ret > 0 && budget > Time()) {
+			Time elapsed = Time::elapsed();
+			elapsed -= start;
+			if (elapsed >= budget) {
+				break;
+			}
+		}
+		Task task = std::move(pending.front());
+		pending.pop_front();
+		if (task.handle->status() != Handle::Status::eDiscarded) {
+			Worker::execute(*task.handle, task.task, task.name);
+			++ret;
+		}
+	}
+	if (!pending.empty()) {
+		// carry over ahead of tasks enqueued meanwhile
+		auto lock = g_main.mutex.lock();
+		auto& queue = g_main.queues[(std::size_t)phase];
+		queue.insert(queue.begin(), std::make_move_iterator(pending.begin()), std::make_move_iterator(pending.end()));
+	}
+	return ret;
+}
+
+namespace tasks {
+namespace {
+void reapRetired() {
+	std::scoped_lock lock(g_workersMutex);
+	auto retired = [](auto const& uWorker) -> bool { return uWorker->bRetired; };
+	g_workers.erase(std::remove_if(g_workers.begin(), g_workers.end(), retired), g_workers.end());
+}
+
+bool anyBusy() {
+	std::scoped_lock lock(g_workersMutex);
+	return std::any_of(g_workers.begin(), g_workers.end(), [](auto const& uWorker) -> bool { return uWorker->bBusy; });
+}
+} // namespace
+} // namespace tasks
+
 void tasks::waitIdle(bool bKillEnqueued) {
 	if (bKillEnqueued) {
 		g_queue.clear();
 	} else {
 		g_queue.waitIdle();
 	}
-	while (std::any_of(g_busy.begin(), g_busy.end(), [](auto const& busy) -> bool { return busy; })) {
+	while (anyBusy()) {
 		threads::sleep();
 	}
+	reapRetired();
+}
+
+u8 tasks::autoWorkerCount(u8 reserve) {
+	u32 const hardware = threads::maxHardwareThreads();
+	u32 const count = hardware > (u32)reserve ? hardware - (u32)reserve : 1;
+	return (u8)std::min(count, (u32)maths::max<u8>());
+}
+
+std::size_t tasks::workerCount() {
+	return g_workerCount.load();
+}
+
+bool tasks::resize(u8 workerCount) {
+	std::size_t const current = g_workerCount.load();
+	if (current == 0 || workerCount == 0) {
+		return false;
+	}
+	// workers signalled earlier and since exited
+	reapRetired();
+	if (workerCount > current) {
+		std::scoped_lock lock(g_workersMutex);
+		for (std::size_t count = current; count < workerCount; ++count) {
+			g_workers.push_back(std::make_unique<Worker>(g_nextWorkerID++));
+		}
+	} else if (workerCount < current) {
+		// asynchronous: busy workers retire after their current task, and are reaped on a later resize / waitIdle
+		g_queue.pushRetire(current - workerCount);
+	}
+	g_workerCount.store(workerCount);
+	logI("[{}] Resized workers: [{}] => [{}]", g_tName, current, workerCount);
+	return true;
 }
 
 bool tasks::init(u8 workerCount) {
-	if (g_workers.empty() && workerCount > 0) {
+	if (workerCount == 0) {
+		return false;
+	}
+	Config config;
+	config.workerCount = workerCount;
+	return init(config);
+}
+
+bool tasks::init(Config config) {
+	std::scoped_lock lock(g_workersMutex);
+	if (g_workers.empty()) {
+		if (config.workerCount == 0) {
+			config.workerCount = autoWorkerCount(config.reserve);
+		}
+		g_config = config;
 		g_queue.init();
-		for (u8 count = 0; count < workerCount; ++count) {
-			g_workers.push_back(Worker((std::size_t)count));
+		for (u8 count = 0; count < config.workerCount; ++count) {
+			g_workers.push_back(std::make_unique<Worker>(g_nextWorkerID++));
 		}
+		g_workerCount.store(g_workers.size());
+		g_scheduler.init(config.timerTick);
+		logI("[{}] [{}] workers online (hardware threads: [{}], reserved: [{}])", g_tName, g_workers.size(), threads::maxHardwareThreads(), config.reserve);
 		return true;
 	}
 	return false;
 }
 
 void tasks::deinit() {
+	g_scheduler.deinit();
+	g_main.clear();
 	waitIdle(true);
 	g_queue.deinit();
+	g_workerCount.store(0);
+	std::scoped_lock lock(g_workersMutex);
 	g_workers.clear();
 }
+
+void tasks::forBands(u32 count, u32 bandCount, std::function<void(u32, u32)> work) {
+	if (count == 0) {
+		return;
+	}
+	bandCount = std::clamp(bandCount, 1U, count);
+	auto bands = std::make_shared<Bands>();
+	bands->work = std::move(work);
+	bands->rows = count;
+	bands->rowsPerBand = (count + bandCount - 1) / bandCount;
+	bands->count = (count + bands->rowsPerBand - 1) / bands->rowsPerBand;
+	for (u32 idx = 1; idx < bands->count; ++idx) {
+		tasks::enqueue([bands]() { bands->process(); }, "band");
+	}
+	bands->process();
+	std::unique_lock lock(bands->mutex);
+	bands->cv.wait(lock, [&bands]() { return bands->done == bands->count; });
+}
 } // namespace le
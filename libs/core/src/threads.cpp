@@ -1,10 +1,13 @@
 #include <list>
+#include <string>
 #include <utility>
 #include <core/ensure.hpp>
 #include <core/log.hpp>
 #include <core/os.hpp>
 #include <core/threads.hpp>
 #if defined(LEVK_OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
 #include <X11/Xlib.h>
 #include <X11/extensions/Xrandr.h>
 #endif
@@ -101,6 +104,29 @@ u32 threads::runningCount() {
 	return (u32)g_threads.size();
 }
 
+bool threads::setName([[maybe_unused]] std::string_view name) {
+#if defined(LEVK_OS_LINUX)
+	std::string truncated(name.substr(0, 15));
+	return pthread_setname_np(pthread_self(), truncated.data()) == 0;
+#else
+	return false;
+#endif
+}
+
+bool threads::pin([[maybe_unused]] u32 hardwareThread) {
+#if defined(LEVK_OS_LINUX)
+	if (hardwareThread >= CPU_SETSIZE) {
+		return false;
+	}
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(hardwareThread, &cpuSet);
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+	return false;
+#endif
+}
+
 void threads::sleep(Time duration) {
 	if (duration <= Time()) {
 		std::this_thread::yield();
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <core/vertex_quantise.hpp>
+
+namespace le::quantise {
+namespace {
+f32 signNotZero(f32 value) noexcept {
+	return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+u8 toUnorm8(f32 value) noexcept {
+	return (u8)std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f);
+}
+
+// round `value` right shifted by `shift`, to nearest even
+u32 roundShift(u32 value, u32 shift) noexcept {
+	u32 const ret = value >> shift;
+	u32 const rem = value & ((1U << shift) - 1);
+	u32 const mid = 1U << (shift - 1);
+	return rem > mid || (rem == mid && (ret & 1)) ? ret + 1 : ret;
+}
+} // namespace
+
+Bounds bounds(glm::vec3 const& lo, glm::vec3 const& hi) noexcept {
+	Bounds ret;
+	ret.origin = lo;
+	for (glm::length_t axis = 0; axis < 3; ++axis) {
+		f32 const extent = hi[axis] - lo[axis];
+		ret.scale[axis] = extent > 0.0f ? extent : 1.0f;
+	}
+	return ret;
+}
+
+u16 toHalf(f32 value) noexcept {
+	u32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	u32 const sign = (bits >> 16) & 0x8000;
+	u32 const exponent = (bits >> 23) & 0xff;
+	u32 const mantissa = bits & 0x7fffff;
+	if (exponent == 0xff) {
+		// infinity / NaN (quiet)
+		return (u16)(sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0));
+	}
+	s32 const e = (s32)exponent - 127 + 15;
+	if (e >= 31) {
+		return (u16)(sign | 0x7c00);
+	}
+	if (e <= 0) {
+		if (e < -10) {
+			return (u16)sign;
+		}
+		// subnormal: restore the implicit bit
+		return (u16)(sign | roundShift(mantissa | 0x800000, (u32)(14 - e)));
+	}
+	// a carry out of the mantissa correctly increments the exponent
+	return (u16)(sign | roundShift(((u32)e << 23) | mantissa, 13));
+}
+
+f32 fromHalf(u16 half) noexcept {
+	u32 const sign = (u32)(half & 0x8000) << 16;
+	u32 const exponent = (half >> 10) & 0x1f;
+	u32 const mantissa = half & 0x3ff;
+	if (exponent == 0) {
+		f32 const ret = std::ldexp((f32)mantissa, -24);
+		return sign ? -ret : ret;
+	}
+	u32 const bits = exponent == 31 ? (sign | 0x7f800000 | (mantissa << 13)) : (sign | ((exponent + 112) << 23) | (mantissa << 13));
+	f32 ret;
+	std::memcpy(&ret, &bits, sizeof(ret));
+	return ret;
+}
+
+u16 toUnorm16(f32 value) noexcept {
+	return (u16)std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f);
+}
+
+f32 fromUnorm16(u16 value) noexcept {
+	return (f32)value / 65535.0f;
+}
+
+s16 toSnorm16(f32 value) noexcept {
+	return (s16)std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f);
+}
+
+f32 fromSnorm16(s16 value) noexcept {
+	return std::max((f32)value / 32767.0f, -1.0f);
+}
+
+glm::vec2 octEncode(glm::vec3 const& normal) noexcept {
+	f32 const l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+	if (l1 <= 0.0f) {
+		return {};
+	}
+	glm::vec2 const ret = {normal.x / l1, normal.y / l1};
+	if (normal.z < 0.0f) {
+		return {(1.0f - std::abs(ret.y)) * signNotZero(ret.x), (1.0f - std::abs(ret.x)) * signNotZero(ret.y)};
+	}
+	return ret;
+}
+
+glm::vec3 octDecode(glm::vec2 const& oct) noexcept {
+	glm::vec3 ret = {oct.x, oct.y, 1.0f - std::abs(oct.x) - std::abs(oct.y)};
+	if (ret.z < 0.0f) {
+		ret.x = (1.0f - std::abs(oct.y)) * signNotZero(oct.x);
+		ret.y = (1.0f - std::abs(oct.x)) * signNotZero(oct.y);
+	}
+	return ret * (1.0f / std::sqrt(glm::dot(ret, ret)));
+}
+
+PackedVertex pack(glm::vec3 const& position, glm::vec3 const& colour, glm::vec3 const& normal, glm::vec2 const& texCoord, Bounds const& bounds) noexcept {
+	PackedVertex ret;
+	for (glm::length_t axis = 0; axis < 3; ++axis) {
+		ret.position[axis] = toUnorm16((position[axis] - bounds.origin[axis]) / bounds.scale[axis]);
+		ret.colour[axis] = toUnorm8(colour[axis]);
+	}
+	ret.colour[3] = 0xff;
+	auto const oct = octEncode(normal);
+	ret.normal[0] = toSnorm16(oct.x);
+	ret.normal[1] = toSnorm16(oct.y);
+	ret.texCoord[0] = toHalf(texCoord.x);
+	ret.texCoord[1] = toHalf(texCoord.y);
+	return ret;
+}
+
+Unpacked unpack(PackedVertex const& vertex, Bounds const& bounds) noexcept {
+	Unpacked ret;
+	for (glm::length_t axis = 0; axis < 3; ++axis) {
+		ret.position[axis] = bounds.origin[axis] + fromUnorm16(vertex.position[axis]) * bounds.scale[axis];
+	}
+	ret.colour = glm::vec4(vertex.colour[0], vertex.colour[1], vertex.colour[2], vertex.colour[3]) * (1.0f / 255.0f);
+	ret.normal = octDecode({fromSnorm16(vertex.normal[0]), fromSnorm16(vertex.normal[1])});
+	ret.texCoord = {fromHalf(vertex.texCoord[0]), fromHalf(vertex.texCoord[1])};
+	return ret;
+}
+} // namespace le::quantise
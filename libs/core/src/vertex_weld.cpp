@@ -0,0 +1,78 @@
+#include <core/vertex_weld.hpp>
+
+namespace le::weld {
+namespace {
+constexpr std::size_t g_minSlots = 16;
+
+std::size_t slotCount(std::size_t expected) noexcept {
+	// load factor <= 0.5
+	std::size_t ret = g_minSlots;
+	while (ret < expected * 2) {
+		ret <<= 1;
+	}
+	return ret;
+}
+
+std::size_t hash(Corner const& corner) noexcept {
+	u64 ret = (u64)(u32)corner.position * 0x9e3779b97f4a7c15ULL;
+	ret ^= (u64)(u32)corner.normal * 0xc2b2ae3d27d4eb4fULL;
+	ret ^= (u64)(u32)corner.texCoord * 0x165667b19e3779f9ULL;
+	ret ^= ret >> 29;
+	return (std::size_t)(ret * 0xbf58476d1ce4e5b9ULL >> 32);
+}
+} // namespace
+
+Table::Table(std::size_t expected) : m_slots(slotCount(expected), 0) {
+	m_mask = m_slots.size() - 1;
+	m_keys.reserve(expected);
+}
+
+std::pair<u32, bool> Table::insert(Corner const& corner) {
+	if ((m_keys.size() + 1) * 2 > m_slots.size()) {
+		grow();
+	}
+	for (std::size_t slot = hash(corner) & m_mask;; slot = (slot + 1) & m_mask) {
+		u32 const entry = m_slots[slot];
+		if (entry == 0) {
+			m_keys.push_back(corner);
+			m_slots[slot] = (u32)m_keys.size();
+			return {(u32)m_keys.size() - 1, true};
+		}
+		if (m_keys[entry - 1] == corner) {
+			return {entry - 1, false};
+		}
+	}
+}
+
+std::vector<Corner> const& Table::keys() const noexcept {
+	return m_keys;
+}
+
+std::size_t Table::size() const noexcept {
+	return m_keys.size();
+}
+
+void Table::grow() {
+	m_slots.assign(m_slots.size() * 2, 0);
+	m_mask = m_slots.size() - 1;
+	for (std::size_t idx = 0; idx < m_keys.size(); ++idx) {
+		std::size_t slot = hash(m_keys[idx]) & m_mask;
+		while (m_slots[slot] != 0) {
+			slot = (slot + 1) & m_mask;
+		}
+		m_slots[slot] = (u32)idx + 1;
+	}
+}
+
+Result weld(Span<Corner> corners) {
+	Result ret;
+	// unique corners are usually well under the corner count (shared edges)
+	Table table(corners.extent / 2);
+	ret.indices.reserve(corners.extent);
+	for (auto const& corner : corners) {
+		ret.indices.push_back(table.insert(corner).first);
+	}
+	ret.vertices = table.keys();
+	return ret;
+}
+} // namespace le::weld
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <core/log.hpp>
+#include <core/os.hpp>
+#include <core/threads.hpp>
+#include <core/watcher.hpp>
+#if defined(LEVK_OS_LINUX)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace le::io {
+namespace {
+constexpr std::string_view g_tName = "watcher";
+
+struct Watched final {
+	std::vector<std::weak_ptr<std::atomic<bool>>> flags;
+	stdfs::file_time_type lastWriteTime = {};
+	Time changed;
+	// inotify watch descriptor of the parent directory (-1 if none)
+	int wd = -1;
+	bool bExists = false;
+};
+
+struct WatchedDir final {
+	stdfs::path path;
+	// number of watched files in this directory: the watch is removed when it drops to zero
+	u32 files = 0;
+};
+
+struct State final {
+	std::mutex mutex;
+	std::unordered_map<std::string, Watched> files;
+#if defined(LEVK_OS_LINUX)
+	std::unordered_map<int, WatchedDir> dirs;
+	int fd = -1;
+#endif
+	watcher::Config config;
+	std::atomic<bool> bWork = false;
+	threads::TScoped thread;
+};
+
+State g_state;
+
+std::string key(stdfs::path const& path) {
+	std::error_code errCode;
+	return stdfs::absolute(path, errCode).lexically_normal().generic_string();
+}
+
+// Called with mutex locked
+void markChanged(std::string const& path) {
+	if (auto search = g_state.files.find(path); search != g_state.files.end()) {
+		search->second.changed = Time::elapsed();
+	}
+}
+
+// Called with mutex locked
+void scan() {
+	for (auto& [path, watched] : g_state.files) {
+		std::error_code errCode;
+		bool const bExists = stdfs::is_regular_file(path, errCode);
+		auto const lastWriteTime = bExists ? stdfs::last_write_time(path, errCode) : stdfs::file_time_type();
+		if (bExists != watched.bExists || lastWriteTime != watched.lastWriteTime) {
+			watched.bExists = bExists;
+			watched.lastWriteTime = lastWriteTime;
+			watched.changed = Time::elapsed();
+		}
+	}
+}
+
+// Called with mutex locked
+void unwatchDir([[maybe_unused]] int wd) {
+#if defined(LEVK_OS_LINUX)
+	if (auto search = g_state.dirs.find(wd); search != g_state.dirs.end() && --search->second.files == 0) {
+		::inotify_rm_watch(g_state.fd, wd);
+		g_state.dirs.erase(search);
+	}
+#endif
+}
+
+// Called with mutex locked; returns true if any changes are still pending
+bool dispatch() {
+	bool bPending = false;
+	Time const now = Time::elapsed();
+	for (auto iter = g_state.files.begin(); iter != g_state.files.end();) {
+		auto& watched = iter->second;
+		if (watched.changed > Time() && now - watched.changed >= g_state.config.debounce) {
+			watched.changed = {};
+			std::size_t live = 0;
+			for (auto& wFlag : watched.flags) {
+				if (auto flag = wFlag.lock()) {
+					flag->store(true);
+					watched.flags[live++] = wFlag;
+				}
+			}
+			watched.flags.resize(live);
+			logD("[{}] [{}] changed", g_tName, iter->first);
+		}
+		bPending |= watched.changed > Time();
+		if (watched.flags.empty() || std::all_of(watched.flags.begin(), watched.flags.end(), [](auto const& wFlag) { return wFlag.expired(); })) {
+			unwatchDir(watched.wd);
+			iter = g_state.files.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+	return bPending;
+}
+
+#if defined(LEVK_OS_LINUX)
+void readEvents(Time timeout) {
+	alignas(inotify_event) char buffer[4096];
+	pollfd pfd = {g_state.fd, POLLIN, 0};
+	if (::poll(&pfd, 1, std::max(timeout.to_ms(), 1)) <= 0) {
+		return;
+	}
+	for (auto length = ::read(g_state.fd, buffer, sizeof(buffer)); length > 0; length = ::read(g_state.fd, buffer, sizeof(buffer))) {
+		std::scoped_lock lock(g_state.mutex);
+		for (char const* pData = buffer; pData < buffer + length;) {
+			auto const pEvent = reinterpret_cast<inotify_event const*>(pData);
+			if (pEvent->mask & IN_Q_OVERFLOW) {
+				// events lost: treat everything as changed
+				for (auto& [path, watched] : g_state.files) {
+					watched.changed = Time::elapsed();
+				}
+			} else if (pEvent->mask & IN_IGNORED) {
+				// watch removed by the kernel (directory deleted / unmounted): forget the descriptor (it may be reused)
+				if (g_state.dirs.erase(pEvent->wd) > 0) {
+					for (auto& [path, watched] : g_state.files) {
+						watched.wd = watched.wd == pEvent->wd ? -1 : watched.wd;
+					}
+				}
+			} else if (pEvent->len > 0) {
+				if (auto search = g_state.dirs.find(pEvent->wd); search != g_state.dirs.end()) {
+					markChanged((search->second.path / pEvent->name).generic_string());
+				}
+			}
+			pData += sizeof(inotify_event) + pEvent->len;
+		}
+	}
+}
+#endif
+} // namespace
+
+watcher::Service::Service(Config config) {
+	if (!init(config)) {
+		logE("[{}] Failed to initialise file watcher!", g_tName);
+	}
+}
+
+watcher::Service::~Service() {
+	deinit();
+}
+
+watcher::Flag watcher::watch(stdfs::path const& path) {
+	if (!g_state.bWork.load()) {
+		return {};
+	}
+	auto ret = std::make_shared<std::atomic<bool>>(false);
+	auto const id = key(path);
+	std::scoped_lock lock(g_state.mutex);
+	auto [iter, bNew] = g_state.files.emplace(id, Watched());
+	iter->second.flags.push_back(ret);
+	if (bNew) {
+		std::error_code errCode;
+		iter->second.bExists = stdfs::is_regular_file(id, errCode);
+		if (iter->second.bExists) {
+			iter->second.lastWriteTime = stdfs::last_write_time(id, errCode);
+		}
+#if defined(LEVK_OS_LINUX)
+		if (g_state.fd >= 0) {
+			auto const dir = stdfs::path(id).parent_path();
+			auto const mask = IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ATTRIB;
+			// returns the existing descriptor if directory is already watched
+			if (auto const wd = ::inotify_add_watch(g_state.fd, dir.string().data(), mask); wd >= 0) {
+				auto& watchedDir = g_state.dirs[wd];
+				watchedDir.path = dir;
+				++watchedDir.files;
+				iter->second.wd = wd;
+			} else {
+				logW("[{}] Failed to watch directory [{}]", g_tName, dir.generic_string());
+			}
+		}
+#endif
+	}
+	return ret;
+}
+
+bool watcher::active() {
+	return g_state.bWork.load();
+}
+
+bool watcher::native() {
+#if defined(LEVK_OS_LINUX)
+	return g_state.fd >= 0;
+#else
+	return false;
+#endif
+}
+
+bool watcher::init(Config config) {
+	if (g_state.bWork.load()) {
+		return false;
+	}
+	g_state.config = config;
+#if defined(LEVK_OS_LINUX)
+	if (!config.bForcePoll) {
+		g_state.fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		logW_if(g_state.fd < 0, "[{}] inotify unavailable, falling back to polling", g_tName);
+	}
+#endif
+	g_state.bWork.store(true);
+	g_state.thread = threads::newThread([]() {
+		threads::setName("levk-watcher");
+		bool bPending = false;
+		while (g_state.bWork.load()) {
+			if (native()) {
+#if defined(LEVK_OS_LINUX)
+				// idle: block on events (bounded to remain responsive to deinit)
+				readEvents(bPending ? g_state.config.debounce : Time(500ms));
+#endif
+			} else {
+				threads::sleep(g_state.config.pollInterval);
+				std::scoped_lock lock(g_state.mutex);
+				scan();
+			}
+			std::scoped_lock lock(g_state.mutex);
+			bPending = dispatch();
+		}
+	});
+	logI("[{}] Watching files via [{}]", g_tName, native() ? "inotify" : "polling");
+	return true;
+}
+
+void watcher::deinit() {
+	if (g_state.bWork.load()) {
+		g_state.bWork.store(false);
+		g_state.thread = {};
+#if defined(LEVK_OS_LINUX)
+		if (g_state.fd >= 0) {
+			::close(g_state.fd);
+			g_state.fd = -1;
+		}
+		g_state.dirs.clear();
+#endif
+		g_state.files.clear();
+	}
+}
+} // namespace le::io
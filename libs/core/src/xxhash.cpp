@@ -0,0 +1,109 @@
+#include <cstring>
+#include <core/xxhash.hpp>
+
+namespace le {
+namespace {
+constexpr u64 p1 = 0x9E3779B185EBCA87;
+constexpr u64 p2 = 0xC2B2AE3D27D4EB4F;
+constexpr u64 p3 = 0x165667B19E3779F9;
+constexpr u64 p4 = 0x85EBCA77C2B2AE63;
+constexpr u64 p5 = 0x27D4EB2F165667C5;
+
+constexpr u64 rotl(u64 x, s32 r) noexcept {
+	return (x << r) | (x >> (64 - r));
+}
+
+// little endian targets only
+u64 read64(u8 const* pData) noexcept {
+	u64 ret;
+	std::memcpy(&ret, pData, sizeof(ret));
+	return ret;
+}
+
+u32 read32(u8 const* pData) noexcept {
+	u32 ret;
+	std::memcpy(&ret, pData, sizeof(ret));
+	return ret;
+}
+
+constexpr u64 round(u64 acc, u64 input) noexcept {
+	acc += input * p2;
+	return rotl(acc, 31) * p1;
+}
+
+constexpr u64 merge(u64 acc, u64 val) noexcept {
+	acc ^= round(0, val);
+	return acc * p1 + p4;
+}
+} // namespace
+
+XXH64::XXH64(u64 seed) noexcept : m_acc({seed + p1 + p2, seed + p2, seed, seed - p1}), m_buffer{}, m_seed(seed) {
+}
+
+u64 XXH64::hash(void const* pData, std::size_t size, u64 seed) noexcept {
+	return XXH64(seed).update(pData, size).digest();
+}
+
+XXH64& XXH64::update(void const* pData, std::size_t size) noexcept {
+	auto pIn = static_cast<u8 const*>(pData);
+	m_total += size;
+	if (m_buffered + size < m_buffer.size()) {
+		std::memcpy(m_buffer.data() + m_buffered, pIn, size);
+		m_buffered += size;
+		return *this;
+	}
+	if (m_buffered > 0) {
+		std::size_t const fill = m_buffer.size() - m_buffered;
+		std::memcpy(m_buffer.data() + m_buffered, pIn, fill);
+		for (std::size_t lane = 0; lane < 4; ++lane) {
+			m_acc[lane] = round(m_acc[lane], read64(m_buffer.data() + lane * 8));
+		}
+		pIn += fill;
+		size -= fill;
+		m_buffered = 0;
+	}
+	for (; size >= 32; pIn += 32, size -= 32) {
+		for (std::size_t lane = 0; lane < 4; ++lane) {
+			m_acc[lane] = round(m_acc[lane], read64(pIn + lane * 8));
+		}
+	}
+	std::memcpy(m_buffer.data(), pIn, size);
+	m_buffered = size;
+	return *this;
+}
+
+u64 XXH64::digest() const noexcept {
+	u64 ret;
+	if (m_total >= 32) {
+		ret = rotl(m_acc[0], 1) + rotl(m_acc[1], 7) + rotl(m_acc[2], 12) + rotl(m_acc[3], 18);
+		for (auto const acc : m_acc) {
+			ret = merge(ret, acc);
+		}
+	} else {
+		ret = m_seed + p5;
+	}
+	ret += m_total;
+	u8 const* pIn = m_buffer.data();
+	std::size_t size = m_buffered;
+	for (; size >= 8; pIn += 8, size -= 8) {
+		ret ^= round(0, read64(pIn));
+		ret = rotl(ret, 27) * p1 + p4;
+	}
+	if (size >= 4) {
+		ret ^= (u64)read32(pIn) * p1;
+		ret = rotl(ret, 23) * p2 + p3;
+		pIn += 4;
+		size -= 4;
+	}
+	for (; size > 0; ++pIn, --size) {
+		ret ^= (u64)(*pIn) * p5;
+		ret = rotl(ret, 11) * p1;
+	}
+	ret ^= ret >> 33;
+	ret *= p2;
+	ret ^= ret >> 29;
+	ret *= p3;
+	ret ^= ret >> 32;
+	return ret;
+}
+} // namespace le
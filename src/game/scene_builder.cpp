@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <core/mesh_simplifier.hpp>
 #include <core/transform.hpp>
 #include <engine/game/scene_builder.hpp>
 #include <engine/levk.hpp>
@@ -76,6 +78,30 @@ std::vector<res::Mesh> UIComponent::meshes() const {
 
 SceneBuilder::~SceneBuilder() = default;
 
+std::vector<u8> SceneBuilder::lods(Span<res::Mesh> meshes, Transform const& transform, gfx::Camera const& camera, f32 maxError) {
+	std::vector<u8> ret;
+	if (maxError <= 0.0f) {
+		return ret;
+	}
+	glm::mat4 const model = transform.model();
+	glm::vec3 const s = glm::abs(transform.worldScale());
+	f32 const scale = std::max(s.x, std::max(s.y, s.z));
+	for (auto const& mesh : meshes) {
+		auto const& info = mesh.info();
+		u8 lod = 0;
+		if (info.lodErrors.size() > 1) {
+			glm::vec3 const centre = glm::vec3(model * glm::vec4(info.centre, 1.0f));
+			f32 const size = meshopt::screenSize(info.radius * scale, glm::length(centre - camera.position), glm::radians(camera.fov));
+			lod = (u8)meshopt::selectLod(info.lodErrors, size, maxError);
+		}
+		ret.push_back(lod);
+	}
+	if (std::all_of(ret.begin(), ret.end(), [](u8 lod) { return lod == 0; })) {
+		ret.clear();
+	}
+	return ret;
+}
+
 gfx::render::Driver::Scene SceneBuilder::build(gfx::Camera const& camera, Registry const& registry) const {
 	gfx::render::Driver::Scene scene;
 	gfx::render::Driver::Batch batch3D;
@@ -109,7 +135,9 @@ gfx::render::Driver::Scene SceneBuilder::build(gfx::Camera const& camera, Regist
 		auto view = registry.view<Transform, res::Model>();
 		for (auto& [entity, query] : view) {
 			if (auto& [transform, model] = query; model.status() == res::Status::eReady) {
-				batch3D.drawables.push_back({model.meshes(), transform, pipe3D});
+				auto meshes = model.meshes();
+				auto meshLods = lods(meshes, transform, camera, m_lodError);
+				batch3D.drawables.push_back({std::move(meshes), transform, pipe3D, std::move(meshLods)});
 			}
 		}
 	}
@@ -117,7 +145,7 @@ gfx::render::Driver::Scene SceneBuilder::build(gfx::Camera const& camera, Regist
 		auto view = registry.view<Transform, res::Mesh>();
 		for (auto& [entity, query] : view) {
 			if (auto& [transform, mesh] = query; mesh.status() == res::Status::eReady) {
-				batch3D.drawables.push_back({{mesh}, transform, pipe3D});
+				batch3D.drawables.push_back({{mesh}, transform, pipe3D, lods(mesh, transform, camera, m_lodError)});
 			}
 		}
 	}
@@ -143,6 +143,7 @@ struct Image final : VkResource
 	vk::Image image;
 	vk::DeviceSize allocatedSize = {};
 	vk::Extent3D extent = {};
+	u32 mipLevels = 1;
 };
 
 struct LayoutTransition final
@@ -157,6 +158,7 @@ struct ImageViewInfo final
 	vk::Format format;
 	vk::ImageAspectFlags aspectFlags = vk::ImageAspectFlagBits::eColor;
 	vk::ImageViewType type = vk::ImageViewType::e2D;
+	u32 mipLevels = 1;
 };
 
 struct RenderImage final
@@ -450,7 +450,7 @@ vk::ImageView Device::createImageView(ImageViewInfo const& info) {
 	createInfo.components.r = createInfo.components.g = createInfo.components.b = createInfo.components.a = vk::ComponentSwizzle::eIdentity;
 	createInfo.subresourceRange.aspectMask = info.aspectFlags;
 	createInfo.subresourceRange.baseMipLevel = 0;
-	createInfo.subresourceRange.levelCount = 1;
+	createInfo.subresourceRange.levelCount = info.mipLevels;
 	createInfo.subresourceRange.baseArrayLayer = 0;
 	createInfo.subresourceRange.layerCount = info.type == vk::ImageViewType::eCube ? 6 : 1;
 	return device.createImageView(createInfo);
@@ -180,8 +180,9 @@ bool PipelineImpl::create() {
 namespace {
 std::unordered_map<std::size_t, PipelineImpl> g_implMap;
 
-std::size_t pipeHash(Pipeline const& pipe, vk::Format colour, vk::Format depth) {
+std::size_t pipeHash(Pipeline const& pipe, vk::Format colour, vk::Format depth, VertexFormat format) {
 	std::size_t hash = 0;
+	hash ^= (std::size_t)format << 8;
 	hash ^= pipe.shader.guid;
 	hash ^= (std::size_t)pipe.lineWidth;
 	hash ^= pipe.flags.bits.to_ulong();
@@ -193,8 +194,8 @@ std::size_t pipeHash(Pipeline const& pipe, vk::Format colour, vk::Format depth)
 }
 } // namespace
 
-PipelineImpl& pipes::find(Pipeline const& pipe, RenderPass const& renderPass) {
-	auto const hash = pipeHash(pipe, renderPass.colour, renderPass.depth);
+PipelineImpl& pipes::find(Pipeline const& pipe, RenderPass const& renderPass, VertexFormat format) {
+	auto const hash = pipeHash(pipe, renderPass.colour, renderPass.depth, format);
 	auto search = g_implMap.find(hash);
 	if (search != g_implMap.end()) {
 		search->second.update(renderPass);
@@ -202,8 +203,8 @@ PipelineImpl& pipes::find(Pipeline const& pipe, RenderPass const& renderPass) {
 	}
 	auto& ret = g_implMap[hash];
 	PipelineImpl::Info implInfo;
-	implInfo.vertexBindings = rd::vbo::vertexBindings();
-	implInfo.vertexAttributes = rd::vbo::vertexAttributes();
+	implInfo.vertexBindings = rd::vbo::vertexBindings(format);
+	implInfo.vertexAttributes = rd::vbo::vertexAttributes(format);
 	implInfo.pushConstantRanges = rd::PushConstants::ranges();
 	implInfo.renderPass = renderPass.renderPass;
 	implInfo.polygonMode = (vk::PolygonMode)pipe.polygonMode;
@@ -211,6 +212,12 @@ PipelineImpl& pipes::find(Pipeline const& pipe, RenderPass const& renderPass) {
 	implInfo.frontFace = (vk::FrontFace)pipe.frontFace;
 	implInfo.staticLineWidth = pipe.lineWidth;
 	implInfo.shader = pipe.shader;
+	if (format == VertexFormat::ePacked) {
+		// variant loaded alongside the shader, eg "shaders/default_packed"
+		auto const baseID = pipe.shader.guid == res::GUID::null ? std::string("shaders/default") : pipe.shader.info().id.generic_string();
+		implInfo.shaderID = baseID + "_packed";
+		implInfo.shader = {};
+	}
 	implInfo.flags = pipe.flags;
 	ret.create(implInfo);
 	return ret;
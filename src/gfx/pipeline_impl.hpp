@@ -57,7 +57,11 @@ class PipelineImpl final {
 };
 
 namespace pipes {
-PipelineImpl& find(Pipeline const& pipe, RenderPass const& renderPass);
+///
+/// \brief Obtain (or create) the pipeline for `pipe` in `renderPass`, with vertex input (and shader variant) for `format`
+/// ePacked uses the shader variant loaded as `<pipe.shader ID>_packed`
+///
+PipelineImpl& find(Pipeline const& pipe, RenderPass const& renderPass, VertexFormat format = VertexFormat::eFull);
 void deinit();
 } // namespace pipes
 } // namespace le::gfx
@@ -314,6 +314,7 @@ render::PCDeq render::write(FrameSync& out_frame, Driver::Scene& out_scene, TexC
 	specular.add(*black);
 	bool bSkybox = false;
 	res::Texture cubemap = *blank;
+	res::touch(out_scene.view.skybox.cubemap);
 	if (out_scene.view.skybox.cubemap.status() == res::Status::eReady) {
 		out_scene.view.skybox.pipeline.flags.reset(gfx::Pipeline::Flag::eDepthWrite);
 		auto mesh = res::find<res::Mesh>("meshes/cube");
@@ -325,14 +326,22 @@ render::PCDeq render::write(FrameSync& out_frame, Driver::Scene& out_scene, TexC
 	u32 objectID = 0;
 	for (auto& batch : out_scene.batches) {
 		push.push_back({});
-		for (auto& [meshes, t, _] : batch.drawables) {
+		for (auto& [meshes, t, _, lods] : batch.drawables) {
 			ENSURE(!meshes.empty(), "Mesh is null!");
 			Transform const& transform = t;
 			for (auto mesh : meshes) {
+				res::touch(mesh);
 				auto const& info = res::info(mesh);
 				rd::PushConstants pc;
 				pc.objectID = objectID;
-				ssbos.models.ssbo.push_back(transform.model());
+				auto pImpl = res::impl(mesh);
+				if (pImpl && info.vertexFormat == VertexFormat::ePacked) {
+					// packed positions are unorm within the mesh bounds
+					auto const dequantise = glm::scale(glm::translate(glm::mat4(1.0f), pImpl->bounds.origin), pImpl->bounds.scale);
+					ssbos.models.ssbo.push_back(transform.model() * dequantise);
+				} else {
+					ssbos.models.ssbo.push_back(transform.model());
+				}
 				ssbos.normals.ssbo.push_back(transform.normalModel());
 				ssbos.materials.ssbo.push_back({info.material.material.info(), info.material.dropColour});
 				ssbos.tints.ssbo.push_back(info.material.tint.toVec4());
@@ -355,6 +364,8 @@ render::PCDeq render::write(FrameSync& out_frame, Driver::Scene& out_scene, TexC
 				}
 				if (info.material.flags.test(res::Material::Flag::eTextured)) {
 					ssbos.flags.ssbo[objectID] |= rd::Flags::eTEXTURED;
+					res::touch(info.material.diffuse);
+					res::touch(info.material.specular);
 					if (info.material.diffuse.status() == res::Status::eReady) {
 						pc.diffuseID = diffuse.add(info.material.diffuse);
 					} else {
@@ -405,20 +416,27 @@ u64 render::pass(PassInfo const& info) {
 		auto const vp = batch.bIgnoreGameView ? batch.viewport : batch.viewport.adjust(info.view);
 		auto const sc = batch.bIgnoreGameView ? batch.scissor : batch.scissor.adjust(info.view);
 		cmd.setViewportScissor(viewport(context.m_swapchain.extent, vp), scissor(context.m_swapchain.extent, sc));
-		for (auto& [meshes, pTransform, pipe] : batch.drawables) {
-			for (auto mesh : meshes) {
+		for (auto& [meshes, pTransform, pipe, lods] : batch.drawables) {
+			for (std::size_t meshIdx = 0; meshIdx < meshes.size(); ++meshIdx) {
+				auto const mesh = meshes[meshIdx];
 				auto const& meshInfo = res::info(mesh);
 				auto pImpl = res::impl(mesh);
 				if (pImpl && mesh.status() == res::Status::eReady && meshInfo.triCount > 0) {
-					tris += meshInfo.triCount;
-					auto const& impl = pipes::find(pipe, info.pass);
+					auto const& impl = pipes::find(pipe, info.pass, meshInfo.vertexFormat);
 					std::vector const sets = {frame.set.m_bufferSet, frame.set.m_samplerSet};
 					cmd.bindResources<rd::PushConstants>(impl, sets, vkFlags::vertFragShader, 0, push[batchIdx][drawableIdx]);
 					cmd.bindVertexBuffers(0, pImpl->vbo.buffer.buffer, (vk::DeviceSize)0);
 					if (pImpl->ibo.count > 0) {
-						cmd.bindIndexBuffer(pImpl->ibo.buffer.buffer, 0, vk::IndexType::eUint32);
-						cmd.drawIndexed(pImpl->ibo.count, 1, 0, 0, 0);
+						res::Mesh::Impl::Lod lod = {0, pImpl->ibo.count};
+						if (!pImpl->lods.empty()) {
+							std::size_t const level = meshIdx < lods.size() ? (std::size_t)lods[meshIdx] : 0;
+							lod = pImpl->lods[std::min(level, pImpl->lods.size() - 1)];
+						}
+						tris += (u64)lod.count / 3;
+						cmd.bindIndexBuffer(pImpl->ibo.buffer.buffer, 0, pImpl->ibo.indexType);
+						cmd.drawIndexed(lod.count, 1, lod.first, 0, 0);
 					} else {
+						tris += meshInfo.triCount;
 						cmd.draw(pImpl->vbo.count, 1, 0, 0);
 					}
 				}
@@ -1,4 +1,5 @@
 #include <core/log.hpp>
+#include <core/vertex_quantise.hpp>
 #include <engine/resources/resources.hpp>
 #include <gfx/device.hpp>
 #include <gfx/resource_descriptors.hpp>
@@ -7,16 +8,44 @@
 
 namespace le::gfx {
 namespace rd {
-std::vector<vk::VertexInputBindingDescription> vbo::vertexBindings() {
+std::vector<vk::VertexInputBindingDescription> vbo::vertexBindings(VertexFormat format) {
 	vk::VertexInputBindingDescription ret;
 	ret.binding = vertexBinding;
-	ret.stride = sizeof(Vertex);
+	ret.stride = format == VertexFormat::ePacked ? sizeof(quantise::PackedVertex) : sizeof(Vertex);
 	ret.inputRate = vk::VertexInputRate::eVertex;
 	return {ret};
 }
 
-std::vector<vk::VertexInputAttributeDescription> vbo::vertexAttributes() {
+std::vector<vk::VertexInputAttributeDescription> vbo::vertexAttributes(VertexFormat format) {
 	std::vector<vk::VertexInputAttributeDescription> ret;
+	if (format == VertexFormat::ePacked) {
+		// same locations as eFull: positions are dequantised via the model matrix, normals decoded in the shader variant
+		vk::VertexInputAttributeDescription pos;
+		pos.binding = vertexBinding;
+		pos.location = 0;
+		pos.format = vk::Format::eR16G16B16A16Unorm;
+		pos.offset = offsetof(quantise::PackedVertex, position);
+		ret.push_back(pos);
+		vk::VertexInputAttributeDescription col;
+		col.binding = vertexBinding;
+		col.location = 1;
+		col.format = vk::Format::eR8G8B8A8Unorm;
+		col.offset = offsetof(quantise::PackedVertex, colour);
+		ret.push_back(col);
+		vk::VertexInputAttributeDescription norm;
+		norm.binding = vertexBinding;
+		norm.location = 2;
+		norm.format = vk::Format::eR16G16Snorm;
+		norm.offset = offsetof(quantise::PackedVertex, normal);
+		ret.push_back(norm);
+		vk::VertexInputAttributeDescription uv;
+		uv.binding = vertexBinding;
+		uv.location = 3;
+		uv.format = vk::Format::eR16G16Sfloat;
+		uv.offset = offsetof(quantise::PackedVertex, texCoord);
+		ret.push_back(uv);
+		return ret;
+	}
 	vk::VertexInputAttributeDescription pos;
 	pos.binding = vertexBinding;
 	pos.location = 0;
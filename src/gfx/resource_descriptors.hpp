@@ -19,8 +19,8 @@ namespace rd {
 namespace vbo {
 inline constexpr u32 vertexBinding = 0;
 
-std::vector<vk::VertexInputBindingDescription> vertexBindings();
-std::vector<vk::VertexInputAttributeDescription> vertexAttributes();
+std::vector<vk::VertexInputBindingDescription> vertexBindings(VertexFormat format = VertexFormat::eFull);
+std::vector<vk::VertexInputAttributeDescription> vertexAttributes(VertexFormat format = VertexFormat::eFull);
 } // namespace vbo
 
 // UBO
@@ -1,12 +1,14 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
-#include <list>
+#include <iterator>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include <fmt/format.h>
 #include <core/ensure.hpp>
 #include <core/log.hpp>
+#include <core/ring_allocator.hpp>
 #include <core/tasks.hpp>
 #include <core/threads.hpp>
 #include <gfx/device.hpp>
@@ -21,17 +23,15 @@ namespace {
 enum class ResourceType { eBuffer, eImage, eCOUNT_ };
 
 struct Batch final {
-	struct Stage final {
-		Buffer buffer;
-		vk::CommandBuffer command;
-	};
-
 	using Promise = std::shared_ptr<std::promise<void>>;
-	using Entry = std::pair<Stage, Promise>;
 
-	std::vector<Entry> entries;
+	std::vector<Promise> promises;
+	// Dedicated staging buffers for uploads that did not fit in the ring
+	std::vector<Buffer> overflow;
+	vk::CommandBuffer command;
 	vk::Fence done;
-	u8 framePad = 0;
+	// Ring bytes consumed by this batch
+	u64 staged = 0;
 };
 
 std::string const s_tName = utils::tName<VRAM>();
@@ -47,21 +47,25 @@ constexpr vk::DeviceSize operator""_MB(unsigned long long size) {
 	return fmt::format("Buffers: [{:.2f}{}]; Images: [{:.2f}{}]", bufferSize, bufferUnit, imageSize, imageUnit);
 }
 
-constexpr std::array<engine::MemRange, 3> const g_stagingReserve = {{{256_MB, 1}, {64_MB, 2}, {8_MB, 4}}};
+constexpr std::array<engine::MemRange, 1> const g_stagingReserve = {{{256_MB, 1}}};
+// Covers copyBufferToImage offset requirements of all (including block compressed) formats
+constexpr vk::DeviceSize g_stagingAlignment = 16;
 
 namespace tfr {
 struct {
 	vk::CommandPool pool;
 	std::vector<vk::CommandBuffer> commands;
 	std::vector<vk::Fence> fences;
-	std::list<Buffer> buffers;
-
-	void scavenge(Batch::Stage const& stage, vk::Fence fence) {
-		commands.push_back(stage.command);
-		buffers.push_back(stage.buffer);
-		if (std::find(fences.begin(), fences.end(), fence) == fences.end()) {
-			g_device.resetFence(fence);
-			fences.push_back(fence);
+	Buffer ring;
+	RingAllocator allocator;
+
+	void scavenge(Batch const& batch) {
+		commands.push_back(batch.command);
+		g_device.resetFence(batch.done);
+		fences.push_back(batch.done);
+		allocator.release(batch.staged);
+		for (auto const& buffer : batch.overflow) {
+			vram::release(buffer);
 		}
 	}
 } g_resources;
@@ -78,17 +82,17 @@ struct {
 
 kt::async_queue<std::function<void()>> g_queue;
 
-constexpr vk::DeviceSize ceilPOT(vk::DeviceSize size) {
-	vk::DeviceSize ret = 2;
-	while (ret < size) {
-		ret <<= 1;
-	}
-	return ret;
-}
+struct Region final {
+	vk::Buffer buffer;
+	vk::DeviceSize offset = 0;
+	void* pMap = nullptr;
+	u64 consumed = 0;
+	std::optional<Buffer> overflow;
+};
 
 Buffer createStagingBuffer(vk::DeviceSize size) {
 	BufferInfo info;
-	info.size = ceilPOT(size);
+	info.size = size;
 	info.properties = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
 	info.usage = vk::BufferUsageFlagBits::eTransferSrc;
 	info.queueFlags = QFlag::eGraphics | QFlag::eTransfer;
@@ -100,20 +104,32 @@ Buffer createStagingBuffer(vk::DeviceSize size) {
 	return vram::createBuffer(info);
 }
 
-Buffer nextBuffer(vk::DeviceSize size) {
-	auto lock = g_sync.mutex.lock();
-	for (auto iter = g_resources.buffers.begin(); iter != g_resources.buffers.end(); ++iter) {
-		auto buffer = *iter;
-		if (buffer.writeSize >= size) {
-			g_resources.buffers.erase(iter);
-			return buffer;
+///
+/// \brief Sub-allocate `size` bytes of mapped staging memory (transfer thread only)
+///
+Region reserve(vk::DeviceSize size) {
+	{
+		auto lock = g_sync.mutex.lock();
+		if (auto block = g_resources.allocator.allocate(size)) {
+			return {g_resources.ring.buffer, block->offset, (u8*)g_resources.ring.pMap + block->offset, block->consumed, std::nullopt};
 		}
 	}
-	return createStagingBuffer(size);
+	// ring exhausted (or too small): fall back to a dedicated buffer, released along with its batch
+	auto [bytes, unit] = utils::friendlySize(size);
+	logD("[{}] Staging ring full, allocating dedicated buffer: [{:.2f}{}]", s_tName, bytes, unit);
+	Region ret;
+	auto buffer = createStagingBuffer(size);
+	if (vram::mapMemory(buffer)) {
+		ret.buffer = buffer.buffer;
+		ret.pMap = buffer.pMap;
+		ret.overflow = buffer;
+	} else {
+		vram::release(buffer);
+	}
+	return ret;
 }
 
 vk::CommandBuffer nextCommand() {
-	auto lock = g_sync.mutex.lock();
 	if (!g_resources.commands.empty()) {
 		auto ret = g_resources.commands.back();
 		g_resources.commands.pop_back();
@@ -134,16 +150,25 @@ vk::Fence nextFence() {
 	return g_device.createFence(false);
 }
 
-Batch::Stage newStage(vk::DeviceSize bufferSize) {
-	Batch::Stage ret;
-	ret.command = nextCommand();
-	ret.buffer = nextBuffer(bufferSize);
-	return ret;
-}
-
-void addStage(Batch::Stage&& stage, Batch::Promise&& promise) {
+///
+/// \brief Record commands via `func(vk::CommandBuffer)` into the active batch, which owns `region` from then on
+///
+template <typename F>
+void record(Batch::Promise&& promise, Region const& region, F func) {
 	auto lock = g_sync.mutex.lock();
-	g_batches.active.entries.emplace_back(std::move(stage), std::move(promise));
+	auto& batch = g_batches.active;
+	if (batch.command == vk::CommandBuffer()) {
+		batch.command = nextCommand();
+		vk::CommandBufferBeginInfo beginInfo;
+		beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+		batch.command.begin(beginInfo);
+	}
+	func(batch.command);
+	batch.staged += region.consumed;
+	if (region.overflow) {
+		batch.overflow.push_back(*region.overflow);
+	}
+	batch.promises.push_back(std::move(promise));
 }
 
 void init(Span<engine::MemRange> stagingReserve) {
@@ -153,17 +178,19 @@ void init(Span<engine::MemRange> stagingReserve) {
 		poolInfo.queueFamilyIndex = g_device.queues.transfer.familyIndex;
 		g_resources.pool = g_device.device.createCommandPool(poolInfo);
 	}
+	vk::DeviceSize ringSize = 0;
+	for (auto const& range : stagingReserve) {
+		ringSize += range.size * range.count;
+	}
+	ringSize = std::max(ringSize, g_stagingAlignment);
+	g_resources.ring = createStagingBuffer(ringSize);
+	[[maybe_unused]] bool const bMapped = vram::mapMemory(g_resources.ring);
+	ENSURE(bMapped, "Memory map failed");
+	g_resources.allocator = RingAllocator(ringSize, g_stagingAlignment);
 	g_queue.active(true);
-	g_sync.thread = threads::newThread([stagingReserve]() {
-		{
-			auto lock = g_sync.mutex.lock();
-			for (auto const& range : stagingReserve) {
-				for (auto i = range.count; i > 0; --i) {
-					g_resources.buffers.push_back(createStagingBuffer(range.size));
-				}
-			}
-		}
-		logI("[{}] Transfer thread initialised", s_tName);
+	g_sync.thread = threads::newThread([ringSize]() {
+		auto const [size, unit] = utils::friendlySize(ringSize);
+		logI("[{}] Transfer thread initialised; staging ring: [{:.2f}{}]", s_tName, size, unit);
 		while (auto f = g_queue.pop()) {
 			(*f)();
 		}
@@ -171,31 +198,22 @@ void init(Span<engine::MemRange> stagingReserve) {
 }
 
 void update() {
-	auto removeDone = [](Batch& batch) -> bool {
-		if (g_device.isSignalled(batch.done)) {
-			if (batch.framePad == 0) {
-				for (auto& [stage, promise] : batch.entries) {
-					promise->set_value();
-					tfr::g_resources.scavenge(stage, batch.done);
-				}
-				return true;
-			}
-			--batch.framePad;
-		}
-		return false;
-	};
 	auto lock = g_sync.mutex.lock();
-	g_batches.submitted.erase(std::remove_if(g_batches.submitted.begin(), g_batches.submitted.end(), removeDone), g_batches.submitted.end());
-	if (!g_batches.active.entries.empty()) {
-		std::vector<vk::CommandBuffer> commands;
-		commands.reserve(g_batches.active.entries.size());
-		g_batches.active.done = nextFence();
-		for (auto& [stage, _] : g_batches.active.entries) {
-			commands.push_back(stage.command);
+	// ring memory is released in submission order (the fence signals once the transfer has finished reading it)
+	auto iter = g_batches.submitted.begin();
+	for (; iter != g_batches.submitted.end() && g_device.isSignalled(iter->done); ++iter) {
+		for (auto& promise : iter->promises) {
+			promise->set_value();
 		}
+		g_resources.scavenge(*iter);
+	}
+	g_batches.submitted.erase(g_batches.submitted.begin(), iter);
+	if (g_batches.active.command != vk::CommandBuffer()) {
+		g_batches.active.command.end();
+		g_batches.active.done = nextFence();
 		vk::SubmitInfo submitInfo;
-		submitInfo.commandBufferCount = (u32)commands.size();
-		submitInfo.pCommandBuffers = commands.data();
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &g_batches.active.command;
 		g_device.queues.transfer.queue.submit(submitInfo, g_batches.active.done);
 		g_batches.submitted.push_back(std::move(g_batches.active));
 	}
@@ -211,22 +229,19 @@ void deinit() {
 	logI("[{}] Transfer thread terminated", s_tName);
 	g_device.waitIdle();
 	g_device.destroy(g_resources.pool);
-	std::vector<std::shared_ptr<tasks::Handle>> tasks;
 	for (auto& fence : g_resources.fences) {
 		g_device.destroy(fence);
 	}
-	for (auto& [stage, _] : g_batches.active.entries) {
-		tasks.push_back(tasks::enqueue([buffer = stage.buffer]() { vram::release(buffer); }, ""));
-	}
-	for (auto& buffer : g_resources.buffers) {
-		tasks.push_back(tasks::enqueue([buffer]() { vram::release(buffer); }, ""));
-	}
+	std::vector<Buffer> buffers = std::move(g_batches.active.overflow);
 	for (auto& batch : g_batches.submitted) {
-		for (auto& [stage, _] : batch.entries) {
-			tasks.push_back(tasks::enqueue([buffer = stage.buffer]() { vram::release(buffer); }, ""));
-		}
+		std::move(batch.overflow.begin(), batch.overflow.end(), std::back_inserter(buffers));
 		g_device.destroy(batch.done);
 	}
+	buffers.push_back(g_resources.ring);
+	std::vector<std::shared_ptr<tasks::Handle>> tasks;
+	for (auto& buffer : buffers) {
+		tasks.push_back(tasks::enqueue([buffer]() { vram::release(buffer); }, ""));
+	}
 	g_resources = {};
 	g_batches = {};
 	tasks::wait(tasks);
@@ -369,15 +384,11 @@ std::future<void> vram::copy(Buffer const& src, Buffer& out_dst, vk::DeviceSize
 	auto promise = std::make_shared<Batch::Promise::element_type>();
 	auto ret = promise->get_future();
 	auto f = [promise, &src, &out_dst, size]() mutable {
-		auto stage = tfr::newStage(size);
-		vk::CommandBufferBeginInfo beginInfo;
-		beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
-		stage.command.begin(beginInfo);
-		vk::BufferCopy copyRegion;
-		copyRegion.size = size;
-		stage.command.copyBuffer(src.buffer, out_dst.buffer, copyRegion);
-		stage.command.end();
-		tfr::addStage(std::move(stage), std::move(promise));
+		tfr::record(std::move(promise), {}, [&src, &out_dst, size](vk::CommandBuffer command) {
+			vk::BufferCopy copyRegion;
+			copyRegion.size = size;
+			command.copyBuffer(src.buffer, out_dst.buffer, copyRegion);
+		});
 	};
 	tfr::g_queue.push(std::move(f));
 	return ret;
@@ -398,16 +409,15 @@ std::future<void> vram::stage(Buffer& out_deviceBuffer, void const* pData, vk::D
 	auto promise = std::make_shared<Batch::Promise::element_type>();
 	auto ret = promise->get_future();
 	auto f = [promise, &out_deviceBuffer, pData, size]() mutable {
-		auto stage = tfr::newStage(size);
-		if (write(stage.buffer, pData, size)) {
-			vk::CommandBufferBeginInfo beginInfo;
-			beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
-			stage.command.begin(beginInfo);
-			vk::BufferCopy copyRegion;
-			copyRegion.size = size;
-			stage.command.copyBuffer(stage.buffer.buffer, out_deviceBuffer.buffer, copyRegion);
-			stage.command.end();
-			tfr::addStage(std::move(stage), std::move(promise));
+		auto const region = tfr::reserve(size);
+		if (region.pMap) {
+			std::memcpy(region.pMap, pData, size);
+			tfr::record(std::move(promise), region, [&region, &out_deviceBuffer, size](vk::CommandBuffer command) {
+				vk::BufferCopy copyRegion;
+				copyRegion.srcOffset = region.offset;
+				copyRegion.size = size;
+				command.copyBuffer(region.buffer, out_deviceBuffer.buffer, copyRegion);
+			});
 		} else {
 			logE("[{}] Error staging data!", s_tName);
 			promise->set_value();
@@ -436,6 +446,7 @@ Image vram::createImage(ImageInfo const& info) {
 		throw std::runtime_error("Allocation error");
 	}
 	ret.extent = info.createInfo.extent;
+	ret.mipLevels = info.createInfo.mipLevels;
 	ret.image = vkImage;
 	auto const requirements = g_device.device.getImageMemoryRequirements(ret.image);
 	ret.queueFlags = info.queueFlags;
@@ -478,76 +489,79 @@ void vram::release(Buffer buffer, [[maybe_unused]] bool bSilent) {
 }
 
 std::future<void> vram::copy(Span<Span<u8>> pixelsArr, Image const& dst, LayoutTransition layouts) {
+	// One entry per (layer, level), layer-major: all levels are staged and copied in a single batch
 	std::size_t imgSize = 0;
-	std::size_t layerSize = 0;
 	for (auto pixels : pixelsArr) {
-		ENSURE(layerSize == 0 || layerSize == pixels.extent, "Invalid image data!");
-		layerSize = pixels.extent;
-		imgSize += layerSize;
+		ENSURE(pixels.extent > 0, "Invalid image data!");
+		imgSize += pixels.extent;
 	}
-	ENSURE(layerSize > 0 && imgSize > 0, "Invalid image data!");
+	ENSURE(imgSize > 0 && dst.mipLevels > 0 && pixelsArr.extent % dst.mipLevels == 0, "Invalid image data!");
 	[[maybe_unused]] auto const indices = g_device.queueIndices(QFlag::eGraphics | QFlag::eTransfer);
 	ENSURE(indices.size() == 1 || dst.mode == vk::SharingMode::eConcurrent, "Exclusive queues!");
 	auto promise = std::make_shared<Batch::Promise::element_type>();
 	auto ret = promise->get_future();
-	auto f = [promise, pixelsArr, &dst, layouts, imgSize, layerSize]() mutable {
-		auto stage = tfr::newStage(imgSize);
-		[[maybe_unused]] bool const bResult = mapMemory(stage.buffer);
-		ENSURE(bResult, "Memory map failed");
-		u32 layerIdx = 0;
-		u32 const layerCount = (u32)pixelsArr.extent;
+	auto f = [promise, pixelsArr, &dst, layouts, imgSize]() mutable {
+		auto const region = tfr::reserve(imgSize);
+		if (!region.pMap) {
+			logE("[{}] Error staging image!", s_tName);
+			promise->set_value();
+			return;
+		}
+		u32 const levelCount = dst.mipLevels;
+		u32 const layerCount = (u32)pixelsArr.extent / levelCount;
+		std::size_t offset = 0;
+		std::size_t idx = 0;
 		std::vector<vk::BufferImageCopy> copyRegions;
 		for (auto pixels : pixelsArr) {
-			auto const offset = layerIdx * layerSize;
-			void* pStart = (u8*)stage.buffer.pMap + offset;
+			u32 const layerIdx = (u32)(idx / levelCount);
+			u32 const levelIdx = (u32)(idx % levelCount);
+			void* pStart = (u8*)region.pMap + offset;
 			std::memcpy(pStart, pixels.pData, pixels.extent);
 			vk::BufferImageCopy copyRegion;
-			copyRegion.bufferOffset = offset;
+			copyRegion.bufferOffset = region.offset + offset;
 			copyRegion.bufferRowLength = 0;
 			copyRegion.bufferImageHeight = 0;
 			copyRegion.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-			copyRegion.imageSubresource.mipLevel = 0;
-			copyRegion.imageSubresource.baseArrayLayer = (u32)layerIdx;
+			copyRegion.imageSubresource.mipLevel = levelIdx;
+			copyRegion.imageSubresource.baseArrayLayer = layerIdx;
 			copyRegion.imageSubresource.layerCount = 1;
 			copyRegion.imageOffset = vk::Offset3D(0, 0, 0);
-			copyRegion.imageExtent = dst.extent;
+			copyRegion.imageExtent = vk::Extent3D(std::max(dst.extent.width >> levelIdx, 1U), std::max(dst.extent.height >> levelIdx, 1U), 1);
 			copyRegions.push_back(std::move(copyRegion));
-			++layerIdx;
+			offset += pixels.extent;
+			++idx;
 		}
-		vk::CommandBufferBeginInfo beginInfo;
-		beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
-		stage.command.begin(beginInfo);
-		vk::ImageMemoryBarrier barrier;
-		barrier.oldLayout = layouts.pre;
-		barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
-		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.image = dst.image;
-		barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-		barrier.subresourceRange.baseMipLevel = 0;
-		barrier.subresourceRange.levelCount = 1;
-		barrier.subresourceRange.baseArrayLayer = 0;
-		barrier.subresourceRange.layerCount = layerCount;
-		barrier.srcAccessMask = {};
-		barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
-		using vkstg = vk::PipelineStageFlagBits;
-		stage.command.pipelineBarrier(vkstg::eTopOfPipe, vkstg::eTransfer, {}, {}, {}, barrier);
-		stage.command.copyBufferToImage(stage.buffer.buffer, dst.image, vk::ImageLayout::eTransferDstOptimal, copyRegions);
-		barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
-		barrier.newLayout = layouts.post;
-		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.image = dst.image;
-		barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-		barrier.subresourceRange.baseMipLevel = 0;
-		barrier.subresourceRange.levelCount = 1;
-		barrier.subresourceRange.baseArrayLayer = 0;
-		barrier.subresourceRange.layerCount = layerCount;
-		barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
-		barrier.dstAccessMask = {};
-		stage.command.pipelineBarrier(vkstg::eTransfer, vkstg::eBottomOfPipe, {}, {}, {}, barrier);
-		stage.command.end();
-		tfr::addStage(std::move(stage), std::move(promise));
+		tfr::record(std::move(promise), region, [&](vk::CommandBuffer command) {
+			vk::ImageMemoryBarrier barrier;
+			barrier.oldLayout = layouts.pre;
+			barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image = dst.image;
+			barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+			barrier.subresourceRange.baseMipLevel = 0;
+			barrier.subresourceRange.levelCount = levelCount;
+			barrier.subresourceRange.baseArrayLayer = 0;
+			barrier.subresourceRange.layerCount = layerCount;
+			barrier.srcAccessMask = {};
+			barrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+			using vkstg = vk::PipelineStageFlagBits;
+			command.pipelineBarrier(vkstg::eTopOfPipe, vkstg::eTransfer, {}, {}, {}, barrier);
+			command.copyBufferToImage(region.buffer, dst.image, vk::ImageLayout::eTransferDstOptimal, copyRegions);
+			barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+			barrier.newLayout = layouts.post;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image = dst.image;
+			barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+			barrier.subresourceRange.baseMipLevel = 0;
+			barrier.subresourceRange.levelCount = levelCount;
+			barrier.subresourceRange.baseArrayLayer = 0;
+			barrier.subresourceRange.layerCount = layerCount;
+			barrier.srcAccessMask = vk::AccessFlagBits::eTransferRead;
+			barrier.dstAccessMask = {};
+			command.pipelineBarrier(vkstg::eTransfer, vkstg::eBottomOfPipe, {}, {}, {}, barrier);
+		});
 	};
 	tfr::g_queue.push(std::move(f));
 	return ret;
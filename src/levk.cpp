@@ -1,11 +1,14 @@
 #include <build_version.hpp>
+#include <core/deferred_log.hpp>
 #include <core/io.hpp>
+#include <core/load_trace.hpp>
 #include <core/log.hpp>
 #include <core/maths.hpp>
 #include <core/os.hpp>
 #include <core/tasks.hpp>
 #include <core/time.hpp>
 #include <core/utils.hpp>
+#include <core/watcher.hpp>
 #include <dumb_json/dumb_json.hpp>
 #include <editor/editor.hpp>
 #include <engine/game/driver.hpp>
@@ -50,8 +53,19 @@ Service::Service(os::Args args) {
 	Time::resetElapsed();
 	m_services.add<os::Service>(args);
 	m_services.add<io::Service>(std::string_view("debug.log"));
+	m_services.add<deferred::Service>();
 	logI("LittleEngineVk v{}  [{}/{}]", g_engineVersion.toString(false), levk_OS_name, levk_arch_name);
-	m_services.add<tasks::Service>((u8)4);
+	tasks::Config tasksConfig;
+	if (auto workers = os::isDefined("workers"); workers && !workers->empty()) {
+		tasksConfig.workerCount = (u8)std::clamp(utils::strings::toS32(*workers, 0), 0, (s32)maths::max<u8>());
+	}
+	tasksConfig.bPinWorkers = os::isDefined("pin-workers").has_value();
+	m_services.add<tasks::Service>(tasksConfig);
+	if constexpr (levk_resourcesHotReload) {
+		io::watcher::Config watcherConfig;
+		watcherConfig.bForcePoll = os::isDefined("poll-files").has_value();
+		m_services.add<io::watcher::Service>(watcherConfig);
+	}
 }
 
 Service::Service(Service&&) = default;
@@ -62,6 +76,13 @@ Service::~Service() {
 	input::deinit();
 	// Wait for async loads
 	res::waitIdle();
+	if (!g_app.loadTracePath.empty() && !g_loadTrace.events().empty()) {
+		if (g_loadTrace.writeChromeTrace(g_app.loadTracePath)) {
+			logI("[{}] Load trace written to [{}]\n{}", tName, g_app.loadTracePath.generic_string(), g_loadTrace.summary());
+		} else {
+			logW("[{}] Failed to write load trace to [{}]", tName, g_app.loadTracePath.generic_string());
+		}
+	}
 	// Reset game state
 	gs::reset();
 	// Release all pipelines and Shader semaphores
@@ -100,6 +121,14 @@ bool Service::init(Info info) {
 			}
 		}
 		g_app.reader = reader;
+		if (!os::isDefined("no-asset-cache")) {
+			g_app.assetCache.open(info.assetCache.empty() ? dirPath / ".cache" : info.assetCache);
+		}
+		g_app.mainTaskBudgets = info.mainTaskBudgets;
+		if (auto const loadTrace = os::isDefined("load-trace")) {
+			g_app.loadTracePath = loadTrace->empty() ? dirPath / "load_trace.json" : stdfs::path(*loadTrace);
+			g_loadTrace.enable(true);
+		}
 		m_services.add<res::Service>();
 		Window::Info windowInfo;
 		windowInfo.config.size = {1280, 720};
@@ -115,6 +144,7 @@ bool Service::init(Info info) {
 		input::init(*g_app.window);
 	} catch (std::exception const& e) {
 		g_app.reader = g_app.fileReader;
+		g_app.assetCache.close();
 		logE("[{}] Failed to initialise engine services: {}", tName, e.what());
 		return false;
 	}
@@ -140,6 +170,7 @@ bool Service::update(Driver& out_driver) const {
 	}
 	Time const dt = g_clock.dt();
 	Window::pollEvents();
+	tasks::runMain(tasks::Phase::ePreTick, g_app.mainTaskBudgets[(std::size_t)tasks::Phase::ePreTick]);
 	engine::update();
 	if (g_app.window && g_app.window->closing()) {
 		if (g_shutdownSequence == ShutdownSequence::eCloseWindow_Shutdown) {
@@ -169,6 +200,7 @@ bool Service::update(Driver& out_driver) const {
 #endif
 	{
 		g_app.window->driver().submit(gs::update(out_driver, dt, bTick), g_app.viewport.rect());
+		tasks::runMain(tasks::Phase::ePostTick, g_app.mainTaskBudgets[(std::size_t)tasks::Phase::ePostTick]);
 	}
 #if defined(LEVK_DEBUG)
 	catch (std::exception const& e) {
@@ -184,6 +216,7 @@ void Service::render() const {
 		try
 #endif
 		{
+			tasks::runMain(tasks::Phase::ePreRender, g_app.mainTaskBudgets[(std::size_t)tasks::Phase::ePreRender]);
 			Window::renderAll();
 		}
 #if defined(LEVK_DEBUG)
@@ -262,6 +295,10 @@ io::Reader const& engine::reader() {
 	return g_app.reader;
 }
 
+io::DiskCache const& engine::assetCache() {
+	return g_app.assetCache;
+}
+
 res::Texture::Space engine::colourSpace() {
 	if (g_app.window) {
 		auto const pDriver = WindowImpl::driverImpl(g_app.window->id());
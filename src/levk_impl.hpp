@@ -1,8 +1,10 @@
 #pragma once
 #include <memory>
 #include <optional>
+#include <core/disk_cache.hpp>
 #include <core/reader.hpp>
 #include <core/ref.hpp>
+#include <core/tasks.hpp>
 #include <engine/resources/resource_types.hpp>
 #include <engine/window/window.hpp>
 #include <glm/vec3.hpp>
@@ -13,9 +15,17 @@ struct App {
 	gfx::Viewport viewport;
 	io::FileReader fileReader;
 	Ref<io::Reader const> reader = fileReader;
+	io::DiskCache assetCache;
+	EnumArray<tasks::Phase, Time> mainTaskBudgets;
+	// Chrome trace output of g_loadTrace (written on shutdown if non-empty)
+	stdfs::path loadTracePath;
 };
 
 res::Texture::Space colourSpace();
+///
+/// \brief Cache of decoded assets (inactive if disabled)
+///
+io::DiskCache const& assetCache();
 Window* window();
 
 void update();
@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <array>
+#include <optional>
 #include <sstream>
 #include <utility>
 #include <core/ensure.hpp>
@@ -9,6 +11,7 @@
 #include <engine/resources/resources.hpp>
 #include <levk_impl.hpp>
 #include <resources/manifest.hpp>
+#include <resources/model_impl.hpp>
 #include <resources/resources_impl.hpp>
 
 namespace le::res {
@@ -35,27 +38,23 @@ bool allEmpty(std::vector<T> const&... out_vecs) {
 	return (out_vecs.empty() && ...);
 }
 
-template <typename T>
-std::vector<std::shared_ptr<tasks::Handle>> loadTResources(std::vector<ResourceData<T>>& out_toLoad, std::vector<stdfs::path>& out_loaded,
-														   std::vector<GUID>& out_resources, kt::lockable<std::mutex>& mutex, std::string_view jobName) {
-	static_assert(std::is_base_of_v<Resource<T>, T>, "T must derive from Resource!");
-	if (!out_toLoad.empty()) {
-		auto task = [&out_loaded, &out_resources, &mutex](ResourceData<T>& data) {
-			auto resource = load(data.id, std::move(data.createInfo));
-			if (resource.guid > GUID::null) {
-				auto lock = mutex.lock();
-				out_resources.push_back(resource.guid);
-				out_loaded.push_back(std::move(data.id));
-			}
-		};
-		return tasks::forEach<ResourceData<T>>(out_toLoad, task, jobName);
+template <typename E, std::size_t N>
+E parseEnum(std::string_view str, std::array<std::string_view, N> const& names, E fallback) {
+	for (std::size_t idx = 0; idx < N; ++idx) {
+		if (str == names[idx]) {
+			return (E)idx;
+		}
 	}
-	return {};
+	return fallback;
 }
+
+constexpr std::array<std::string_view, (std::size_t)Sampler::Filter::eCOUNT_> g_filterNames = {"linear", "nearest"};
+constexpr std::array<std::string_view, (std::size_t)Sampler::Mode::eCOUNT_> g_modeNames = {"repeat", "clamp_edge", "clamp_border"};
 } // namespace
 
 void Manifest::Info::intersect(ResourceList ids) {
 	intersectTlist(shaders, ids.shaders);
+	intersectTlist(samplers, ids.samplers);
 	intersectTlist(textures, ids.textures);
 	intersectTlist(cubemaps, ids.cubemaps);
 	intersectTlist(materials, ids.materials);
@@ -67,6 +66,7 @@ void Manifest::Info::intersect(ResourceList ids) {
 ResourceList Manifest::Info::exportList() const {
 	ResourceList ret;
 	ret.shaders = exportTList(shaders);
+	ret.samplers = exportTList(samplers);
 	ret.textures = exportTList(textures);
 	ret.cubemaps = exportTList(cubemaps);
 	ret.materials = exportTList(materials);
@@ -77,14 +77,14 @@ ResourceList Manifest::Info::exportList() const {
 }
 
 bool Manifest::Info::empty() const {
-	return allEmpty(shaders, textures, cubemaps, materials, meshes, models, fonts);
+	return allEmpty(shaders, samplers, textures, cubemaps, materials, meshes, models, fonts);
 }
 
 std::string const Manifest::s_tName = utils::tName<Manifest>();
 
 bool Manifest::read(stdfs::path const& id) {
-	if (auto data = engine::reader().string(id)) {
-		if (!m_manifest.read(*data)) {
+	if (auto data = engine::reader().map(id)) {
+		if (!m_manifest.read(data->text())) {
 			logE("[{}] Failed to read manifest [{}] from [{}]", s_tName, id.generic_string(), engine::reader().medium());
 			m_manifest.fields.clear();
 			return false;
@@ -102,10 +102,10 @@ void Manifest::start() {
 	if (!m_bParsed) {
 		parse();
 	}
+	m_status = Status::eLoadingResources;
 	if (!m_toLoad.empty()) {
-		loadData();
+		buildGraph();
 	}
-	m_status = Status::eExtractingData;
 }
 
 Manifest::Status Manifest::update(bool bTerminate) {
@@ -117,19 +117,15 @@ Manifest::Status Manifest::update(bool bTerminate) {
 		}
 		break;
 	}
-	case Status::eExtractingData: {
-		if (eraseDone(bTerminate)) {
-			if (bTerminate) {
-				m_status = Status::eIdle;
-				m_loaded = {};
-			} else {
-				loadResources();
-			}
-		}
-		break;
-	}
 	case Status::eLoadingResources: {
 		if (eraseDone(bTerminate)) {
+			if (m_graph) {
+				m_stats = m_graph->stats();
+				logI("[{}] Loaded [{}] resources in {:.2f}ms: critical path: {:.2f}ms, total work: {:.2f}ms", s_tName, m_stats.nodes - m_stats.discarded,
+					 m_stats.elapsed.to_s() * 1000, m_stats.criticalPath.to_s() * 1000, m_stats.total.to_s() * 1000);
+			}
+			m_graph.reset();
+			m_samplerNodes.clear();
 			m_toLoad = {};
 			m_loading.clear();
 			m_semaphore.reset();
@@ -182,6 +178,28 @@ ResourceList Manifest::parse() {
 			}
 		});
 	}
+	if (auto pSamplers = m_manifest.find<dj::array>("samplers")) {
+		pSamplers->for_each<dj::object>([&](auto const& sampler) {
+			auto resourceID = sampler.template value<dj::string>("id");
+			if (!resourceID.empty()) {
+				if (find<Sampler>(resourceID)) {
+					all.samplers.push_back(resourceID);
+					m_loaded.samplers.push_back(std::move(resourceID));
+				} else {
+					ResourceData<Sampler> data;
+					data.id = std::move(resourceID);
+					auto& info = data.createInfo;
+					info.min = parseEnum(sampler.template value<dj::string>("min"), g_filterNames, info.min);
+					info.mag = parseEnum(sampler.template value<dj::string>("mag"), g_filterNames, info.mag);
+					info.mip = parseEnum(sampler.template value<dj::string>("mip"), g_filterNames, info.mip);
+					info.mode = parseEnum(sampler.template value<dj::string>("mode"), g_modeNames, info.mode);
+					all.samplers.push_back(data.id);
+					m_toLoad.samplers.push_back(std::move(data));
+					m_data.idCount.fetch_add(1);
+				}
+			}
+		});
+	}
 	if (auto pTextures = m_manifest.find<dj::array>("textures")) {
 		pTextures->for_each<dj::object>([&](auto const& texture) {
 			auto const id = texture.template value<dj::string>("id");
@@ -264,12 +282,14 @@ ResourceList Manifest::parse() {
 }
 
 void Manifest::reset() {
+	// discard and wait for pending nodes before destroying data they refer to
+	m_graph.reset();
 	m_loaded = {};
 	m_toLoad = {};
 	m_manifest.fields.clear();
 	m_data.idCount = 0;
 	m_data.dataCount = 0;
-	m_running.clear();
+	m_samplerNodes.clear();
 	m_loading.clear();
 	m_semaphore.reset();
 	m_status = Status::eIdle;
@@ -284,6 +304,10 @@ bool Manifest::ready() const {
 	return m_status == Status::eReady;
 }
 
+tasks::Graph::Stats const& Manifest::stats() const {
+	return m_stats;
+}
+
 void Manifest::unload(const ResourceList& list) {
 	auto unload = [](std::vector<stdfs::path> const& ids) {
 		for (auto const& id : ids) {
@@ -291,6 +315,7 @@ void Manifest::unload(const ResourceList& list) {
 		}
 	};
 	unload(list.shaders);
+	unload(list.samplers);
 	unload(list.textures);
 	unload(list.cubemaps);
 	unload(list.materials);
@@ -299,51 +324,152 @@ void Manifest::unload(const ResourceList& list) {
 	unload(list.fonts);
 }
 
-void Manifest::loadData() {
-	m_status = Status::eExtractingData;
-	if (!m_toLoad.models.empty()) {
-		auto task = [](ResourceData<Model>& data) {
+void Manifest::buildGraph() {
+	m_semaphore = acquire();
+	m_graph = std::make_unique<tasks::Graph>();
+	m_samplerNodes.clear();
+	// samplers before textures: all sampler nodes must exist before any texture (or model) node is added
+	for (auto& data : m_toLoad.samplers) {
+		m_samplerNodes[data.id] = addLoad(data, m_loaded.samplers, {});
+	}
+	auto samplerDeps = [this](Hash samplerID) -> std::vector<tasks::Graph::ID> {
+		if (auto search = m_samplerNodes.find(samplerID); search != m_samplerNodes.end()) {
+			return {search->second};
+		}
+		return {};
+	};
+	for (auto& data : m_toLoad.shaders) {
+		addLoad(data, m_loaded.shaders, {});
+	}
+	for (auto& data : m_toLoad.textures) {
+		addLoad(data, m_loaded.textures, samplerDeps(data.createInfo.samplerID));
+	}
+	for (auto& data : m_toLoad.cubemaps) {
+		addLoad(data, m_loaded.cubemaps, samplerDeps(data.createInfo.samplerID));
+	}
+	for (auto& data : m_toLoad.models) {
+		auto const idStr = data.id.generic_string();
+		auto extract = [this, &data]() {
 			Model::LoadInfo loadInfo;
 			loadInfo.idRoot = data.id;
 			loadInfo.jsonDirectory = data.id;
-			auto info = loadInfo.createInfo();
-			if (info) {
+			// texture bytes are read by each texture's node
+			loadInfo.bTextureBytes = false;
+			if (auto info = loadInfo.createInfo(); info && !info->meshData.empty()) {
 				data.createInfo = std::move(*info);
+				m_data.dataCount.fetch_add(1);
+				expandModel(data, *m_graph->current());
+			} else {
+				logE("[{}] Failed to extract model data for [{}]", s_tName, data.id.generic_string());
 			}
 		};
-		addJobs(tasks::forEach<ResourceData<Model>>(m_toLoad.models, task, "Manifest-0:Models"));
+		m_graph->add(extract, "Manifest:" + idStr + ":data");
 	}
 }
 
-void Manifest::loadResources() {
-	m_status = Status::eLoadingResources;
-	m_semaphore = acquire();
-	addJobs(loadTResources(m_toLoad.shaders, m_loaded.shaders, m_loading, m_mutex, "Manifest-1:Shaders"));
-	addJobs(loadTResources(m_toLoad.textures, m_loaded.textures, m_loading, m_mutex, "Manifest-1:Textures"));
-	addJobs(loadTResources(m_toLoad.cubemaps, m_loaded.cubemaps, m_loading, m_mutex, "Manifest-1:Cubemaps"));
-	addJobs(loadTResources(m_toLoad.models, m_loaded.models, m_loading, m_mutex, "Manifest-1:Models"));
+template <typename T>
+tasks::Graph::ID Manifest::addLoad(ResourceData<T>& out_data, std::vector<stdfs::path>& out_loaded, std::vector<tasks::Graph::ID> const& dependencies) {
+	static_assert(std::is_base_of_v<Resource<T>, T>, "T must derive from Resource!");
+	auto task = [this, &out_data, &out_loaded]() {
+		auto resource = load(out_data.id, std::move(out_data.createInfo));
+		onLoaded(resource.guid, out_loaded, out_data.id);
+	};
+	return m_graph->add(task, "Manifest:" + out_data.id.generic_string(), dependencies);
 }
 
-bool Manifest::eraseDone(bool bWaitingJobs) {
-	auto lock = m_mutex.lock();
-	if (!m_running.empty()) {
-		auto iter = std::remove_if(m_running.begin(), m_running.end(), [bWaitingJobs](auto const& sJob) -> bool {
-			bool bRet = sJob->hasCompleted(true);
-			if (bWaitingJobs) {
-				bRet |= sJob->discard();
+void Manifest::expandModel(ResourceData<Model>& out_data, tasks::Graph::ID parent) {
+	// Called from the model's data node: sub-resources become children of the Model, which loads once they are done
+	auto& info = out_data.createInfo;
+	std::string const prefix = "Manifest:" + out_data.id.generic_string() + ":";
+	std::vector<tasks::Graph::ID> texNodes, matNodes, children;
+	texNodes.reserve(info.textures.size());
+	for (auto& texture : info.textures) {
+		std::vector<tasks::Graph::ID> deps = {parent};
+		if (auto search = m_samplerNodes.find(texture.samplerID); search != m_samplerNodes.end()) {
+			deps.push_back(search->second);
+		}
+		auto task = [this, &texture, &info]() {
+			auto trace = g_loadTrace.scope(Texture::s_tName, texture.id.generic_string(), LoadTrace::Phase::eRead);
+			if (auto bytes = engine::reader().bytes(texture.filename)) {
+				trace = {};
+				texture.bytes = std::move(*bytes);
+				texture.loaded = Model::Impl::loadTexture(texture, info.mode);
+				onLoaded(texture.loaded.guid, m_loaded.textures, {});
+			} else {
+				logW("[{}] Failed to load texture [{}] from [{}]", Model::s_tName, texture.filename.generic_string(), engine::reader().medium());
 			}
-			return bRet;
-		});
-		m_running.erase(iter, m_running.end());
+		};
+		texNodes.push_back(m_graph->add(task, prefix + texture.id.generic_string(), deps));
+	}
+	children = texNodes;
+	// textures before materials
+	matNodes.reserve(info.materials.size());
+	for (auto& material : info.materials) {
+		std::vector<tasks::Graph::ID> deps = {parent};
+		for (auto const* pIndices : {&material.diffuseIndices, &material.specularIndices}) {
+			for (std::size_t const idx : *pIndices) {
+				if (idx < texNodes.size()) {
+					deps.push_back(texNodes[idx]);
+				}
+			}
+		}
+		auto task = [this, &material]() {
+			material.loaded = Model::Impl::loadMaterial(material);
+			onLoaded(material.loaded.guid, m_loaded.materials, {});
+		};
+		matNodes.push_back(m_graph->add(task, prefix + material.id.generic_string(), deps));
+		children.push_back(matNodes.back());
+	}
+	// materials (and their textures) before meshes
+	for (auto& meshData : info.meshData) {
+		std::vector<tasks::Graph::ID> deps = {parent};
+		std::optional<std::size_t> matIdx;
+		if (!meshData.materialIndices.empty() && meshData.materialIndices.front() < matNodes.size()) {
+			matIdx = meshData.materialIndices.front();
+			deps.push_back(matNodes[*matIdx]);
+		}
+		auto task = [this, &meshData, &info, matIdx]() {
+			Material::Inst material;
+			if (matIdx) {
+				material = Model::Impl::materialInst(info, info.materials[*matIdx]);
+			}
+			meshData.loaded = Model::Impl::loadMesh(meshData, std::move(material), info);
+			onLoaded(meshData.loaded.guid, m_loaded.meshes, {});
+		};
+		children.push_back(m_graph->add(task, prefix + meshData.id.generic_string(), deps));
 	}
+	// the Model adopts its loaded sub-resources
+	auto task = [this, &out_data]() {
+		auto model = load(out_data.id, std::move(out_data.createInfo));
+		onLoaded(model.guid, m_loaded.models, out_data.id);
+	};
+	m_graph->add(task, prefix + "model", children);
+}
+
+void Manifest::onLoaded(GUID guid, std::vector<stdfs::path>& out_loaded, stdfs::path id) {
+	if (guid > GUID::null) {
+		auto lock = m_mutex.lock();
+		m_loading.push_back(guid);
+		if (!id.empty()) {
+			out_loaded.push_back(std::move(id));
+		}
+	}
+}
+
+bool Manifest::eraseDone(bool bTerminate) {
+	if (m_graph) {
+		if (bTerminate) {
+			m_graph->discard();
+		}
+		if (!m_graph->done()) {
+			return false;
+		}
+	}
+	auto lock = m_mutex.lock();
 	if (!m_loading.empty()) {
 		auto iter = std::remove_if(m_loading.begin(), m_loading.end(), [](GUID guid) { return !isLoading(guid); });
 		m_loading.erase(iter, m_loading.end());
 	}
-	return m_running.empty() && m_loading.empty() && m_loading.empty();
-}
-
-void Manifest::addJobs(std::vector<std::shared_ptr<tasks::Handle>> handles) {
-	std::move(handles.begin(), handles.end(), std::back_inserter(m_running));
+	return m_loading.empty();
 }
 } // namespace le::res
@@ -1,7 +1,9 @@
 #pragma once
 #include <atomic>
 #include <memory>
+#include <unordered_map>
 #include <core/std_types.hpp>
+#include <core/task_graph.hpp>
 #include <core/tasks.hpp>
 #include <dumb_json/dumb_json.hpp>
 #include <engine/resources/resource_list.hpp>
@@ -20,7 +22,6 @@ class Manifest {
 	enum class Status : s8 {
 		eIdle,
 		eReady,
-		eExtractingData,
 		eLoadingResources,
 		eWaitingForResources,
 		eTerminating,
@@ -29,6 +30,7 @@ class Manifest {
 
 	struct Info final {
 		std::vector<ResourceData<res::Shader>> shaders;
+		std::vector<ResourceData<res::Sampler>> samplers;
 		std::vector<ResourceData<res::Texture>> textures;
 		std::vector<ResourceData<res::Texture>> cubemaps;
 		std::vector<ResourceData<res::Material>> materials;
@@ -58,12 +60,16 @@ class Manifest {
   protected:
 	dj::object m_manifest;
 	Data m_data;
-	std::vector<std::shared_ptr<tasks::Handle>> m_running;
+	// Graph nodes loading samplers (dependencies of textures that use them)
+	std::unordered_map<Hash, tasks::Graph::ID> m_samplerNodes;
+	tasks::Graph::Stats m_stats;
 	std::vector<res::GUID> m_loading;
 	kt::lockable<std::mutex> m_mutex;
 	res::Semaphore m_semaphore;
 	Status m_status = Status::eIdle;
 	bool m_bParsed = false;
+	// Declared last: destroyed (waiting for running nodes, which access other members) first
+	std::unique_ptr<tasks::Graph> m_graph;
 
   public:
 	bool read(stdfs::path const& id);
@@ -73,13 +79,19 @@ class Manifest {
 	void reset();
 	bool idle() const;
 	bool ready() const;
+	///
+	/// \brief Timing statistics of the last completed load (including its critical path)
+	///
+	tasks::Graph::Stats const& stats() const;
 
 	static void unload(ResourceList const& list);
 
   protected:
-	void loadData();
-	void loadResources();
-	bool eraseDone(bool bWaitingJobs);
-	void addJobs(std::vector<std::shared_ptr<tasks::Handle>> handles);
+	void buildGraph();
+	template <typename T>
+	tasks::Graph::ID addLoad(ResourceData<T>& out_data, std::vector<stdfs::path>& out_loaded, std::vector<tasks::Graph::ID> const& dependencies);
+	void expandModel(ResourceData<Model>& out_data, tasks::Graph::ID parent);
+	void onLoaded(GUID guid, std::vector<stdfs::path>& out_loaded, stdfs::path id);
+	bool eraseDone(bool bTerminate);
 };
 } // namespace le::res
@@ -1,16 +1,22 @@
+#include <algorithm>
+#include <istream>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <fmt/format.h>
 #include <tinyobjloader/tiny_obj_loader.h>
+#include <core/byte_stream.hpp>
 #include <core/colour.hpp>
 #include <core/ensure.hpp>
 #include <core/log.hpp>
+#include <core/lvmesh.hpp>
+#include <core/tasks.hpp>
 #include <core/utils.hpp>
+#include <core/vertex_weld.hpp>
 #include <dumb_json/dumb_json.hpp>
 #include <engine/game/stopwatch.hpp>
 #include <engine/resources/resources.hpp>
 #include <gfx/device.hpp>
-#include <glm/gtx/hash.hpp>
 #include <levk_impl.hpp>
 #include <resources/model_impl.hpp>
 #include <resources/resources_impl.hpp>
@@ -19,11 +25,22 @@
 
 namespace le::res {
 namespace {
+///
+/// \brief Read-only streambuf over external memory (avoids copying into a stringstream)
+///
+class ViewBuf final : public std::streambuf {
+  public:
+	ViewBuf(std::string_view text) {
+		auto pData = const_cast<char*>(text.data());
+		setg(pData, pData, pData + text.size());
+	}
+};
+
 class OBJParser final {
   public:
 	struct Data final {
-		std::stringstream objBuf;
-		std::stringstream mtlBuf;
+		io::Mapped obj;
+		io::Mapped mtl;
 		stdfs::path jsonID;
 		stdfs::path modelID;
 		stdfs::path samplerID;
@@ -37,7 +54,6 @@ class OBJParser final {
 
   private:
 	tinyobj::attrib_t m_attrib;
-	tinyobj::MaterialStreamReader m_matStrReader;
 	stdfs::path m_modelID;
 	stdfs::path m_jsonID;
 	stdfs::path m_samplerID;
@@ -52,11 +68,10 @@ class OBJParser final {
 	OBJParser(Data data);
 
   private:
-	Model::MeshData processShape(tinyobj::shape_t const& shape);
 	std::size_t texIdx(std::string_view texName);
 	std::size_t matIdx(tinyobj::material_t const& fromMat, std::string_view id);
 	std::string meshName(tinyobj::shape_t const& shape);
-	gfx::Geometry vertices(tinyobj::shape_t const& shape);
+	gfx::Geometry vertices(tinyobj::shape_t const& shape) const;
 	std::vector<std::size_t> materials(tinyobj::shape_t const& shape);
 };
 
@@ -67,8 +82,189 @@ glm::vec3 getVec3(dj::object const& json, std::string const& id, glm::vec3 const
 	return def;
 }
 
+u32 flagBits(Material::Flags flags) {
+	u32 ret = 0;
+	for (std::size_t idx = 0; idx < (std::size_t)Material::Flag::eCOUNT_; ++idx) {
+		ret |= flags.test((Material::Flag)idx) ? (1U << idx) : 0U;
+	}
+	return ret;
+}
+
+Material::Flags flags(u32 bits) {
+	Material::Flags ret;
+	for (std::size_t idx = 0; idx < (std::size_t)Material::Flag::eCOUNT_; ++idx) {
+		if (bits & (1U << idx)) {
+			ret.set((Material::Flag)idx);
+		}
+	}
+	return ret;
+}
+
+///
+/// \brief Serialise parsed OBJ data (excluding texture bytes and hashes, which are derived from IDs)
+///
+bytearray serialise(Model::CreateInfo const& info) {
+	io::ByteWriter writer;
+	writer.write((u64)info.textures.size());
+	for (auto const& tex : info.textures) {
+		writer.write(tex.id.generic_string()).write(tex.filename.generic_string());
+	}
+	writer.write((u64)info.materials.size());
+	for (auto const& mat : info.materials) {
+		writer.write(mat.id.generic_string()).write(mat.diffuseIndices).write(mat.specularIndices).write(mat.bumpIndices);
+		writer.write(mat.albedo).write(mat.shininess).write(flagBits(mat.flags));
+	}
+	writer.write((u64)info.meshData.size());
+	for (auto const& mesh : info.meshData) {
+		writer.write(mesh.id.generic_string()).write(mesh.geometry.vertices).write(mesh.geometry.indices).write(mesh.materialIndices).write(mesh.shininess);
+	}
+	return writer.release();
+}
+
+std::optional<Model::CreateInfo> deserialise(Span<std::byte> bytes, stdfs::path const& samplerID) {
+	io::ByteReader reader(bytes);
+	Model::CreateInfo ret;
+	u64 count = 0;
+	std::string id, filename;
+	reader.read(count);
+	for (u64 idx = 0; reader && idx < count; ++idx) {
+		Model::TexData tex;
+		reader.read(id).read(filename);
+		tex.hash = id;
+		tex.id = id;
+		tex.filename = filename;
+		tex.samplerID = samplerID;
+		ret.textures.push_back(std::move(tex));
+	}
+	reader.read(count);
+	for (u64 idx = 0; reader && idx < count; ++idx) {
+		Model::MatData mat;
+		u32 bits = 0;
+		reader.read(id).read(mat.diffuseIndices).read(mat.specularIndices).read(mat.bumpIndices).read(mat.albedo).read(mat.shininess).read(bits);
+		mat.flags = flags(bits);
+		mat.hash = id;
+		mat.id = id;
+		ret.materials.push_back(std::move(mat));
+	}
+	reader.read(count);
+	for (u64 idx = 0; reader && idx < count; ++idx) {
+		Model::MeshData mesh;
+		reader.read(id).read(mesh.geometry.vertices).read(mesh.geometry.indices).read(mesh.materialIndices).read(mesh.shininess);
+		mesh.hash = id;
+		mesh.id = id;
+		ret.meshData.push_back(std::move(mesh));
+	}
+	if (!reader || !reader.eof()) {
+		return std::nullopt;
+	}
+	return ret;
+}
+
+std::vector<u32> indices32(std::vector<std::size_t> const& from) {
+	return std::vector<u32>(from.begin(), from.end());
+}
+
+std::vector<std::size_t> indices(std::vector<u32> const& from) {
+	return std::vector<std::size_t>(from.begin(), from.end());
+}
+
+///
+/// \brief Convert parsed OBJ data into a precooked model (IDs / filenames relative to modelID / jsonDir)
+///
+bytearray cook(Model::CreateInfo const& info, stdfs::path const& modelID, stdfs::path const& jsonDir) {
+	io::lvmesh::Model model;
+	model.vertexStride = (u32)sizeof(gfx::Vertex);
+	for (auto const& tex : info.textures) {
+		model.textures.push_back({tex.id.lexically_relative(modelID).generic_string(), tex.filename.lexically_relative(jsonDir).generic_string()});
+	}
+	for (auto const& mat : info.materials) {
+		io::lvmesh::Material material;
+		material.id = mat.id.lexically_relative(modelID).generic_string();
+		material.diffuseIndices = indices32(mat.diffuseIndices);
+		material.specularIndices = indices32(mat.specularIndices);
+		material.bumpIndices = indices32(mat.bumpIndices);
+		material.ambient = mat.albedo.ambient;
+		material.diffuse = mat.albedo.diffuse;
+		material.specular = mat.albedo.specular;
+		material.shininess = mat.shininess;
+		material.flags = flagBits(mat.flags);
+		model.materials.push_back(std::move(material));
+	}
+	for (auto const& meshData : info.meshData) {
+		io::lvmesh::Mesh mesh;
+		auto const& vertices = meshData.geometry.vertices;
+		mesh.id = meshData.id.lexically_relative(modelID).generic_string();
+		mesh.materialIndices = indices32(meshData.materialIndices);
+		mesh.shininess = meshData.shininess;
+		mesh.vertices = Span<std::byte>(reinterpret_cast<std::byte const*>(vertices.data()), vertices.size() * sizeof(gfx::Vertex));
+		mesh.indices = meshData.geometry.indices;
+		model.meshes.push_back(std::move(mesh));
+	}
+	return io::lvmesh::write(model);
+}
+
+///
+/// \brief Build CreateInfo from a precooked model: vertex / index blobs are copied straight into each Geometry
+///
+std::optional<Model::CreateInfo> uncook(io::lvmesh::Model const& model, stdfs::path const& modelID, stdfs::path const& jsonDir, stdfs::path const& samplerID) {
+	if (model.vertexStride != (u32)sizeof(gfx::Vertex)) {
+		logW("[{}] Precooked vertex stride mismatch: [{}] (expected [{}])", Model::s_tName, model.vertexStride, sizeof(gfx::Vertex));
+		return std::nullopt;
+	}
+	Model::CreateInfo ret;
+	ret.textures.reserve(model.textures.size());
+	for (auto const& texture : model.textures) {
+		Model::TexData tex;
+		tex.id = (modelID / texture.id).generic_string();
+		tex.hash = tex.id;
+		tex.filename = jsonDir / texture.filename;
+		tex.samplerID = samplerID;
+		ret.textures.push_back(std::move(tex));
+	}
+	ret.materials.reserve(model.materials.size());
+	for (auto const& material : model.materials) {
+		Model::MatData mat;
+		mat.id = (modelID / material.id).generic_string();
+		mat.hash = mat.id;
+		mat.diffuseIndices = indices(material.diffuseIndices);
+		mat.specularIndices = indices(material.specularIndices);
+		mat.bumpIndices = indices(material.bumpIndices);
+		mat.albedo = {material.ambient, material.diffuse, material.specular};
+		mat.shininess = material.shininess;
+		mat.flags = flags(material.flags);
+		ret.materials.push_back(std::move(mat));
+	}
+	ret.meshData.reserve(model.meshes.size());
+	for (auto const& mesh : model.meshes) {
+		Model::MeshData meshData;
+		meshData.id = (modelID / mesh.id).generic_string();
+		meshData.hash = meshData.id;
+		meshData.materialIndices = indices(mesh.materialIndices);
+		meshData.shininess = mesh.shininess;
+		meshData.geometry.vertices.resize(model.vertexCount(mesh));
+		std::memcpy(meshData.geometry.vertices.data(), mesh.vertices.pData, mesh.vertices.extent);
+		meshData.geometry.indices.assign(mesh.indices.begin(), mesh.indices.end());
+		ret.meshData.push_back(std::move(meshData));
+	}
+	return ret;
+}
+
+void loadTextures(Model::CreateInfo& out_info, io::Reader const& reader, [[maybe_unused]] std::string const& idStr) {
+#if defined(LEVK_PROFILE_MODEL_LOADS)
+	auto s = g_stopwatch.lap(idStr + "/TexData");
+#endif
+	for (auto& texture : out_info.textures) {
+		auto trace = g_loadTrace.scope(Texture::s_tName, texture.id.generic_string(), LoadTrace::Phase::eRead);
+		if (auto bytes = reader.bytes(texture.filename)) {
+			texture.bytes = std::move(*bytes);
+		} else {
+			logW("[{}] [{}] Failed to load texture [{}] from [{}]", Model::s_tName, idStr, texture.filename.generic_string(), reader.medium());
+		}
+	}
+}
+
 OBJParser::OBJParser(Data data)
-	: m_matStrReader(data.mtlBuf), m_modelID(std::move(data.modelID)), m_jsonID(std::move(data.jsonID)), m_samplerID(std::move(data.samplerID)),
+	: m_modelID(std::move(data.modelID)), m_jsonID(std::move(data.jsonID)), m_samplerID(std::move(data.samplerID)),
 	  m_origin(data.origin), m_scale(data.scale), m_bDropColour(data.bDropColour) {
 	auto const idStr = m_jsonID.generic_string();
 	std::string warn, err;
@@ -77,7 +273,13 @@ OBJParser::OBJParser(Data data)
 #if defined(LEVK_PROFILE_MODEL_LOADS)
 		auto s = g_stopwatch.lap(idStr + "/TinyObj");
 #endif
-		bOK = tinyobj::LoadObj(&m_attrib, &m_shapes, &m_materials, &warn, &err, &data.objBuf, &m_matStrReader);
+		auto trace = g_loadTrace.scope(Model::s_tName, idStr, LoadTrace::Phase::eDecode);
+		ViewBuf objBuf(data.obj.text());
+		ViewBuf mtlBuf(data.mtl.text());
+		std::istream objStr(&objBuf);
+		std::istream mtlStr(&mtlBuf);
+		tinyobj::MaterialStreamReader matStrReader(mtlStr);
+		bOK = tinyobj::LoadObj(&m_attrib, &m_shapes, &m_materials, &warn, &err, &objStr, &matStrReader);
 	}
 	if (m_shapes.empty()) {
 		bOK = false;
@@ -95,37 +297,29 @@ OBJParser::OBJParser(Data data)
 		logE("[{}] {}", Model::s_tName, err);
 	}
 	if (bOK) {
-		{
 #if defined(LEVK_PROFILE_MODEL_LOADS)
-			auto s = g_stopwatch.lap(idStr + "/MeshData");
+		auto s = g_stopwatch.lap(idStr + "/MeshData");
 #endif
-			for (auto const& shape : m_shapes) {
-				m_info.meshData.push_back(processShape(shape));
-			}
+		auto trace = g_loadTrace.scope(Model::s_tName, idStr, LoadTrace::Phase::eProcess);
+		// names and materials mutate shared state: serial (and cheap)
+		m_info.meshData.reserve(m_shapes.size());
+		for (auto const& shape : m_shapes) {
+			Model::MeshData meshData;
+			auto name = meshName(shape);
+			meshData.hash = name;
+			meshData.id = std::move(name);
+			meshData.materialIndices = materials(shape);
+			m_info.meshData.push_back(std::move(meshData));
 		}
-#if defined(LEVK_PROFILE_MODEL_LOADS)
-		auto s = g_stopwatch.lap(idStr + "/TexData");
-#endif
-		for (auto& texture : m_info.textures) {
-			if (auto bytes = engine::reader().bytes(texture.filename)) {
-				texture.bytes = std::move(*bytes);
-			} else {
-				logW("[{}] [{}] Failed to load texture [{}] from [{}]", Model::s_tName, idStr, texture.filename.generic_string(), engine::reader().medium());
+		// geometry only reads m_attrib: one band per shape, claimed by workers and this thread
+		tasks::forBands((u32)m_shapes.size(), (u32)m_shapes.size(), [this](u32 begin, u32 end) {
+			for (u32 idx = begin; idx < end; ++idx) {
+				m_info.meshData[idx].geometry = vertices(m_shapes[idx]);
 			}
-		}
+		});
 	}
 }
 
-Model::MeshData OBJParser::processShape(tinyobj::shape_t const& shape) {
-	Model::MeshData meshData;
-	auto name = meshName(shape);
-	meshData.hash = name;
-	meshData.id = std::move(name);
-	meshData.geometry = vertices(shape);
-	meshData.materialIndices = materials(shape);
-	return meshData;
-}
-
 std::size_t OBJParser::texIdx(std::string_view texName) {
 	auto const id = (m_modelID / texName).generic_string();
 	Hash const hash = id;
@@ -202,45 +396,34 @@ std::string OBJParser::meshName(tinyobj::shape_t const& shape) {
 	return ret;
 }
 
-gfx::Geometry OBJParser::vertices(tinyobj::shape_t const& shape) {
-	gfx::Geometry ret;
-	ret.reserve((u32)m_attrib.vertices.size(), (u32)shape.mesh.indices.size());
-	std::unordered_map<std::size_t, u32> hashToVertIdx;
-	hashToVertIdx.reserve(shape.mesh.indices.size());
+gfx::Geometry OBJParser::vertices(tinyobj::shape_t const& shape) const {
+	std::vector<weld::Corner> corners;
+	corners.reserve(shape.mesh.indices.size());
 	for (auto const& idx : shape.mesh.indices) {
-		// clang-format off
-		glm::vec3 const p = m_origin * m_scale + glm::vec3{
-			m_attrib.vertices[3 * (std::size_t)idx.vertex_index + 0] * m_scale,
-			m_attrib.vertices[3 * (std::size_t)idx.vertex_index + 1] * m_scale,
-			m_attrib.vertices[3 * (std::size_t)idx.vertex_index + 2] * m_scale
-		};
-		glm::vec3 const c = {
-			m_attrib.colors[3 * (std::size_t)idx.vertex_index + 0],
-			m_attrib.colors[3 * (std::size_t)idx.vertex_index + 1],
-			m_attrib.colors[3 * (std::size_t)idx.vertex_index + 2]
-		};
-		glm::vec3 const n = {
-			m_attrib.normals.empty() || idx.normal_index < 0 ? 0.0f : m_attrib.normals[3 * (std::size_t)idx.normal_index + 0],
-			m_attrib.normals.empty() || idx.normal_index < 0 ? 0.0f : m_attrib.normals[3 * (std::size_t)idx.normal_index + 1],
-			m_attrib.normals.empty() || idx.normal_index < 0 ? 0.0f : m_attrib.normals[3 * (std::size_t)idx.normal_index + 2]
-		};
-		auto const& at = m_attrib.texcoords;
-		glm::vec2 const t = {
-			at.empty() || idx.texcoord_index < 0 ? 0.0f : at[2 * (std::size_t)idx.texcoord_index + 0],
-			1.0f - (at.empty() || idx.texcoord_index < 0 ? 0.0f : at[2 * (std::size_t)idx.texcoord_index + 1]),
-		};
-		// clang-format on
-		auto const hash = std::hash<glm::vec3>()(p) ^ (std::hash<glm::vec3>()(n) << 1) ^ (std::hash<glm::vec3>()(c) << 2) ^ (std::hash<glm::vec2>()(t) << 3);
-		if (auto search = hashToVertIdx.find(hash); search != hashToVertIdx.end()) {
-			ret.indices.push_back((u32)search->second);
-		} else {
-			auto const idx = ret.addVertex({p, c, n, t});
-			ret.indices.push_back(idx);
-			hashToVertIdx[hash] = idx;
-		}
+		corners.push_back({idx.vertex_index, idx.normal_index, idx.texcoord_index});
 	}
-	ret.vertices.shrink_to_fit();
-	ret.indices.shrink_to_fit();
+	// exact (position, normal, texcoord) index triples: colours are per position
+	auto welded = weld::weld(corners);
+	gfx::Geometry ret;
+	ret.vertices.reserve(welded.vertices.size());
+	auto const& av = m_attrib.vertices;
+	auto const& ac = m_attrib.colors;
+	auto const& an = m_attrib.normals;
+	auto const& at = m_attrib.texcoords;
+	for (auto const& corner : welded.vertices) {
+		auto const v = 3 * (std::size_t)corner.position;
+		auto const n = 3 * (std::size_t)corner.normal;
+		auto const t = 2 * (std::size_t)corner.texCoord;
+		bool const bNormal = !an.empty() && corner.normal >= 0;
+		bool const bTexCoord = !at.empty() && corner.texCoord >= 0;
+		gfx::Vertex vertex;
+		vertex.position = m_origin * m_scale + glm::vec3(av[v + 0], av[v + 1], av[v + 2]) * m_scale;
+		vertex.colour = {ac[v + 0], ac[v + 1], ac[v + 2]};
+		vertex.normal = bNormal ? glm::vec3(an[n + 0], an[n + 1], an[n + 2]) : glm::vec3(0.0f);
+		vertex.texCoord = bTexCoord ? glm::vec2(at[t + 0], 1.0f - at[t + 1]) : glm::vec2(0.0f, 1.0f);
+		ret.vertices.push_back(vertex);
+	}
+	ret.indices = std::move(welded.indices);
 	return ret;
 }
 
@@ -257,71 +440,157 @@ std::vector<std::size_t> OBJParser::materials(tinyobj::shape_t const& shape) {
 	}
 	return std::vector<std::size_t>(uniqueIndices.begin(), uniqueIndices.end());
 }
-} // namespace
 
-Model::Info const& Model::info() const {
-	return res::info(*this);
+stdfs::path resolveJsonDir(Model::LoadInfo const& info) {
+	return info.jsonDirectory.empty() ? info.idRoot : info.jsonDirectory;
 }
 
-Status Model::status() const {
-	return res::status(*this);
+stdfs::path resolveModelID(Model::LoadInfo const& info) {
+	return info.idRoot.empty() ? resolveJsonDir(info) : info.idRoot;
 }
 
-template <>
-kt::result_void<Model::CreateInfo> LoadBase<Model>::createInfo() const {
-	auto pThis = static_cast<Model::LoadInfo const*>(this);
-	auto const jsonDir = pThis->jsonDirectory.empty() ? pThis->idRoot : pThis->jsonDirectory;
+kt::result_void<Model::CreateInfo> parse(Model::LoadInfo const& loadInfo, io::Reader const& reader, io::DiskCache const* pCache, bool bPrecooked) {
+	auto const jsonDir = resolveJsonDir(loadInfo);
 	if (jsonDir.empty()) {
 		logE("[{}] Empty resource ID!", Model::s_tName);
 		return {};
 	}
-	auto jsonFile = pThis->jsonFilename;
+	auto jsonFile = loadInfo.jsonFilename;
 	if (jsonFile.empty()) {
 		jsonFile = jsonDir.filename().generic_string();
 		jsonFile += ".json";
 	}
 	auto const jsonID = jsonDir / jsonFile;
-	auto jsonStr = engine::reader().string(jsonID);
+	auto const idStr = jsonID.generic_string();
+	auto trace = g_loadTrace.scope(Model::s_tName, idStr, LoadTrace::Phase::eRead);
+	auto jsonStr = reader.map(jsonID);
+	trace = {};
 	if (!jsonStr) {
-		logE("[{}] [{}] not found!", Model::s_tName, jsonID.generic_string());
+		logE("[{}] [{}] not found!", Model::s_tName, idStr);
 		return {};
 	}
 	dj::object json;
-	if (!json.read(*jsonStr) || json.fields.empty()) {
-		logE("[{}] Failed to read json: [{}]!", Model::s_tName, jsonID.generic_string());
+	if (!json.read(jsonStr->text()) || json.fields.empty()) {
+		logE("[{}] Failed to read json: [{}]!", Model::s_tName, idStr);
+	}
+	auto pSamplerID = json.find<dj::string>("sampler");
+	stdfs::path const samplerID = pSamplerID ? pSamplerID->value : "samplers/default";
+	u8 const lodCount = (u8)std::clamp((s64)json.value<dj::integer>("lods"), (s64)1, (s64)maths::max<u8>());
+	auto const vertexFormat = json.value<dj::string>("vertexFormat") == "packed" ? gfx::VertexFormat::ePacked : gfx::VertexFormat::eFull;
+	auto cookedID = jsonID;
+	cookedID.replace_extension(".lvmesh");
+	if (bPrecooked && reader.isPresent(cookedID)) {
+		std::optional<Model::CreateInfo> info;
+		{
+#if defined(LEVK_PROFILE_MODEL_LOADS)
+			auto s = g_stopwatch.lap(idStr + "/Precooked");
+#endif
+			trace = g_loadTrace.scope(Model::s_tName, idStr, LoadTrace::Phase::eRead);
+			if (auto mapped = reader.map(cookedID)) {
+				trace = g_loadTrace.scope(Model::s_tName, idStr, LoadTrace::Phase::eDecode);
+				if (auto model = io::lvmesh::parse(mapped->bytes())) {
+					info = uncook(*model, resolveModelID(loadInfo), jsonDir, samplerID);
+				}
+			}
+			trace = {};
+		}
+		if (info) {
+			if (loadInfo.bTextureBytes) {
+				loadTextures(*info, reader, idStr);
+			}
+			info->lodCount = lodCount;
+			info->vertexFormat = vertexFormat;
+			return std::move(*info);
+		}
+		logW("[{}] [{}] Invalid precooked model, falling back to .OBJ / .MTL", Model::s_tName, cookedID.generic_string());
 	}
 	auto const& obj = json.value<dj::string>("obj");
 	auto const& mtl = json.value<dj::string>("mtl");
 	if (mtl.empty() || obj.empty()) {
-		logE("[{}] No data in json: [{}]!", Model::s_tName, jsonID.generic_string());
+		logE("[{}] No data in json: [{}]!", Model::s_tName, idStr);
 		return {};
 	}
 	auto const objPath = jsonDir / obj;
 	auto const mtlPath = jsonDir / mtl;
-	if (!engine::reader().checkPresence(objPath) || !engine::reader().checkPresence(mtlPath)) {
-		logE("[{}] .OBJ / .MTL data not present in [{}]: [{}], [{}]!", Model::s_tName, engine::reader().medium(), objPath.generic_string(),
-			 mtlPath.generic_string());
+	if (!reader.checkPresence(objPath) || !reader.checkPresence(mtlPath)) {
+		logE("[{}] .OBJ / .MTL data not present in [{}]: [{}], [{}]!", Model::s_tName, reader.medium(), objPath.generic_string(), mtlPath.generic_string());
 		return {};
 	}
-	auto objBuf = engine::reader().sstream(objPath);
-	auto mtlBuf = engine::reader().sstream(mtlPath);
+	trace = g_loadTrace.scope(Model::s_tName, idStr, LoadTrace::Phase::eRead);
+	auto objBuf = reader.map(objPath);
+	auto mtlBuf = reader.map(mtlPath);
+	trace = {};
 	if (objBuf && mtlBuf) {
-		auto pSamplerID = json.find<dj::string>("sampler");
 		auto pScale = json.find<dj::floating>("scale");
 		OBJParser::Data objData;
-		objData.objBuf = objBuf.move();
-		objData.mtlBuf = mtlBuf.move();
-		objData.jsonID = std::move(jsonID);
-		objData.modelID = pThis->idRoot.empty() ? jsonDir : pThis->idRoot;
-		objData.samplerID = pSamplerID ? pSamplerID->value : "samplers/default";
+		objData.obj = objBuf.move();
+		objData.mtl = mtlBuf.move();
+		objData.jsonID = jsonID;
+		objData.modelID = resolveModelID(loadInfo);
+		objData.samplerID = samplerID;
 		objData.scale = pScale ? (f32)pScale->value : 1.0f;
 		objData.bDropColour = json.value<dj::boolean>("dropColour");
 		objData.origin = getVec3(json, "origin");
+		bool const bCache = pCache && pCache->active();
+		u64 cacheKey = 0;
+		if (bCache) {
+			auto const o = objData.origin;
+			auto const options = fmt::format("obj|{}|{}|{}|{}|{},{},{}|{}|{:016x}", objData.jsonID.generic_string(), objData.modelID.generic_string(),
+											 objData.samplerID.generic_string(), objData.scale, o.x, o.y, o.z, objData.bDropColour,
+											 io::DiskCache::key(objData.mtl.bytes()));
+			cacheKey = io::DiskCache::key(objData.obj.bytes(), options);
+			trace = g_loadTrace.scope(Model::s_tName, idStr, LoadTrace::Phase::eRead);
+			if (auto bytes = pCache->load(cacheKey)) {
+				trace = g_loadTrace.scope(Model::s_tName, idStr, LoadTrace::Phase::eDecode);
+				if (auto info = deserialise(*bytes, objData.samplerID)) {
+					trace = {};
+					if (loadInfo.bTextureBytes) {
+						loadTextures(*info, reader, idStr);
+					}
+					info->lodCount = lodCount;
+					info->vertexFormat = vertexFormat;
+					return std::move(*info);
+				}
+				pCache->erase(cacheKey);
+			}
+			trace = {};
+		}
 		OBJParser parser(std::move(objData));
+		if (bCache && !parser.m_info.meshData.empty()) {
+			pCache->store(cacheKey, serialise(parser.m_info));
+		}
+		if (loadInfo.bTextureBytes) {
+			loadTextures(parser.m_info, reader, idStr);
+		}
+		parser.m_info.lodCount = lodCount;
+		parser.m_info.vertexFormat = vertexFormat;
 		return std::move(parser.m_info);
 	}
 	return {};
 }
+} // namespace
+
+Model::Info const& Model::info() const {
+	return res::info(*this);
+}
+
+Status Model::status() const {
+	return res::status(*this);
+}
+
+template <>
+kt::result_void<Model::CreateInfo> LoadBase<Model>::createInfo() const {
+	return parse(*static_cast<Model::LoadInfo const*>(this), engine::reader(), &engine::assetCache(), true);
+}
+
+bytearray Model::LoadInfo::cook(io::Reader const& reader) const {
+	auto loadInfo = *this;
+	loadInfo.bTextureBytes = false;
+	if (auto info = parse(loadInfo, reader, nullptr, false); info && !info->meshData.empty()) {
+		return res::cook(*info, resolveModelID(loadInfo), resolveJsonDir(loadInfo));
+	}
+	return {};
+}
 
 std::vector<Mesh> Model::meshes() const {
 	if (auto pImpl = impl(*this)) {
@@ -338,51 +607,32 @@ bool Model::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 	m_meshes = std::move(out_createInfo.preloaded);
 	m_meshes.reserve(m_meshes.size() + out_createInfo.meshData.size());
 	for (auto& texture : out_createInfo.textures) {
-		res::Texture::CreateInfo texInfo;
-		texInfo.bytes = {std::move(texture.bytes)};
-		texInfo.samplerID = std::move(texture.samplerID);
-		texInfo.mode = out_createInfo.mode;
-		auto newTex = res::load(texture.id, std::move(texInfo));
-		m_textures.emplace(texture.hash, std::move(newTex));
+		if (texture.loaded.guid == GUID::null && !texture.bytes.empty()) {
+			texture.loaded = loadTexture(texture, out_createInfo.mode);
+		}
+		m_textures.emplace(texture.hash, texture.loaded);
 	}
 	for (auto& material : out_createInfo.materials) {
-		res::Material::CreateInfo matInfo;
-		matInfo.albedo = material.albedo;
-		auto newMat = res::load(material.id, std::move(matInfo));
-		m_loadedMaterials.emplace(material.hash, std::move(newMat));
-		res::Material::Inst newInst;
-		newInst.tint = out_createInfo.tint;
-		auto search = m_loadedMaterials.find(material.hash);
-		ENSURE(search != m_loadedMaterials.end(), "Invalid material index!");
-		newInst.material = search->second;
-		if (!material.diffuseIndices.empty()) {
-			std::size_t idx = material.diffuseIndices.front();
-			ENSURE(idx < out_createInfo.textures.size(), "Invalid texture index!");
-			auto search = m_textures.find(out_createInfo.textures[idx].hash);
-			ENSURE(search != m_textures.end(), "Invalid texture index");
-			newInst.diffuse = search->second;
-		}
-		if (!material.specularIndices.empty()) {
-			std::size_t idx = material.specularIndices.front();
-			ENSURE(idx < out_createInfo.textures.size(), "Invalid texture index!");
-			auto search = m_textures.find(out_createInfo.textures[idx].hash);
-			ENSURE(search != m_textures.end(), "Invalid texture index!");
-			newInst.specular = search->second;
+		if (material.loaded.guid == GUID::null) {
+			material.loaded = loadMaterial(material);
 		}
-		newInst.flags = material.flags;
-		m_materials.push_back(std::move(newInst));
+		m_loadedMaterials.emplace(material.hash, material.loaded);
+		m_materials.push_back(materialInst(out_createInfo, material));
 	}
 	for (auto& meshData : out_createInfo.meshData) {
-		res::Mesh::CreateInfo meshInfo;
+		Material::Inst material;
 		if (!meshData.materialIndices.empty()) {
 			std::size_t idx = meshData.materialIndices.front();
 			ENSURE(idx < m_materials.size(), "Invalid material index!");
-			meshInfo.material = m_materials[idx];
+			material = m_materials[idx];
+		}
+		if (meshData.loaded.guid == GUID::null) {
+			meshData.loaded = loadMesh(meshData, std::move(material), out_createInfo);
+		} else if (!meshData.materialIndices.empty()) {
+			// preloaded meshes may have been built before their textures
+			meshData.loaded.material() = std::move(material);
 		}
-		meshInfo.geometry = std::move(meshData.geometry);
-		meshInfo.type = out_createInfo.type;
-		auto newMesh = res::load(meshData.id, std::move(meshInfo));
-		m_loadedMeshes.push_back(std::move(newMesh));
+		m_loadedMeshes.push_back(meshData.loaded);
 		m_meshes.push_back(m_loadedMeshes.back());
 	}
 	out_info.origin = out_createInfo.origin;
@@ -392,6 +642,83 @@ bool Model::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 	return true;
 }
 
+Texture Model::Impl::loadTexture(TexData& out_texture, Texture::Space mode) {
+	Texture::CreateInfo texInfo;
+	texInfo.bytes = {std::move(out_texture.bytes)};
+	texInfo.samplerID = out_texture.samplerID;
+	texInfo.mode = mode;
+	return res::load(out_texture.id, std::move(texInfo));
+}
+
+Material Model::Impl::loadMaterial(MatData const& material) {
+	Material::CreateInfo matInfo;
+	matInfo.albedo = material.albedo;
+	return res::load(material.id, std::move(matInfo));
+}
+
+Mesh Model::Impl::loadMesh(MeshData& out_mesh, Material::Inst material, CreateInfo const& info) {
+	Mesh::CreateInfo meshInfo;
+	meshInfo.material = std::move(material);
+	meshInfo.geometry = std::move(out_mesh.geometry);
+	meshInfo.type = info.type;
+	meshInfo.bOptimise = info.type == Mesh::Type::eStatic;
+	meshInfo.lodCount = info.lodCount;
+	meshInfo.vertexFormat = info.vertexFormat;
+	return res::load(out_mesh.id, std::move(meshInfo));
+}
+
+void Model::Impl::preload(CreateInfo& out_createInfo, io::Reader const& reader, [[maybe_unused]] std::string const& idStr) {
+#if defined(LEVK_PROFILE_MODEL_LOADS)
+	auto s = g_stopwatch.lap(idStr + "/Preload");
+#endif
+	u32 const texCount = (u32)out_createInfo.textures.size();
+	u32 const count = texCount + (u32)out_createInfo.meshData.size();
+	if (count == 0) {
+		return;
+	}
+	// one band per texture / mesh: large textures and meshes do not hold up each other
+	tasks::forBands(count, count, [&out_createInfo, &reader, &idStr, texCount](u32 begin, u32 end) {
+		for (u32 idx = begin; idx < end; ++idx) {
+			if (idx < texCount) {
+				auto& texture = out_createInfo.textures[idx];
+				if (texture.loaded.guid != GUID::null) {
+					continue;
+				}
+				if (texture.bytes.empty()) {
+					auto trace = g_loadTrace.scope(Texture::s_tName, texture.id.generic_string(), LoadTrace::Phase::eRead);
+					if (auto bytes = reader.bytes(texture.filename)) {
+						texture.bytes = std::move(*bytes);
+					} else {
+						logW("[{}] [{}] Failed to load texture [{}] from [{}]", Model::s_tName, idStr, texture.filename.generic_string(), reader.medium());
+						continue;
+					}
+				}
+				texture.loaded = loadTexture(texture, out_createInfo.mode);
+			} else if (auto& meshData = out_createInfo.meshData[idx - texCount]; meshData.loaded.guid == GUID::null) {
+				meshData.loaded = loadMesh(meshData, {}, out_createInfo);
+			}
+		}
+	});
+}
+
+Material::Inst Model::Impl::materialInst(CreateInfo const& info, MatData const& material) {
+	Material::Inst ret;
+	ret.tint = info.tint;
+	ret.material = material.loaded;
+	if (!material.diffuseIndices.empty()) {
+		std::size_t idx = material.diffuseIndices.front();
+		ENSURE(idx < info.textures.size(), "Invalid texture index!");
+		ret.diffuse = info.textures[idx].loaded;
+	}
+	if (!material.specularIndices.empty()) {
+		std::size_t idx = material.specularIndices.front();
+		ENSURE(idx < info.textures.size(), "Invalid texture index!");
+		ret.specular = info.textures[idx].loaded;
+	}
+	ret.flags = material.flags;
+	return ret;
+}
+
 void Model::Impl::release() {
 }
 
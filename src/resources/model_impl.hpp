@@ -12,6 +12,22 @@ class Model::Impl : public ImplBase, ILoadable {
 	std::unordered_map<Hash, res::TScoped<res::Texture>> m_textures;
 
 	std::vector<res::Mesh> meshes() const;
+
+	///
+	/// \brief Load sub-resources individually (eg in parallel, before loading the Model itself)
+	///
+	static Texture loadTexture(TexData& out_texture, Texture::Space mode);
+	static Material loadMaterial(MatData const& material);
+	static Mesh loadMesh(MeshData& out_mesh, Material::Inst material, CreateInfo const& info);
+	///
+	/// \brief Read + decode each texture and build each mesh as its own job, in parallel (blocks until all are loaded)
+	/// Meshes are built without materials: make() assigns them once textures are available
+	///
+	static void preload(CreateInfo& out_createInfo, io::Reader const& reader, std::string const& idStr);
+	///
+	/// \brief Build a material instance out of loaded material and textures
+	///
+	static Material::Inst materialInst(CreateInfo const& info, MatData const& material);
 #if defined(LEVK_EDITOR)
 	std::deque<res::TScoped<res::Mesh>>& loadedMeshes();
 #endif
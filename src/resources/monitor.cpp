@@ -1,6 +1,7 @@
 #include <fmt/format.h>
 #include <core/log.hpp>
 #include <core/utils.hpp>
+#include <engine/levk.hpp>
 #include <resources/monitor.hpp>
 
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
@@ -9,9 +10,23 @@ Monitor::File::File(stdfs::path const& id, stdfs::path const& fullPath, io::File
 	: monitor(fullPath, mode), onModified(onModified), id(id) {
 }
 
+void Monitor::scheduleReload() {
+	if (m_reloadTimer) {
+		m_reloadTimer->cancel();
+	}
+	// generations ignore timers that fired before being cancelled / rescheduled
+	u64 const generation = ++m_reloadGeneration;
+	m_reloadTimer = tasks::enqueueAfter(
+		m_reloadWait, [due = m_reloadDue, generation]() { due->store(generation); }, "reload:" + m_id.generic_string());
+	if (!m_reloadTimer) {
+		// scheduler not running: reload on next update
+		m_reloadDue->store(generation);
+	}
+}
+
 bool Monitor::update() {
 	auto const idStr = m_id.generic_string();
-	if (m_reloadFails < m_reloadTries && m_reloadStart > Time() && Time::elapsed() - m_reloadStart > m_reloadWait) {
+	if (m_bReloadPending && m_reloadDue->load() == m_reloadGeneration) {
 		// reload all modified files
 		bool bSuccess = true;
 		for (auto pModified : m_modified) {
@@ -21,10 +36,11 @@ bool Monitor::update() {
 					bSuccess = false;
 					if (++m_reloadFails >= m_reloadTries) {
 						logE("[{}] Failed to reload file data! (Re-save to retry)", idStr);
+						m_bReloadPending = false;
 						break;
 					} else {
-						m_reloadStart = Time::elapsed();
 						m_reloadWait.scale(m_reloadFails * 2.0f);
+						scheduleReload();
 						logI("[{}] Retrying reload in [{}ms]!", idStr, m_reloadWait.to_ms());
 						break;
 					}
@@ -33,15 +49,22 @@ bool Monitor::update() {
 		}
 		if (bSuccess) {
 			m_modified.clear();
-			m_reloadStart = m_reloadWait = {};
+			m_reloadTimer.reset();
+			m_reloadWait = {};
 			m_reloadFails = 0;
+			m_bReloadPending = false;
 			// all files loaded successfully, trigger resource re-upload
 			return true;
 		}
 	}
 	// reload check
 	for (auto& file : m_files) {
+		auto const lastStatus = file.monitor.lastStatus();
 		auto status = file.monitor.update();
+		if (status != lastStatus && status != io::FileMonitor::Status::eUpToDate) {
+			// file lost / (re)created: update reader's cached lookup
+			engine::reader().refresh(file.id);
+		}
 		switch (status) {
 		default:
 		case io::FileMonitor::Status::eUpToDate:
@@ -52,9 +75,8 @@ bool Monitor::update() {
 			break;
 		}
 		case io::FileMonitor::Status::eModified: {
-			// add to tracking and reset reload timer
+			// add to tracking and (re)start reload timer
 			m_modified.insert(&file);
-			m_reloadStart = Time::elapsed();
 			if (m_reloadWait == Time()) {
 				m_reloadWait = m_reloadDelay;
 			}
@@ -62,6 +84,8 @@ bool Monitor::update() {
 				m_reloadWait = m_reloadDelay;
 				m_reloadFails = 0;
 			}
+			m_bReloadPending = true;
+			scheduleReload();
 			break;
 		}
 		}
@@ -5,10 +5,13 @@
 #include <engine/resources/resource_types.hpp>
 
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <unordered_set>
 #include <core/reader.hpp>
 #include <core/ref.hpp>
+#include <core/tasks.hpp>
 #include <core/time.hpp>
 
 namespace le::res {
@@ -24,8 +27,12 @@ class Monitor final {
 
   private:
 	std::unordered_set<File const*> m_modified;
-	Time m_reloadStart;
+	// set to the scheduled generation by the reload timer (on a worker thread) once m_reloadWait has elapsed
+	std::shared_ptr<std::atomic<u64>> m_reloadDue = std::make_shared<std::atomic<u64>>(0);
+	std::shared_ptr<tasks::Timer> m_reloadTimer;
+	u64 m_reloadGeneration = 0;
 	Time m_reloadWait;
+	bool m_bReloadPending = false;
 	u8 m_reloadTries = 3;
 	u8 m_reloadFails = 0;
 
@@ -35,6 +42,9 @@ class Monitor final {
   public:
 	// Returns true on reloaded
 	bool update();
+
+  private:
+	void scheduleReload();
 };
 
 struct Monitor::File final {
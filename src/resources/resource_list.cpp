@@ -40,6 +40,7 @@ constexpr std::size_t totalSize(T const&... t) {
 ResourceList ResourceList::operator*(const ResourceList& rhs) const {
 	ResourceList ret;
 	ret.shaders = intersect(shaders, rhs.shaders);
+	ret.samplers = intersect(samplers, rhs.samplers);
 	ret.textures = intersect(textures, rhs.textures);
 	ret.cubemaps = intersect(cubemaps, rhs.cubemaps);
 	ret.materials = intersect(materials, rhs.materials);
@@ -52,6 +53,7 @@ ResourceList ResourceList::operator*(const ResourceList& rhs) const {
 ResourceList ResourceList::operator-(const ResourceList& rhs) const {
 	ResourceList ret;
 	ret.shaders = subtract(shaders, rhs.shaders);
+	ret.samplers = subtract(samplers, rhs.samplers);
 	ret.textures = subtract(textures, rhs.textures);
 	ret.cubemaps = subtract(cubemaps, rhs.cubemaps);
 	ret.materials = subtract(materials, rhs.materials);
@@ -62,11 +64,11 @@ ResourceList ResourceList::operator-(const ResourceList& rhs) const {
 }
 
 bool ResourceList::empty() const {
-	return allEmpty(shaders, textures, cubemaps, materials, meshes, models, fonts);
+	return allEmpty(shaders, samplers, textures, cubemaps, materials, meshes, models, fonts);
 }
 
 std::size_t ResourceList::size() const {
-	return totalSize(shaders, textures, cubemaps, materials, meshes, models, fonts);
+	return totalSize(shaders, samplers, textures, cubemaps, materials, meshes, models, fonts);
 }
 
 std::string ResourceList::print() const {
@@ -78,6 +80,7 @@ std::string ResourceList::print() const {
 		}
 	};
 	add(shaders, "Shaders");
+	add(samplers, "Samplers");
 	add(textures, "Textures");
 	add(cubemaps, "Cubemaps");
 	add(materials, "Materials");
@@ -1,10 +1,12 @@
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <shared_mutex>
 #include <type_traits>
 #include <unordered_map>
+#include <core/deferred_log.hpp>
 #include <core/log.hpp>
-#include <core/map_store.hpp>
+#include <core/handle_table.hpp>
 #include <core/threads.hpp>
 #include <engine/game/stopwatch.hpp>
 #include <engine/levk.hpp>
@@ -21,22 +23,42 @@ using namespace res;
 
 template <typename T, typename TImpl = void>
 struct Map {
-	TMapStore<std::unordered_map<GUID, TResource<T, TImpl>>> resources;
+	// GUIDs are handles into this table: lookups by GUID are lock-free
+	THandleTable<TResource<T, TImpl>> resources;
 	std::unordered_map<Hash, GUID> ids;
 	std::unordered_map<GUID, Ref<TImpl>> loading;
+	// Evictable types only: 0 == unlimited
+	Footprint budget;
+	Footprint usage;
+	// Guards ids, loading, budget, usage, and all writes to resources
 	mutable kt::lockable<std::shared_mutex> mutex;
 };
 
 std::atomic<GUID::type> g_nextGUID;
 std::atomic<GUID::type> g_lastUnloadedGUID;
+// Advanced every update; unloaded resources are destroyed after a full epoch (main thread readers may hold pointers until then),
+// or later if a worker holding a Semaphore pinned an older epoch
+std::atomic<u64> g_epoch;
+ReaderEpochs g_readers;
+// Resources touched within this many epochs (frames in flight) are not evicted
+constexpr u64 g_evictAfter = 3;
 
 template <typename T, typename TImpl>
 T make(Map<T, TImpl>& out_map, typename T::CreateInfo& out_createInfo, stdfs::path const& id) {
-	GUID guid = ++g_nextGUID;
+	GUID guid;
+	{
+		auto lock = out_map.mutex.template lock<std::unique_lock>();
+		guid = out_map.resources.reserve((u32)++g_nextGUID);
+	}
+	if (guid == GUID::null) {
+		logE("[{}] Out of resource slots!", T::s_tName);
+		return {};
+	}
 	std::unique_ptr<TImpl> uImpl = std::make_unique<TImpl>();
 	typename T::Info info;
 	uImpl->id = info.id = id;
 	uImpl->guid = guid;
+	uImpl->lastUsed = g_epoch.load();
 	logW_if(id.empty(), "[{}] Empty resource ID!", T::s_tName);
 	if (!id.empty() && uImpl->make(out_createInfo, info)) {
 		T resource;
@@ -44,38 +66,42 @@ T make(Map<T, TImpl>& out_map, typename T::CreateInfo& out_createInfo, stdfs::pa
 		info.id = uImpl->id = id;
 		uImpl->guid = guid;
 		TImpl* pImpl = uImpl.get();
-		TResource<T, TImpl> tResource{std::move(info), resource, std::move(uImpl)};
+		auto uResource = std::make_unique<TResource<T, TImpl>>(TResource<T, TImpl>{std::move(info), resource, std::move(uImpl)});
 		auto lock = out_map.mutex.template lock<std::unique_lock>();
-		auto const guid = resource.guid;
 		out_map.ids[id] = guid;
-		out_map.resources.emplace(guid, std::move(tResource));
+		out_map.resources.publish(guid, std::move(uResource));
 		if (std::is_base_of_v<ILoadable, TImpl> && pImpl->status != Status::eReady) {
 			pImpl->status = Status::eLoading;
 			out_map.loading.emplace(guid, *pImpl);
-			logI("++ [{}] [{}] [{}] loading...", guid, T::s_tName, id.generic_string());
+			deferred::logI("++ [{}] [{}] [{}] loading...", guid.payload, T::s_tName, id.generic_string());
 		} else {
 			pImpl->status = Status::eReady;
-			logI("== [{}] [{}] [{}] loaded", guid, T::s_tName, id.generic_string());
+			deferred::logI("== [{}] [{}] [{}] loaded", guid.payload, T::s_tName, id.generic_string());
 		}
 		return resource;
 	}
+	auto lock = out_map.mutex.template lock<std::unique_lock>();
+	out_map.resources.unreserve(guid);
 	return {};
 }
 
 template <typename T, typename TImpl>
 res::Result<T> find(Map<T, TImpl> const& map, Hash id) {
-	auto lock = map.mutex.template lock<std::shared_lock>();
-	if (auto search = map.ids.find(id); search != map.ids.end()) {
-		if (auto pResource = map.resources.find(search->second)) {
-			return T{pResource->resource};
+	GUID guid;
+	{
+		auto lock = map.mutex.template lock<std::shared_lock>();
+		if (auto search = map.ids.find(id); search != map.ids.end()) {
+			guid = search->second;
 		}
 	}
+	if (auto pResource = map.resources.find(guid)) {
+		return T{pResource->resource};
+	}
 	return {};
 }
 
 template <typename T, typename TImpl>
 TImpl* findImpl(Map<T, TImpl>& map, GUID guid) {
-	auto lock = map.mutex.template lock<std::shared_lock>();
 	if (auto pResource = map.resources.find(guid)) {
 		return pResource->uImpl.get();
 	}
@@ -85,7 +111,6 @@ TImpl* findImpl(Map<T, TImpl>& map, GUID guid) {
 template <typename T, typename TImpl>
 typename T::Info const& findInfo(Map<T, TImpl>& out_map, GUID guid) {
 	static typename T::Info const s_default{};
-	auto lock = out_map.mutex.template lock<std::shared_lock>();
 	if (auto pResource = out_map.resources.find(guid)) {
 		return pResource->info;
 	}
@@ -94,7 +119,6 @@ typename T::Info const& findInfo(Map<T, TImpl>& out_map, GUID guid) {
 
 template <typename T, typename TImpl>
 typename T::Info* findInfoRW(Map<T, TImpl>& out_map, GUID guid) {
-	auto lock = out_map.mutex.template lock<std::shared_lock>();
 	if (auto pResource = out_map.resources.find(guid)) {
 		return &pResource->info;
 	}
@@ -102,39 +126,136 @@ typename T::Info* findInfoRW(Map<T, TImpl>& out_map, GUID guid) {
 }
 
 template <typename T, typename TImpl>
-bool unload(Map<T, TImpl>& out_map, Hash id) {
+bool unload(Map<T, TImpl>& out_map, GUID guid) {
 	auto lock = out_map.mutex.template lock<std::unique_lock>();
-	if (auto search = out_map.ids.find(id); search != out_map.ids.end()) {
-		auto const guid = search->second;
-		out_map.ids.erase(search);
-		if (auto tResource = out_map.resources.find(guid)) {
-			g_lastUnloadedGUID = guid;
-			logI("-- [{}] [{}] [{}] unloaded", guid, T::s_tName, tResource->uImpl->id.generic_string());
-			lock.unlock();
+	if (auto tResource = out_map.resources.find(guid)) {
+		g_lastUnloadedGUID = guid;
+		deferred::logI("-- [{}] [{}] [{}] unloaded", guid.payload, T::s_tName, tResource->uImpl->id.generic_string());
+		out_map.ids.erase(tResource->uImpl->id);
+		out_map.loading.erase(guid);
+		// retired objects outlive this call (and any pinned readers): safe to release after removal
+		bool const bRelease = !tResource->uImpl->bRestoring;
+		out_map.resources.remove(guid, g_epoch.load());
+		lock.unlock();
+		if (bRelease) {
 			tResource->uImpl->release();
-			lock.lock();
 		}
-		return out_map.resources.unload(guid);
+		return true;
 	}
 	return false;
 }
 
 template <typename T, typename TImpl>
-bool unload(Map<T, TImpl>& out_map, GUID guid) {
-	auto lock = out_map.mutex.template lock<std::unique_lock>();
-	if (auto tResource = out_map.resources.find(guid)) {
-		g_lastUnloadedGUID = guid;
-		logI("-- [{}] [{}] [{}] unloaded", guid, T::s_tName, tResource->uImpl->id.generic_string());
-		out_map.ids.erase(tResource->uImpl->id);
-		lock.unlock();
-		tResource->uImpl->release();
-		lock.lock();
+bool unload(Map<T, TImpl>& out_map, Hash id) {
+	GUID guid;
+	{
+		auto lock = out_map.mutex.template lock<std::shared_lock>();
+		if (auto search = out_map.ids.find(id); search != out_map.ids.end()) {
+			guid = search->second;
+		}
+	}
+	return guid != GUID::null && unload(out_map, guid);
+}
+
+template <typename T, typename TImpl>
+void restore(Map<T, TImpl>& out_map, GUID guid) {
+	// the semaphore blocks deinit and pins the resource until the task completes
+	auto semaphore = std::make_shared<Semaphore>(acquire());
+	auto task = [&out_map, guid, semaphore]() {
+		auto pResource = out_map.resources.find(guid);
+		if (!pResource) {
+			return;
+		}
+		TImpl& impl = *pResource->uImpl;
+		typename T::Info info;
+		{
+			auto lock = out_map.mutex.template lock<std::shared_lock>();
+			info = pResource->info;
+		}
+		// decode / mip generation / staging: off the main thread and without holding the map's lock
+		bool const bRestored = impl.restore(info);
+		auto lock = out_map.mutex.template lock<std::unique_lock>();
+		impl.bRestoring = false;
+		if (out_map.resources.find(guid) != pResource) {
+			// unloaded meanwhile (and release() was skipped)
+			lock.unlock();
+			impl.release();
+			return;
+		}
+		if (bRestored) {
+			pResource->info = std::move(info);
+			out_map.loading.emplace(guid, impl);
+		} else {
+			deferred::logE("[{}] [{}] Failed to restore evicted resource!", T::s_tName, impl.id.generic_string());
+			impl.status = Status::eError;
+		}
+	};
+	tasks::enqueue(std::move(task), "restore:" + out_map.resources.find(guid)->uImpl->id.generic_string());
+}
+
+template <typename T, typename TImpl>
+void evict(Map<T, TImpl>& out_map, u64 epoch) {
+	if constexpr (std::is_base_of_v<IEvictable, TImpl>) {
+		auto lock = out_map.mutex.template lock<std::unique_lock>();
+		Footprint usage;
+		std::vector<TResource<T, TImpl>*> candidates;
+		std::vector<GUID> restores;
+		out_map.resources.forEach([&](GUID guid, TResource<T, TImpl>& tResource) {
+			TImpl& impl = *tResource.uImpl;
+			if (impl.status == Status::eEvicted && impl.bRestore.exchange(false)) {
+				deferred::logD("++ [{}] [{}] [{}] restoring...", guid.payload, T::s_tName, impl.id.generic_string());
+				impl.status = Status::eLoading;
+				impl.bRestoring = true;
+				restores.push_back(guid);
+			}
+			auto const footprint = impl.footprint();
+			usage.cpu += footprint.cpu;
+			usage.vram += footprint.vram;
+			bool const bIdle = impl.status == Status::eReady || impl.status == Status::eEvicted;
+			if (bIdle && impl.refCount.load() <= 0 && impl.lastUsed.load() + g_evictAfter <= epoch) {
+				candidates.push_back(&tResource);
+			}
+		});
+		for (GUID const guid : restores) {
+			restore(out_map, guid);
+		}
+		auto const& budget = out_map.budget;
+		auto over = [&usage, &budget]() { return (budget.cpu > 0 && usage.cpu > budget.cpu) || (budget.vram > 0 && usage.vram > budget.vram); };
+		if (over()) {
+			std::sort(candidates.begin(), candidates.end(), [](auto pLhs, auto pRhs) { return pLhs->uImpl->lastUsed.load() < pRhs->uImpl->lastUsed.load(); });
+			for (auto pResource : candidates) {
+				if (!over()) {
+					break;
+				}
+				TImpl& impl = *pResource->uImpl;
+				auto const before = impl.footprint();
+				bool bEvicted = false;
+				if (budget.vram > 0 && usage.vram > budget.vram && impl.evictVRAM()) {
+					impl.status = Status::eEvicted;
+					bEvicted = true;
+				}
+				if (budget.cpu > 0 && usage.cpu > budget.cpu && impl.evictCPU()) {
+					bEvicted = true;
+				}
+				if (bEvicted) {
+					auto const after = impl.footprint();
+					usage.cpu -= before.cpu - after.cpu;
+					usage.vram -= before.vram - after.vram;
+					deferred::logD("-- [{}] [{}] [{}] evicted ({} bytes)", pResource->resource.guid.payload, T::s_tName, impl.id.generic_string(),
+								   (before.cpu - after.cpu) + (before.vram - after.vram));
+				}
+			}
+		}
+		out_map.usage = usage;
 	}
-	return out_map.resources.unload(guid);
 }
 
 template <typename T, typename TImpl>
 void update(Map<T, TImpl>& out_map) {
+	if (auto const epoch = g_epoch.load(); epoch > 0) {
+		auto lock = out_map.mutex.template lock<std::unique_lock>();
+		out_map.resources.reclaim(g_readers.oldest(epoch - 1));
+	}
 	if constexpr (std::is_base_of_v<ILoadable, TImpl>) {
 		auto lock = out_map.mutex.template lock<std::unique_lock>();
 		for (auto iter = out_map.loading.begin(); iter != out_map.loading.end();) {
@@ -143,7 +264,7 @@ void update(Map<T, TImpl>& out_map) {
 			if (impl.update()) {
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
 				if (impl.bLoadedOnce) {
-					logD("== [{}] [{}] [{}] reloaded", guid, T::s_tName, impl.id.generic_string());
+					deferred::logD("== [{}] [{}] [{}] reloaded", guid.payload, T::s_tName, impl.id.generic_string());
 					if constexpr (std::is_base_of_v<IReloadable, TImpl>) {
 						impl.onReload();
 					}
@@ -157,21 +278,22 @@ void update(Map<T, TImpl>& out_map) {
 			}
 		}
 	}
+	evict(out_map, g_epoch.load());
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
 	if constexpr (std::is_base_of_v<IReloadable, TImpl>) {
-		auto lock = out_map.mutex.template lock<std::shared_lock>();
-		for (auto& [guid, tResource] : out_map.resources.m_map) {
+		auto lock = out_map.mutex.template lock<std::unique_lock>();
+		out_map.resources.forEach([&out_map](GUID guid, TResource<T, TImpl>& tResource) {
 			if (tResource.uImpl->checkReload()) {
 				if constexpr (std::is_base_of_v<ILoadable, TImpl>) {
-					logD("++ [{}] [{}] [{}] reloading...", guid, T::s_tName, tResource.uImpl->id.generic_string());
+					deferred::logD("++ [{}] [{}] [{}] reloading...", guid.payload, T::s_tName, tResource.uImpl->id.generic_string());
 					tResource.uImpl->status = Status::eReloading;
 					out_map.loading.emplace(guid, *tResource.uImpl);
 				} else {
-					logD("== [{}] [{}] [{}] reloaded", guid, T::s_tName, tResource.uImpl->id.generic_string());
+					deferred::logD("== [{}] [{}] [{}] reloaded", guid.payload, T::s_tName, tResource.uImpl->id.generic_string());
 					tResource.uImpl->onReload();
 				}
 			}
-		}
+		});
 	}
 #endif
 }
@@ -192,6 +314,15 @@ void waitLoading(Map<T, TImpl>& out_map) {
 	}
 }
 
+template <typename T>
+void preload(typename T::CreateInfo&, std::string const&) {
+}
+
+template <>
+void preload<Model>(Model::CreateInfo& out_createInfo, std::string const& idStr) {
+	Model::Impl::preload(out_createInfo, engine::reader(), idStr);
+}
+
 template <typename T>
 Async<T> asyncLoad(stdfs::path const& id, typename T::LoadInfo loadInfo) {
 	auto name = "load_async:" + id.generic_string();
@@ -201,6 +332,7 @@ Async<T> asyncLoad(stdfs::path const& id, typename T::LoadInfo loadInfo) {
 			auto engine_s = engine::setBusy();
 			auto res_s = acquire();
 			if (auto info = loadInfo.createInfo()) {
+				preload<T>(*info, id.generic_string());
 				load(id, std::move(*info));
 			} else {
 				logE("[{}] Failed to load [{}]", T::s_tName, id.generic_string());
@@ -211,19 +343,20 @@ Async<T> asyncLoad(stdfs::path const& id, typename T::LoadInfo loadInfo) {
 }
 
 template <typename T, typename TImpl>
-void release(Map<T, TImpl>& out_map) {
+void releaseAll(Map<T, TImpl>& out_map) {
 	waitLoading(out_map);
-	auto lock = out_map.mutex.template lock<std::unique_lock>();
-	for (auto iter = out_map.resources.m_map.begin(); iter != out_map.resources.m_map.end();) {
-		auto& [guid, tResource] = *iter;
-		g_lastUnloadedGUID = guid;
-		logI("-- [{}] [{}] [{}] unloaded", guid, T::s_tName, tResource.uImpl->id.generic_string());
-		lock.unlock();
+	std::vector<Ref<TResource<T, TImpl>>> released;
+	{
+		auto lock = out_map.mutex.template lock<std::unique_lock>();
+		out_map.resources.forEach([&released](GUID, TResource<T, TImpl>& tResource) { released.push_back(tResource); });
+	}
+	for (TResource<T, TImpl>& tResource : released) {
+		g_lastUnloadedGUID = tResource.resource.guid;
+		deferred::logI("-- [{}] [{}] [{}] unloaded", tResource.resource.guid.payload, T::s_tName, tResource.uImpl->id.generic_string());
 		tResource.uImpl->release();
-		lock.lock();
-		iter = out_map.resources.m_map.erase(iter);
 	}
-	out_map.resources.unloadAll();
+	auto lock = out_map.mutex.template lock<std::unique_lock>();
+	out_map.resources.clear();
 	out_map.ids.clear();
 	out_map.loading.clear();
 }
@@ -246,9 +379,7 @@ io::PathTree<T> const& loaded(Map<T, TImpl> const& map) {
 		s_guid = g_nextGUID;
 		s_unloaded = g_lastUnloadedGUID;
 		s_ret = {};
-		for (auto const& [_, resource] : map.resources.m_map) {
-			s_ret.emplace(resource.info.id, T{resource.resource});
-		}
+		map.resources.forEach([](GUID, TResource<T, TImpl> const& resource) { s_ret.emplace(resource.info.id, T{resource.resource}); });
 	}
 	return s_ret;
 }
@@ -273,7 +404,7 @@ TCounter<s32> g_counter;
 } // namespace
 
 res::Semaphore res::acquire() {
-	return Semaphore(g_counter);
+	return {TCounter<s32>::Semaphore(g_counter), g_readers.pin(g_epoch.load())};
 }
 
 res::Shader res::load(stdfs::path const& id, Shader::CreateInfo createInfo) {
@@ -465,6 +596,8 @@ res::Model res::load(stdfs::path const& id, Model::CreateInfo createInfo) {
 }
 
 res::Async<res::Model> res::loadAsync(stdfs::path const& id, Model::LoadInfo loadInfo) {
+	// texture files are read (and decoded) in parallel with mesh builds by preload<Model>
+	loadInfo.bTextureBytes = false;
 	return g_bInit ? asyncLoad<res::Model>(id, std::move(loadInfo)) : Async<res::Model>();
 }
 
@@ -608,6 +741,94 @@ bool res::isLoading(GUID guid) {
 	return false;
 }
 
+template <typename T>
+bool res::retain(T resource) {
+	if (auto pImpl = impl(resource)) {
+		++pImpl->refCount;
+		touch(resource);
+		return true;
+	}
+	return false;
+}
+
+template <typename T>
+bool res::release(T resource) {
+	if (auto pImpl = impl(resource)) {
+		ENSURE(pImpl->refCount.load() > 0, "Unbalanced release!");
+		--pImpl->refCount;
+		return true;
+	}
+	return false;
+}
+
+template <typename T>
+void res::touch(T resource) {
+	if (auto pImpl = impl(resource)) {
+		pImpl->lastUsed.store(g_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		if (pImpl->status == Status::eEvicted) {
+			pImpl->bRestore.store(true);
+		}
+	}
+}
+
+template bool res::retain<Shader>(Shader);
+template bool res::retain<Sampler>(Sampler);
+template bool res::retain<Texture>(Texture);
+template bool res::retain<Material>(Material);
+template bool res::retain<Mesh>(Mesh);
+template bool res::retain<Font>(Font);
+template bool res::retain<Model>(Model);
+template bool res::release<Shader>(Shader);
+template bool res::release<Sampler>(Sampler);
+template bool res::release<Texture>(Texture);
+template bool res::release<Material>(Material);
+template bool res::release<Mesh>(Mesh);
+template bool res::release<Font>(Font);
+template bool res::release<Model>(Model);
+template void res::touch<Shader>(Shader);
+template void res::touch<Sampler>(Sampler);
+template void res::touch<Texture>(Texture);
+template void res::touch<Material>(Material);
+template void res::touch<Mesh>(Mesh);
+template void res::touch<Font>(Font);
+template void res::touch<Model>(Model);
+
+template <>
+void res::setBudget<Texture>(Footprint budget) {
+	auto lock = g_textures.mutex.lock<std::unique_lock>();
+	g_textures.budget = budget;
+}
+
+template <>
+Footprint res::budget<Texture>() {
+	auto lock = g_textures.mutex.lock<std::shared_lock>();
+	return g_textures.budget;
+}
+
+template <>
+Footprint res::usage<Texture>() {
+	auto lock = g_textures.mutex.lock<std::shared_lock>();
+	return g_textures.usage;
+}
+
+template <>
+void res::setBudget<Mesh>(Footprint budget) {
+	auto lock = g_meshes.mutex.lock<std::unique_lock>();
+	g_meshes.budget = budget;
+}
+
+template <>
+Footprint res::budget<Mesh>() {
+	auto lock = g_meshes.mutex.lock<std::shared_lock>();
+	return g_meshes.budget;
+}
+
+template <>
+Footprint res::usage<Mesh>() {
+	auto lock = g_meshes.mutex.lock<std::shared_lock>();
+	return g_meshes.usage;
+}
+
 void res::init() {
 	if (!g_bInit) {
 		g_bInit = true;
@@ -622,6 +843,15 @@ void res::init() {
 			info.codeIDMap[(std::size_t)Shader::Type::eFragment] = shaderIDs[1];
 			load("shaders/default", std::move(info));
 		}
+		{
+			// variant for gfx::VertexFormat::ePacked meshes
+			Shader::CreateInfo info;
+			static std::array const shaderIDs = {stdfs::path("shaders/uber_packed.vert"), stdfs::path("shaders/uber.frag")};
+			ENSURE(engine::reader().checkPresences(shaderIDs), "Packed Uber Shader not found!");
+			info.codeIDMap[(std::size_t)Shader::Type::eVertex] = shaderIDs[0];
+			info.codeIDMap[(std::size_t)Shader::Type::eFragment] = shaderIDs[1];
+			load("shaders/default_packed", std::move(info));
+		}
 		{
 			load("samplers/default", Sampler::CreateInfo());
 			Sampler::CreateInfo info;
@@ -634,9 +864,9 @@ void res::init() {
 			Texture::CreateInfo info;
 			info.type = Texture::Type::e2D;
 			info.raws = {{Span<u8>(white1pxBytes), {1, 1}}};
-			load("textures/white", info);
+			retain(load("textures/white", info));
 			info.raws.back().bytes = Span<u8>(black1pxBytes);
-			load("textures/black", info);
+			retain(load("textures/black", info));
 		}
 		{
 			Texture::CreateInfo info;
@@ -645,7 +875,7 @@ void res::init() {
 			b1px.size = {1, 1};
 			info.raws = {b1px, b1px, b1px, b1px, b1px, b1px};
 			info.type = Texture::Type::eCube;
-			load("cubemaps/blank", std::move(info));
+			retain(load("cubemaps/blank", std::move(info)));
 		}
 		{ load("materials/default", Material::CreateInfo()); }
 		{
@@ -674,6 +904,7 @@ void res::init() {
 }
 
 void res::update() {
+	++g_epoch;
 	update(g_shaders);
 	update(g_samplers);
 	update(g_textures);
@@ -706,13 +937,13 @@ void res::waitIdle() {
 void res::deinit() {
 	if (g_bInit) {
 		waitIdle();
-		release(g_shaders);
-		release(g_samplers);
-		release(g_textures);
-		release(g_materials);
-		release(g_meshes);
-		release(g_fonts);
-		release(g_models);
+		releaseAll(g_shaders);
+		releaseAll(g_samplers);
+		releaseAll(g_textures);
+		releaseAll(g_materials);
+		releaseAll(g_meshes);
+		releaseAll(g_fonts);
+		releaseAll(g_models);
 		g_bInit = false;
 		logI("[resources] deinitialised");
 	}
@@ -1,8 +1,12 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <core/delegate.hpp>
+#include <core/load_trace.hpp>
 #include <core/maths.hpp>
+#include <core/mip_chain.hpp>
 #include <core/path_tree.hpp>
+#include <core/vertex_quantise.hpp>
 #include <engine/resources/resource_types.hpp>
 #include <gfx/common.hpp>
 #include <resources/monitor.hpp>
@@ -22,6 +26,12 @@ struct ImplBase {
 	GUID guid;
 	Status status = Status::eIdle;
 	bool bLoadedOnce = false;
+	// Eviction bookkeeping: written lock-free by retain/release/touch
+	std::atomic<s32> refCount = 0;
+	std::atomic<u64> lastUsed = 0;
+	std::atomic<bool> bRestore = false;
+	// Set while a restore task is in flight (guarded by the map's mutex): unload leaves release() to the task
+	bool bRestoring = false;
 };
 
 struct ILoadable {
@@ -30,6 +40,18 @@ struct ILoadable {
 	}
 };
 
+struct IEvictable {
+	Footprint footprint() const {
+		return {};
+	}
+	bool evictVRAM() {
+		return false;
+	}
+	bool evictCPU() {
+		return false;
+	}
+};
+
 struct IReloadable {
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
 	Delegate<> onReload;
@@ -78,14 +100,22 @@ struct Sampler::Impl : ImplBase {
 	void release();
 };
 
-struct Texture::Impl : ImplBase, ILoadable, IReloadable {
+struct Texture::Impl : ImplBase, ILoadable, IReloadable, IEvictable {
 	gfx::Image active;
 	std::vector<Texture::Raw> raws;
+	// Levels below each raw (one chain per layer)
+	std::vector<mips::Chain> mipChains;
 	std::vector<Span<u8>> spanRaws;
+	std::vector<stdfs::path> sourceIDs;
+	bytearray ktx2;
 	vk::ImageView imageView;
 	vk::ImageViewType type;
 	vk::Format colourSpace;
 	std::future<void> copied;
+	// start of the GPU transfer (load trace)
+	Time staged;
+	u32 mipLevels = 1;
+	bool bMipMaps = true;
 	bool bStbiRaw = false;
 
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
@@ -101,6 +131,14 @@ struct Texture::Impl : ImplBase, ILoadable, IReloadable {
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
 	bool checkReload();
 #endif
+
+	Footprint footprint() const;
+	bool evictVRAM();
+	bool evictCPU();
+	bool restore(Info& out_info);
+	bool decodeSources();
+	void stageLevels(glm::ivec2 size);
+	bool stageKTX2(Info& out_info);
 };
 
 struct Material::Impl : ImplBase {
@@ -108,16 +146,30 @@ struct Material::Impl : ImplBase {
 	void release();
 };
 
-struct Mesh::Impl : ImplBase, ILoadable {
+struct Mesh::Impl : ImplBase, ILoadable, IEvictable {
 	struct Data {
 		gfx::Buffer buffer;
 		std::future<void> copied;
 		u32 count = 0;
+		vk::IndexType indexType = vk::IndexType::eUint32;
+	};
+	// range of geo.indices drawn for a level of detail
+	struct Lod {
+		u32 first = 0;
+		u32 count = 0;
 	};
 
 	gfx::Geometry geo;
+	std::vector<Lod> lods;
+	// staging sources for 16-bit indices / packed vertices, held until the copies complete
+	std::vector<u16> indices16;
+	std::vector<quantise::PackedVertex> packed;
+	// dequantisation of packed positions (applied to the model matrix)
+	quantise::Bounds bounds;
 	Data vbo;
 	Data ibo;
+	// start of the GPU transfer (load trace)
+	Time staged;
 
 	bool make(CreateInfo& out_createInfo, Info& out_info);
 	void release();
@@ -125,6 +177,11 @@ struct Mesh::Impl : ImplBase, ILoadable {
 	bool update();
 
 	void updateGeometry(Info& out_info, gfx::Geometry geometry);
+	void generateLods(Info& out_info, gfx::Geometry& out_geometry, u8 lodCount);
+
+	Footprint footprint() const;
+	bool evictVRAM();
+	bool restore(Info& out_info);
 };
 
 struct Font::Impl : ImplBase, ILoadable, IReloadable {
@@ -1,5 +1,12 @@
+#include <cstdlib>
+#include <cstring>
 #include <stb/stb_image.h>
+#include <core/deferred_log.hpp>
+#include <core/ktx2.hpp>
 #include <core/log.hpp>
+#include <core/mesh_optimiser.hpp>
+#include <core/mesh_simplifier.hpp>
+#include <core/mip_chain.hpp>
 #include <engine/resources/resources.hpp>
 #include <engine/resources/shader_compiler.hpp>
 #include <gfx/common.hpp>
@@ -17,14 +24,16 @@ std::array const g_samplerModes = {vk::SamplerAddressMode::eRepeat, vk::SamplerA
 std::array const g_texModes = {vk::Format::eR8G8B8A8Srgb, vk::Format::eR8G8B8A8Snorm};
 std::array const g_texTypes = {vk::ImageViewType::e2D, vk::ImageViewType::eCube};
 
-std::future<void> load(gfx::Image& out_image, vk::Format texMode, glm::ivec2 const& size, Span<Span<u8>> bytes, [[maybe_unused]] std::string_view name) {
-	if (out_image.image == vk::Image() || out_image.extent.width != (u32)size.x || out_image.extent.height != (u32)size.y) {
+// bytes: one entry per (layer, level), layer-major
+std::future<void> load(gfx::Image& out_image, vk::Format texMode, glm::ivec2 const& size, u32 mipLevels, Span<Span<u8>> bytes,
+					   [[maybe_unused]] std::string_view name) {
+	if (out_image.image == vk::Image() || out_image.extent.width != (u32)size.x || out_image.extent.height != (u32)size.y || out_image.mipLevels != mipLevels) {
 		gfx::ImageInfo imageInfo;
 		imageInfo.queueFlags = gfx::QFlag::eTransfer | gfx::QFlag::eGraphics;
 		imageInfo.createInfo.format = texMode;
 		imageInfo.createInfo.initialLayout = vk::ImageLayout::eUndefined;
 		imageInfo.createInfo.usage = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
-		if (bytes.extent > 1) {
+		if (bytes.extent > mipLevels) {
 			imageInfo.createInfo.flags = vk::ImageCreateFlagBits::eCubeCompatible;
 		}
 		imageInfo.vmaUsage = VMA_MEMORY_USAGE_GPU_ONLY;
@@ -32,8 +41,8 @@ std::future<void> load(gfx::Image& out_image, vk::Format texMode, glm::ivec2 con
 		imageInfo.createInfo.tiling = vk::ImageTiling::eOptimal;
 		imageInfo.createInfo.imageType = vk::ImageType::e2D;
 		imageInfo.createInfo.initialLayout = vk::ImageLayout::eUndefined;
-		imageInfo.createInfo.mipLevels = 1;
-		imageInfo.createInfo.arrayLayers = (u32)bytes.extent;
+		imageInfo.createInfo.mipLevels = mipLevels;
+		imageInfo.createInfo.arrayLayers = (u32)(bytes.extent / mipLevels);
 #if defined(LEVK_VKRESOURCE_NAMES)
 		imageInfo.name = std::string(name);
 #endif
@@ -42,10 +51,44 @@ std::future<void> load(gfx::Image& out_image, vk::Format texMode, glm::ivec2 con
 	return gfx::vram::copy(bytes, out_image, {vk::ImageLayout::eUndefined, vk::ImageLayout::eShaderReadOnlyOptimal});
 }
 
-Result<Texture::Raw> imgToRaw(bytearray imgBytes, std::string_view tName, std::string_view id, dl::level errLevel) {
+std::optional<Texture::Raw> cachedRaw(u64 key) {
+	auto bytes = engine::assetCache().load(key);
+	glm::ivec2 size;
+	if (!bytes || bytes->size() < sizeof(size)) {
+		return std::nullopt;
+	}
+	std::memcpy(&size, bytes->data(), sizeof(size));
+	std::size_t const pixels = bytes->size() - sizeof(size);
+	if (size.x <= 0 || size.y <= 0 || pixels != (std::size_t)(size.x * size.y * 4)) {
+		return std::nullopt;
+	}
+	// released via stbi_image_free (STBI_FREE: free)
+	auto pOut = static_cast<u8*>(std::malloc(pixels));
+	if (!pOut) {
+		return std::nullopt;
+	}
+	std::memcpy(pOut, bytes->data() + sizeof(size), pixels);
+	return Texture::Raw{Span(pOut, pixels), size};
+}
+
+void cacheRaw(u64 key, Texture::Raw const& raw) {
+	bytearray bytes(sizeof(raw.size) + raw.bytes.size());
+	std::memcpy(bytes.data(), &raw.size, sizeof(raw.size));
+	std::memcpy(bytes.data() + sizeof(raw.size), raw.bytes.pData, raw.bytes.size());
+	engine::assetCache().store(key, bytes);
+}
+
+Result<Texture::Raw> imgToRaw(Span<std::byte> imgBytes, std::string_view tName, std::string_view id, dl::level errLevel) {
+	bool const bCache = engine::assetCache().active();
+	u64 const key = bCache ? io::DiskCache::key(imgBytes, "rgba8") : 0;
+	if (bCache) {
+		if (auto raw = cachedRaw(key)) {
+			return std::move(*raw);
+		}
+	}
 	Texture::Raw ret;
 	s32 ch;
-	auto pIn = reinterpret_cast<stbi_uc const*>(imgBytes.data());
+	auto pIn = reinterpret_cast<stbi_uc const*>(imgBytes.pData);
 	auto pOut = stbi_load_from_memory(pIn, (s32)imgBytes.size(), &ret.size.x, &ret.size.y, &ch, 4);
 	if (!pOut) {
 		dl::log(errLevel, "[{}] [{}] Failed to load image data!", tName, id);
@@ -53,6 +96,9 @@ Result<Texture::Raw> imgToRaw(bytearray imgBytes, std::string_view tName, std::s
 	}
 	std::size_t const size = (std::size_t)(ret.size.x * ret.size.y * 4);
 	ret.bytes = Span(pOut, size);
+	if (bCache) {
+		cacheRaw(key, ret);
+	}
 	return ret;
 }
 
@@ -158,6 +204,8 @@ Status Font::status() const {
 
 void Mesh::updateGeometry(gfx::Geometry geometry) {
 	if (auto pImpl = res::impl(*this); auto pInfo = res::infoRW(*this)) {
+		pImpl->lods.clear();
+		pInfo->lodErrors.clear();
 		pImpl->updateGeometry(*pInfo, std::move(geometry));
 	}
 }
@@ -302,7 +350,7 @@ bool Shader::Impl::make(CreateInfo& out_createInfo, Info&) {
 								}
 								return true;
 							};
-							monitor.m_files.push_back({codeID, pReader->fullPath(codeID), io::FileMonitor::Mode::eTextContents, onReloaded});
+							monitor.m_files.push_back({codeID, pReader->fullPath(codeID), io::FileMonitor::Mode::eContentHash, onReloaded});
 						}
 #endif
 					} else {
@@ -436,7 +484,7 @@ bool Sampler::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 	samplerInfo.mipmapMode = g_mipModes[(std::size_t)out_createInfo.mip];
 	samplerInfo.mipLodBias = 0.0f;
 	samplerInfo.minLod = 0.0f;
-	samplerInfo.maxLod = 0.0f;
+	samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
 	sampler = gfx::g_device.device.createSampler(samplerInfo);
 	out_info.min = out_createInfo.min;
 	out_info.mag = out_createInfo.mag;
@@ -469,15 +517,29 @@ bool Texture::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 	}
 	type = g_texTypes[(std::size_t)out_createInfo.type];
 	colourSpace = g_texModes[(std::size_t)out_createInfo.mode];
+	bMipMaps = out_createInfo.bMipMaps;
 	[[maybe_unused]] bool bAddFileMonitor = false;
-	if (!out_createInfo.raws.empty()) {
+	if (!out_createInfo.ktx2.empty()) {
+		ktx2 = std::move(out_createInfo.ktx2);
+	} else if (out_createInfo.bytes.size() == 1 && io::ktx2::identify(out_createInfo.bytes.front())) {
+		ktx2 = std::move(out_createInfo.bytes.front());
+	} else if (out_createInfo.ids.size() == 1 && out_createInfo.ids.front().extension() == ".ktx2") {
+		auto trace = g_loadTrace.scope(Texture::s_tName, idStr, LoadTrace::Phase::eRead);
+		auto bytes = engine::reader().bytes(out_createInfo.ids.front());
+		if (!bytes) {
+			logE("[{}] [{}] Failed to read [{}]!", Texture::s_tName, idStr, out_createInfo.ids.front().generic_string());
+			return false;
+		}
+		ktx2 = std::move(*bytes);
+	} else if (!out_createInfo.raws.empty()) {
 		bStbiRaw = false;
 		for (auto& raw : out_createInfo.raws) {
 			raws.push_back(std::move(raw));
 		}
 	} else if (!out_createInfo.bytes.empty()) {
+		auto trace = g_loadTrace.scope(Texture::s_tName, idStr, LoadTrace::Phase::eDecode);
 		for (auto& bytes : out_createInfo.bytes) {
-			auto raw = imgToRaw(std::move(bytes), Texture::s_tName, idStr, dl::level::error);
+			auto raw = imgToRaw(bytes, Texture::s_tName, idStr, dl::level::error);
 			if (!raw) {
 				logE("[{}] [{}] Failed to create texture!", Texture::s_tName, idStr);
 				return false;
@@ -486,37 +548,37 @@ bool Texture::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 		}
 		bStbiRaw = true;
 	} else if (!out_createInfo.ids.empty()) {
-		for (auto const& resourceID : out_createInfo.ids) {
-			auto pixels = engine::reader().bytes(resourceID);
-			if (!pixels) {
-				logE("[{}] [{}] Failed to create texture from [{}]!", Texture::s_tName, idStr, resourceID.generic_string());
-				return false;
-			}
-			auto raw = imgToRaw(std::move(*pixels), Texture::s_tName, idStr, dl::level::error);
-			if (!raw) {
-				logE("[{}] [{}] Failed to create texture from [{}]!", Texture::s_tName, idStr, resourceID.generic_string());
-				return false;
-			}
-			raws.push_back(std::move(*raw));
+		sourceIDs = out_createInfo.ids;
+		if (!decodeSources()) {
+			return false;
 		}
-		bStbiRaw = true;
 		bAddFileMonitor = true;
 	} else {
 		ENSURE(false, "Invalid Info!");
 		logE("[{}] [{}] Invalid Texture Info!", Texture::s_tName, idStr);
 		return false;
 	}
-	out_info.size = raws.back().size;
-	spanRaws.clear();
-	for (auto const& raw : raws) {
-		spanRaws.push_back(raw.bytes);
+	if (!ktx2.empty()) {
+		auto trace = g_loadTrace.scope(Texture::s_tName, idStr, LoadTrace::Phase::eDecode);
+		if (!stageKTX2(out_info)) {
+			return false;
+		}
+	} else {
+		auto trace = g_loadTrace.scope(Texture::s_tName, idStr, LoadTrace::Phase::eProcess);
+		out_info.size = raws.back().size;
+		stageLevels(out_info.size);
+	}
+	{
+		auto trace = g_loadTrace.scope(Texture::s_tName, idStr, LoadTrace::Phase::eStage);
+		staged = Time::elapsed();
+		copied = load(active, colourSpace, out_info.size, mipLevels, spanRaws, idStr);
 	}
-	copied = load(active, colourSpace, out_info.size, spanRaws, idStr);
 	gfx::ImageViewInfo viewInfo;
 	viewInfo.image = active.image;
 	viewInfo.format = colourSpace;
 	viewInfo.aspectFlags = vk::ImageAspectFlagBits::eColor;
 	viewInfo.type = type;
+	viewInfo.mipLevels = mipLevels;
 	imageView = gfx::g_device.createImageView(viewInfo);
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
 	auto pReader = dynamic_cast<io::FileReader const*>(&engine::reader());
@@ -531,7 +593,11 @@ bool Texture::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 				texture.guid = guid;
 				if (auto pInfo = res::infoRW(texture)) {
 					auto const idStr = pInfo->id.generic_string();
-					auto raw = imgToRaw(file.monitor.bytes(), Texture::s_tName, idStr, dl::level::warning);
+					auto mapped = engine::reader().map(file.id);
+					if (!mapped) {
+						return false;
+					}
+					auto raw = imgToRaw(mapped->bytes(), Texture::s_tName, idStr, dl::level::warning);
 					if (raw) {
 						if (bStbiRaw) {
 							stbi_image_free((void*)(raws[idx].bytes.pData));
@@ -544,7 +610,7 @@ bool Texture::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 				return false;
 			};
 			++idx;
-			monitor.m_files.push_back({id, pReader->fullPath(id), io::FileMonitor::Mode::eBinaryContents, onModified});
+			monitor.m_files.push_back({id, pReader->fullPath(id), io::FileMonitor::Mode::eContentHash, onModified});
 		}
 	}
 #endif
@@ -565,6 +631,7 @@ bool Texture::Impl::update() {
 			auto const idStr = id.generic_string();
 			auto const szLoadStr = status == Status::eReloading ? "reloaded" : "loaded";
 			logI("[{}] [{}] {}", Texture::s_tName, idStr, szLoadStr);
+			g_loadTrace.record(Texture::s_tName, idStr, LoadTrace::Phase::eTransfer, staged);
 #if defined(LEVK_RESOURCES_HOT_RELOAD)
 			if (status == Status::eReloading) {
 				gfx::deferred::release(active, imageView);
@@ -575,6 +642,7 @@ bool Texture::Impl::update() {
 				viewInfo.image = active.image;
 				viewInfo.format = colourSpace;
 				viewInfo.type = type;
+				viewInfo.mipLevels = mipLevels;
 				imageView = gfx::g_device.createImageView(viewInfo);
 			}
 #endif
@@ -598,11 +666,9 @@ bool Texture::Impl::checkReload() {
 			Texture texture;
 			texture.guid = guid;
 			auto const& info = texture.info();
-			spanRaws.clear();
-			for (auto const& raw : raws) {
-				spanRaws.push_back(raw.bytes);
-			}
-			copied = load(standby, colourSpace, info.size, spanRaws, idStr);
+			stageLevels(info.size);
+			staged = Time::elapsed();
+			copied = load(standby, colourSpace, info.size, mipLevels, spanRaws, idStr);
 			return true;
 		}
 		return false;
@@ -631,6 +697,152 @@ void Texture::Impl::release() {
 	imageView = vk::ImageView();
 }
 
+Footprint Texture::Impl::footprint() const {
+	Footprint ret;
+	for (auto const& raw : raws) {
+		ret.cpu += (u64)raw.bytes.extent;
+	}
+	for (auto const& chain : mipChains) {
+		ret.cpu += (u64)chain.bytes.size();
+	}
+	ret.cpu += (u64)ktx2.size();
+	ret.vram = (u64)active.allocatedSize;
+	return ret;
+}
+
+bool Texture::Impl::evictVRAM() {
+	if (status != Status::eReady || active.image == vk::Image()) {
+		return false;
+	}
+	// restore() re-uploads from raws / KTX2 data, or re-decodes raws if evicted too:
+	// only possible if the engine owns that data (caller supplied raws may be freed after make())
+	if (!bStbiRaw && sourceIDs.empty() && ktx2.empty()) {
+		return false;
+	}
+	gfx::deferred::release(active, imageView);
+	active = {};
+	imageView = vk::ImageView();
+	return true;
+}
+
+bool Texture::Impl::evictCPU() {
+	// only images decoded from reader IDs can be decoded again
+	if (sourceIDs.empty() || raws.empty() || !bStbiRaw) {
+		return false;
+	}
+#if defined(LEVK_RESOURCES_HOT_RELOAD)
+	// file monitors patch raws in place
+	if (!imgIDs.empty()) {
+		return false;
+	}
+#endif
+	for (auto& raw : raws) {
+		stbi_image_free((void*)(raw.bytes.pData));
+	}
+	raws.clear();
+	mipChains.clear();
+	spanRaws.clear();
+	return true;
+}
+
+bool Texture::Impl::restore(Info& out_info) {
+	auto const idStr = id.generic_string();
+	if (!ktx2.empty()) {
+		if (!stageKTX2(out_info)) {
+			return false;
+		}
+	} else {
+		if (raws.empty() && !decodeSources()) {
+			return false;
+		}
+		out_info.size = raws.back().size;
+		stageLevels(out_info.size);
+	}
+	staged = Time::elapsed();
+	copied = load(active, colourSpace, out_info.size, mipLevels, spanRaws, idStr);
+	gfx::ImageViewInfo viewInfo;
+	viewInfo.image = active.image;
+	viewInfo.format = colourSpace;
+	viewInfo.aspectFlags = vk::ImageAspectFlagBits::eColor;
+	viewInfo.type = type;
+	viewInfo.mipLevels = mipLevels;
+	imageView = gfx::g_device.createImageView(viewInfo);
+	return true;
+}
+
+bool Texture::Impl::decodeSources() {
+	auto const idStr = id.generic_string();
+	std::vector<Texture::Raw> decoded;
+	for (auto const& resourceID : sourceIDs) {
+		Result<Texture::Raw> raw;
+		auto read = g_loadTrace.scope(Texture::s_tName, idStr, LoadTrace::Phase::eRead);
+		if (auto pixels = engine::reader().map(resourceID)) {
+			read = {};
+			auto trace = g_loadTrace.scope(Texture::s_tName, idStr, LoadTrace::Phase::eDecode);
+			raw = imgToRaw(pixels->bytes(), Texture::s_tName, idStr, dl::level::error);
+		}
+		if (!raw) {
+			logE("[{}] [{}] Failed to create texture from [{}]!", Texture::s_tName, idStr, resourceID.generic_string());
+			for (auto& r : decoded) {
+				stbi_image_free((void*)(r.bytes.pData));
+			}
+			return false;
+		}
+		decoded.push_back(std::move(*raw));
+	}
+	for (auto& raw : decoded) {
+		raws.push_back(std::move(raw));
+	}
+	bStbiRaw = true;
+	return true;
+}
+
+void Texture::Impl::stageLevels(glm::ivec2 size) {
+	mipLevels = bMipMaps ? mips::levelCount((u32)size.x, (u32)size.y) : 1;
+	auto const encoding = colourSpace == vk::Format::eR8G8B8A8Srgb ? mips::Encoding::eSRGB : mips::Encoding::eSNorm;
+	mipChains.clear();
+	spanRaws.clear();
+	for (auto const& raw : raws) {
+		spanRaws.push_back(raw.bytes);
+		if (mipLevels > 1) {
+			mipChains.push_back(mips::generate(raw.bytes, (u32)size.x, (u32)size.y, encoding, mipLevels));
+			for (std::size_t level = 0; level < mipChains.back().levels.size(); ++level) {
+				spanRaws.push_back(mipChains.back().level(level));
+			}
+		}
+	}
+}
+
+bool Texture::Impl::stageKTX2(Info& out_info) {
+	auto const idStr = id.generic_string();
+	auto const image = io::ktx2::parse(ktx2);
+	if (!image) {
+		logE("[{}] [{}] Invalid KTX2 data!", Texture::s_tName, idStr);
+		return false;
+	}
+	u32 const faces = type == vk::ImageViewType::eCube ? 6 : 1;
+	if (image->layers != 1 || image->faces != faces) {
+		logE("[{}] [{}] Unsupported KTX2 layout: [{}] layers, [{}] faces (expected [{}])", Texture::s_tName, idStr, image->layers, image->faces, faces);
+		return false;
+	}
+	auto const format = static_cast<vk::Format>(image->format);
+	auto const features = gfx::g_device.physicalDevice.getFormatProperties(format).optimalTilingFeatures;
+	if (!(features & vk::FormatFeatureFlagBits::eSampledImage)) {
+		logE("[{}] [{}] KTX2 format [{}] not supported by device!", Texture::s_tName, idStr, (u32)image->format);
+		return false;
+	}
+	colourSpace = format;
+	mipLevels = (u32)image->levels.size();
+	spanRaws.clear();
+	for (u32 face = 0; face < faces; ++face) {
+		for (std::size_t level = 0; level < image->levels.size(); ++level) {
+			spanRaws.push_back(image->image(level, face));
+		}
+	}
+	out_info.size = {(s32)image->width, (s32)image->height};
+	return true;
+}
+
 bool Material::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 	out_info.albedo = out_createInfo.albedo;
 	out_info.shininess = out_createInfo.shininess;
@@ -650,6 +862,19 @@ bool Mesh::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 		out_info.material.material = *material;
 	}
 	out_info.type = out_createInfo.type;
+	out_info.vertexFormat = out_info.type == Type::eStatic ? out_createInfo.vertexFormat : gfx::VertexFormat::eFull;
+	auto trace = g_loadTrace.scope(Mesh::s_tName, id.generic_string(), LoadTrace::Phase::eProcess);
+	if (out_createInfo.bOptimise && out_info.type == Type::eStatic) {
+		auto& geometry = out_createInfo.geometry;
+		auto const vertexCount = geometry.vertices.size();
+		auto const stats = meshopt::optimise(geometry.vertices, geometry.indices);
+		deferred::logI("[{}] [{}] optimised: ACMR {:.3f} => {:.3f}, {} => {} vertices", Mesh::s_tName, id.generic_string(), stats.acmrBefore, stats.acmrAfter,
+					   vertexCount, geometry.vertices.size());
+	}
+	if (out_createInfo.lodCount > 1 && out_info.type == Type::eStatic) {
+		generateLods(out_info, out_createInfo.geometry, out_createInfo.lodCount);
+	}
+	trace = {};
 	updateGeometry(out_info, std::move(out_createInfo.geometry));
 	return true;
 }
@@ -667,6 +892,30 @@ void Mesh::Impl::release() {
 	ibo = {};
 }
 
+Footprint Mesh::Impl::footprint() const {
+	Footprint ret;
+	ret.cpu = (u64)(geo.vertices.size() * sizeof(gfx::Vertex) + geo.indices.size() * sizeof(u32) + indices16.size() * sizeof(u16) +
+				  packed.size() * sizeof(quantise::PackedVertex));
+	ret.vram = (u64)(vbo.buffer.writeSize + ibo.buffer.writeSize);
+	return ret;
+}
+
+bool Mesh::Impl::evictVRAM() {
+	Mesh mesh;
+	mesh.guid = guid;
+	// dynamic meshes are host visible and written directly by clients; geo is the source for restore()
+	if (status != Status::eReady || res::info(mesh).type != Type::eStatic || geo.vertices.empty()) {
+		return false;
+	}
+	release();
+	return true;
+}
+
+bool Mesh::Impl::restore(Info& out_info) {
+	updateGeometry(out_info, std::move(geo));
+	return true;
+}
+
 bool Mesh::Impl::update() {
 	switch (status) {
 	default: {
@@ -677,6 +926,9 @@ bool Mesh::Impl::update() {
 		auto const vboState = utils::futureState(vbo.copied);
 		auto const iboState = utils::futureState(ibo.copied);
 		if (vboState == FutureState::eReady && (ibo.count == 0 || iboState == FutureState::eReady)) {
+			g_loadTrace.record(Mesh::s_tName, id.generic_string(), LoadTrace::Phase::eTransfer, staged);
+			indices16 = {};
+			packed = {};
 			return true;
 		}
 		return false;
@@ -691,9 +943,43 @@ void Mesh::Impl::updateGeometry(Info& out_info, gfx::Geometry geometry) {
 	}
 	geo = std::move(geometry);
 	auto const idStr = id.generic_string();
-	auto const vSize = (vk::DeviceSize)geo.vertices.size() * sizeof(gfx::Vertex);
-	auto const iSize = (vk::DeviceSize)geo.indices.size() * sizeof(u32);
 	auto const bHostVisible = out_info.type == Type::eDynamic;
+	// dynamic meshes are rewritten by clients every frame (text, UI): only trace their initial load
+	bool const bTrace = !bHostVisible || status != Status::eReady;
+	LoadTrace::Scope trace;
+	if (bTrace) {
+		trace = g_loadTrace.scope(Mesh::s_tName, idStr, bHostVisible ? LoadTrace::Phase::eStage : LoadTrace::Phase::eProcess);
+	}
+	// dynamic meshes are rewritten in place and may grow: keep them 32-bit
+	bool const b16 = !bHostVisible && geo.vertices.size() <= (std::size_t)maths::max<u16>();
+	indices16.clear();
+	if (b16) {
+		indices16.reserve(geo.indices.size());
+		for (u32 const idx : geo.indices) {
+			indices16.push_back((u16)idx);
+		}
+	}
+	glm::vec3 lo = geo.vertices.front().position, hi = lo;
+	for (auto const& vertex : geo.vertices) {
+		lo = glm::min(lo, vertex.position);
+		hi = glm::max(hi, vertex.position);
+	}
+	out_info.centre = (lo + hi) * 0.5f;
+	out_info.radius = glm::length(hi - lo) * 0.5f;
+	bool const bPacked = !bHostVisible && out_info.vertexFormat == gfx::VertexFormat::ePacked;
+	packed.clear();
+	if (bPacked) {
+		bounds = quantise::bounds(lo, hi);
+		packed.reserve(geo.vertices.size());
+		for (auto const& v : geo.vertices) {
+			packed.push_back(quantise::pack(v.position, v.colour, v.normal, v.texCoord, bounds));
+		}
+	}
+	if (!bHostVisible) {
+		trace = g_loadTrace.scope(Mesh::s_tName, idStr, LoadTrace::Phase::eStage);
+	}
+	auto const vSize = (vk::DeviceSize)geo.vertices.size() * (bPacked ? sizeof(quantise::PackedVertex) : sizeof(gfx::Vertex));
+	auto const iSize = (vk::DeviceSize)geo.indices.size() * (b16 ? sizeof(u16) : sizeof(u32));
 	if (vSize > vbo.buffer.writeSize) {
 		if (vbo.buffer.writeSize > 0) {
 			gfx::deferred::release(vbo.buffer);
@@ -720,9 +1006,12 @@ void Mesh::Impl::updateGeometry(Info& out_info, gfx::Geometry geometry) {
 	}
 	switch (out_info.type) {
 	case Type::eStatic: {
-		vbo.copied = gfx::vram::stage(vbo.buffer, geo.vertices.data(), vSize);
+		void const* pVertices = bPacked ? (void const*)packed.data() : (void const*)geo.vertices.data();
+		staged = Time::elapsed();
+		vbo.copied = gfx::vram::stage(vbo.buffer, pVertices, vSize);
 		if (!geo.indices.empty()) {
-			ibo.copied = gfx::vram::stage(ibo.buffer, geo.indices.data(), iSize);
+			void const* pIndices = b16 ? (void const*)indices16.data() : (void const*)geo.indices.data();
+			ibo.copied = gfx::vram::stage(ibo.buffer, pIndices, iSize);
 		}
 		status = Status::eLoading;
 		break;
@@ -740,7 +1029,31 @@ void Mesh::Impl::updateGeometry(Info& out_info, gfx::Geometry geometry) {
 	}
 	vbo.count = (u32)geo.vertices.size();
 	ibo.count = (u32)geo.indices.size();
-	out_info.triCount = iSize > 0 ? (u64)ibo.count / 3 : (u64)vbo.count / 3;
+	ibo.indexType = b16 ? vk::IndexType::eUint16 : vk::IndexType::eUint32;
+	out_info.triCount = iSize > 0 ? (u64)(lods.empty() ? ibo.count : lods.front().count) / 3 : (u64)vbo.count / 3;
+}
+
+void Mesh::Impl::generateLods(Info& out_info, gfx::Geometry& out_geometry, u8 lodCount) {
+	auto const vertexCount = (u32)out_geometry.vertices.size();
+	Span<std::byte> const vertices(reinterpret_cast<std::byte const*>(out_geometry.vertices.data()), vertexCount * sizeof(gfx::Vertex));
+	auto levels = meshopt::lods(out_geometry.indices, vertices, (u32)sizeof(gfx::Vertex), lodCount);
+	if (levels.size() < 2) {
+		return;
+	}
+	// all levels share the vertex buffer: append their (cache optimised) indices after full detail
+	lods.clear();
+	out_info.lodErrors.clear();
+	out_geometry.indices.clear();
+	for (auto& level : levels) {
+		if (!lods.empty()) {
+			level.indices = meshopt::optimiseVertexCache(level.indices, vertexCount);
+		}
+		lods.push_back({(u32)out_geometry.indices.size(), (u32)level.indices.size()});
+		out_info.lodErrors.push_back(level.error);
+		out_geometry.indices.insert(out_geometry.indices.end(), level.indices.begin(), level.indices.end());
+	}
+	deferred::logI("[{}] [{}] {} levels of detail: {} => {} triangles (error {:.4f})", Mesh::s_tName, id.generic_string(), lods.size(), lods.front().count / 3,
+				   lods.back().count / 3, levels.back().error);
 }
 
 bool Font::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
@@ -769,6 +1082,8 @@ bool Font::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 		out_createInfo.samplerID = "samplers/font";
 	}
 	sheetInfo.samplerID = out_createInfo.samplerID;
+	// glyphs are packed tightly: minified levels would bleed across neighbours
+	sheetInfo.bMipMaps = false;
 	sheetInfo.bytes = {std::move(out_createInfo.image)};
 	sheet = res::load(texID, std::move(sheetInfo));
 	if (sheet.status() == res::Status::eError) {
@@ -796,7 +1111,7 @@ bool Font::Impl::make(CreateInfo& out_createInfo, Info& out_info) {
 	auto pReader = dynamic_cast<io::FileReader const*>(&engine::reader());
 	monitor = {};
 	if (bAddMonitor && pReader) {
-		monitor.m_files.push_back({id, pReader->fullPath(out_info.jsonID), io::FileMonitor::Mode::eTextContents, [](auto) { return true; }});
+		monitor.m_files.push_back({id, pReader->fullPath(out_info.jsonID), io::FileMonitor::Mode::eContentHash, [](auto) { return true; }});
 	}
 #endif
 	return true;
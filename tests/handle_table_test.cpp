@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <core/handle_table.hpp>
+#include <core/std_types.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+struct Payload {
+	u64 handle = 0;
+	s32 value = 0;
+};
+
+using Table = THandleTable<Payload, 4, 64>;
+
+s32 main() {
+	Table table;
+	u32 serial = 0;
+	auto add = [&](s32 value) {
+		auto const handle = table.reserve(++serial);
+		table.publish(handle, std::make_unique<Payload>(Payload{handle, value}));
+		return handle;
+	};
+	// basic insert / lookup
+	std::vector<u64> handles;
+	for (s32 i = 0; i < 10; ++i) {
+		handles.push_back(add(i));
+	}
+	FAILIF(table.size() != 10);
+	for (s32 i = 0; i < 10; ++i) {
+		auto pPayload = table.find(handles[(std::size_t)i]);
+		FAILIF(!pPayload || pPayload->value != i);
+	}
+	FAILIF(table.find(0) || table.find(12345));
+	// reserved but unpublished slots are invisible
+	auto const reserved = table.reserve(++serial);
+	FAILIF(table.find(reserved));
+	table.unreserve(reserved);
+	// stale handles are rejected after slot reuse
+	FAILIF(!table.remove(handles[3], 0));
+	FAILIF(table.remove(handles[3], 0));
+	FAILIF(table.find(handles[3]));
+	auto const reused = add(100);
+	FAILIF(Table::index(reused) != Table::index(handles[3]) && Table::index(reused) != Table::index(reserved));
+	FAILIF(table.find(handles[3]) || !table.find(reused) || table.find(reused)->value != 100);
+	// retired objects survive until reclaimed past their epoch
+	FAILIF(table.retired() != 1 || table.reclaim(0) != 0 || table.reclaim(1) != 1);
+	// pinned reader epochs hold back reclamation until released
+	{
+		ReaderEpochs readers;
+		FAILIF(readers.oldest(5) != 5);
+		auto pin = readers.pin(2);
+		{
+			auto nested = readers.pin(4);
+			FAILIF(readers.pinned() != 2 || readers.oldest(5) != 2);
+		}
+		table.remove(add(200), 2);
+		FAILIF(table.reclaim(readers.oldest(5)) != 0 || table.retired() != 1);
+		auto moved = std::move(pin);
+		pin = {};
+		FAILIF(readers.oldest(5) != 2);
+		moved.reset();
+		FAILIF(readers.pinned() != 0 || table.reclaim(readers.oldest(5)) != 1);
+	}
+	// forEach visits published objects only
+	std::size_t count = 0;
+	table.forEach([&count](u64 handle, Payload& payload) { count += handle == payload.handle ? 1 : 0; });
+	FAILIF(count != table.size());
+	// concurrent readers vs a single writer: readers must never see mismatched payloads
+	{
+		constexpr std::size_t readerCount = 4;
+		std::atomic<bool> bStop = false;
+		std::atomic<bool> bMismatch = false;
+		std::atomic<u64> epoch = 1;
+		std::array<std::atomic<u64>, readerCount> seen = {};
+		std::vector<u64> live = handles;
+		std::vector<std::thread> readers;
+		for (std::size_t r = 0; r < readerCount; ++r) {
+			seen[r] = epoch.load();
+			readers.emplace_back([&, r]() {
+				while (!bStop.load()) {
+					// quiescent point: no pointers held from previous iterations
+					seen[r].store(epoch.load());
+					for (u64 handle = 1; handle < (20000ULL << 32); handle += (1ULL << 32) - 7) {
+						if (auto pPayload = table.find(handle); pPayload && pPayload->handle != handle) {
+							bMismatch.store(true);
+						}
+					}
+					for (auto handle : handles) {
+						if (auto pPayload = table.find(handle); pPayload && pPayload->handle != handle) {
+							bMismatch.store(true);
+						}
+					}
+				}
+			});
+		}
+		for (s32 i = 0; i < 20000; ++i) {
+			auto const idx = (std::size_t)i % live.size();
+			table.remove(live[idx], epoch.load());
+			live[idx] = add(i);
+			if (i % 100 == 0) {
+				u64 safe = ++epoch;
+				for (auto const& s : seen) {
+					safe = std::min(safe, s.load());
+				}
+				table.reclaim(safe);
+			}
+		}
+		bStop.store(true);
+		for (auto& reader : readers) {
+			reader.join();
+		}
+		FAILIF(bMismatch.load());
+	}
+	table.clear();
+	FAILIF(table.size() != 0 || table.retired() != 0);
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include <core/load_trace.hpp>
+#include <core/std_types.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+using Phase = LoadTrace::Phase;
+
+namespace {
+std::size_t count(std::string const& str, std::string_view sub) {
+	std::size_t ret = 0;
+	for (auto pos = str.find(sub); pos != std::string::npos; pos = str.find(sub, pos + sub.size())) {
+		++ret;
+	}
+	return ret;
+}
+
+LoadTrace::Event event(std::string type, std::string id, Phase phase, s64 beginUS, s64 endUS, u32 thread) {
+	return {std::move(type), std::move(id), Time(beginUS), Time(endUS), thread, phase};
+}
+} // namespace
+
+s32 main() {
+	LoadTrace trace;
+	// disabled by default: nothing is recorded
+	{
+		trace.record(event("Texture", "a", Phase::eRead, 0, 10, 1));
+		auto scope = trace.scope("Texture", "a", Phase::eDecode);
+	}
+	FAILIF(trace.enabled() || !trace.events().empty());
+	// synthetic events: aggregation by type and phase
+	trace.enable(true);
+	trace.record(event("Texture", "textures/a.png", Phase::eRead, 0, 100, 1));
+	trace.record(event("Texture", "textures/a.png", Phase::eDecode, 100, 400, 1));
+	trace.record(event("Texture", "textures/b.png", Phase::eDecode, 50, 150, 2));
+	trace.record(event("Mesh", "meshes/\"quoted\"\\path", Phase::eProcess, 10, 30, 2));
+	trace.record(event("Mesh", "meshes/x", Phase::eTransfer, 30, 1030, 3));
+	FAILIF(trace.events().size() != 5);
+	auto const rows = trace.table();
+	FAILIF(rows.size() != 4);
+	FAILIF(rows[0].type != "Mesh" || rows[0].phase != Phase::eProcess || rows[0].count != 1 || rows[0].total.to_us() != 20);
+	FAILIF(rows[1].type != "Mesh" || rows[1].phase != Phase::eTransfer || rows[1].max.to_us() != 1000);
+	FAILIF(rows[2].type != "Texture" || rows[2].phase != Phase::eRead || rows[2].total.to_us() != 100);
+	FAILIF(rows[3].type != "Texture" || rows[3].phase != Phase::eDecode || rows[3].count != 2 || rows[3].total.to_us() != 400 || rows[3].max.to_us() != 300);
+	auto const summary = trace.summary();
+	FAILIF(count(summary, "\n") != rows.size() + 1 || summary.find("transfer") == std::string::npos);
+	// Chrome trace: one complete event per record, strings escaped
+	auto const json = trace.chromeTrace();
+	FAILIF(count(json, "\"ph\":\"X\"") != 5);
+	FAILIF(json.find("\"ts\":100,\"dur\":300,\"pid\":1,\"tid\":1,\"args\":{\"phase\":\"decode\"}") == std::string::npos);
+	FAILIF(json.find("meshes/\\\"quoted\\\"\\\\path") == std::string::npos);
+	FAILIF(count(json, "{") != count(json, "}") || count(json, "[") != 1 || count(json, "]") != 1);
+	// scopes and concurrent records from several threads
+	trace.clear();
+	FAILIF(!trace.events().empty());
+	std::vector<std::thread> threads;
+	for (u32 t = 0; t < 4; ++t) {
+		threads.emplace_back([&trace, t]() {
+			for (u32 i = 0; i < 100; ++i) {
+				auto scope = trace.scope("Model", "models/" + std::to_string(t), (Phase)(i % (u32)Phase::eCOUNT_));
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	auto const events = trace.events();
+	FAILIF(events.size() != 400);
+	std::vector<u32> ids;
+	for (auto const& e : events) {
+		FAILIF(e.end < e.begin || e.thread == 0 || e.thread == LoadTrace::thisThread());
+		if (std::find(ids.begin(), ids.end(), e.thread) == ids.end()) {
+			ids.push_back(e.thread);
+		}
+	}
+	FAILIF(ids.size() != 4);
+	FAILIF(trace.table().size() != (std::size_t)Phase::eCOUNT_);
+	// switched off at runtime
+	trace.enable(false);
+	trace.record("Model", "models/late", Phase::eRead, Time());
+	FAILIF(trace.events().size() != 400);
+	// recording stops once capacity is reached
+	trace.clear();
+	trace.enable(true, 3);
+	for (s64 i = 0; i < 5; ++i) {
+		trace.record(event("Mesh", "meshes/dynamic", Phase::eStage, i, i + 1, 1));
+	}
+	FAILIF(trace.events().size() != 3 || trace.enabled() || !trace.full());
+	FAILIF(trace.summary().find("capacity reached") == std::string::npos);
+	trace.clear();
+	FAILIF(trace.full());
+	return 0;
+}
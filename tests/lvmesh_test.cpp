@@ -0,0 +1,98 @@
+#include <cstring>
+#include <vector>
+#include <core/lvmesh.hpp>
+#include <core/std_types.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+namespace {
+struct Vertex final {
+	glm::vec3 position;
+	glm::vec3 normal;
+	glm::vec2 texCoord;
+};
+
+std::vector<Vertex> grid(u32 side, f32 y) {
+	std::vector<Vertex> ret;
+	for (u32 row = 0; row < side; ++row) {
+		for (u32 col = 0; col < side; ++col) {
+			ret.push_back({{(f32)col, y, -(f32)row}, {0.0f, 1.0f, 0.0f}, {(f32)col / (f32)side, (f32)row / (f32)side}});
+		}
+	}
+	return ret;
+}
+
+Span<std::byte> bytes(std::vector<Vertex> const& vertices) {
+	return Span<std::byte>(reinterpret_cast<std::byte const*>(vertices.data()), vertices.size() * sizeof(Vertex));
+}
+
+bool equal(Span<std::byte> lhs, Span<std::byte> rhs) {
+	return lhs.extent == rhs.extent && std::memcmp(lhs.pData, rhs.pData, lhs.extent) == 0;
+}
+} // namespace
+
+s32 main() {
+	auto const v0 = grid(5, -2.0f);
+	auto const v1 = grid(3, 4.0f);
+	auto const i0 = test::gridIndices(4);
+	auto const i1 = test::gridIndices(2);
+	io::lvmesh::Model model;
+	model.vertexStride = sizeof(Vertex);
+	model.textures = {{"diffuse.png", "diffuse.png"}, {"specular.png", "specular.png"}};
+	io::lvmesh::Material material;
+	material.id = "metal";
+	material.diffuseIndices = {0};
+	material.specularIndices = {1};
+	material.diffuse = Colour(0xff8040ff);
+	material.shininess = 64.0f;
+	material.flags = 0b101;
+	model.materials = {material};
+	model.meshes.resize(2);
+	model.meshes[0].id = "floor";
+	model.meshes[0].materialIndices = {0};
+	model.meshes[0].vertices = bytes(v0);
+	model.meshes[0].indices = i0;
+	model.meshes[1].id = "roof";
+	model.meshes[1].vertices = bytes(v1);
+	model.meshes[1].indices = i1;
+	// round trip
+	auto const file = io::lvmesh::write(model);
+	FAILIF(file.empty() || !io::lvmesh::identify(file));
+	auto const parsed = io::lvmesh::parse(file);
+	FAILIF(!parsed || parsed->vertexStride != sizeof(Vertex) || parsed->meshes.size() != 2);
+	FAILIF(parsed->textures.size() != 2 || parsed->textures[1].filename != "specular.png");
+	FAILIF(parsed->materials.size() != 1 || parsed->materials[0].id != "metal" || parsed->materials[0].specularIndices != std::vector<u32>{1});
+	FAILIF(parsed->materials[0].diffuse.r != 0xff || parsed->materials[0].diffuse.g != 0x80 || parsed->materials[0].shininess != 64.0f);
+	FAILIF(parsed->materials[0].flags != 0b101);
+	for (std::size_t idx = 0; idx < 2; ++idx) {
+		auto const& mesh = parsed->meshes[idx];
+		auto const& source = model.meshes[idx];
+		FAILIF(mesh.id != source.id || mesh.materialIndices != source.materialIndices);
+		FAILIF(!equal(mesh.vertices, source.vertices) || parsed->vertexCount(mesh) != (idx == 0 ? v0.size() : v1.size()));
+		FAILIF(mesh.indices.extent != source.indices.extent || std::memcmp(mesh.indices.pData, source.indices.pData, mesh.indices.extent * sizeof(u32)) != 0);
+		// blobs are aligned for direct use
+		FAILIF((mesh.vertices.pData - file.data()) % io::lvmesh::alignment != 0);
+		FAILIF((reinterpret_cast<std::byte const*>(mesh.indices.pData) - file.data()) % io::lvmesh::alignment != 0);
+	}
+	// bounds
+	auto const& b0 = parsed->meshes[0].bounds;
+	FAILIF(b0.min != glm::vec3(0.0f, -2.0f, -4.0f) || b0.max != glm::vec3(4.0f, -2.0f, 0.0f));
+	FAILIF(parsed->bounds.min != glm::vec3(0.0f, -2.0f, -4.0f) || parsed->bounds.max != glm::vec3(4.0f, 4.0f, 0.0f));
+	// rejects: truncated, version mismatch, out of range index, misaligned source
+	FAILIF(io::lvmesh::parse(Span<std::byte>(file.data(), file.size() - 16)));
+	auto version = file;
+	version[sizeof(io::lvmesh::identifier)] = std::byte(io::lvmesh::version + 1);
+	FAILIF(io::lvmesh::parse(version));
+	auto badIndex = i1;
+	badIndex.back() = (u32)v1.size();
+	model.meshes[1].indices = badIndex;
+	FAILIF(io::lvmesh::parse(io::lvmesh::write(model)));
+	bytearray misaligned(file.size() + 4);
+	std::memcpy(misaligned.data() + 4, file.data(), file.size());
+	FAILIF(io::lvmesh::parse(Span<std::byte>(misaligned.data() + 4, file.size())));
+	// writes: stride mismatch
+	model.vertexStride = sizeof(Vertex) + 4;
+	FAILIF(!io::lvmesh::write(model).empty());
+	return 0;
+}
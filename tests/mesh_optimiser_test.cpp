@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+#include <core/mesh_optimiser.hpp>
+#include <core/std_types.hpp>
+#include <glm/glm.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+namespace {
+struct Vertex final {
+	glm::vec3 position;
+	u32 id = 0;
+};
+
+struct Grid final {
+	std::vector<Vertex> vertices;
+	std::vector<u32> indices;
+};
+
+// `side x side` quads facing +z at `z`, with an unreferenced vertex at the end
+Grid grid(u32 side, f32 z) {
+	Grid ret;
+	for (u32 row = 0; row <= side; ++row) {
+		for (u32 col = 0; col <= side; ++col) {
+			ret.vertices.push_back({{(f32)col, (f32)row, z}, (u32)ret.vertices.size()});
+		}
+	}
+	ret.indices = test::gridIndices(side);
+	ret.vertices.push_back({{-1.0f, -1.0f, z}, (u32)ret.vertices.size()});
+	return ret;
+}
+
+void shuffleTriangles(std::vector<u32>& out_indices, u32 seed) {
+	std::vector<std::array<u32, 3>> tris;
+	for (std::size_t idx = 0; idx < out_indices.size(); idx += 3) {
+		tris.push_back({out_indices[idx], out_indices[idx + 1], out_indices[idx + 2]});
+	}
+	std::shuffle(tris.begin(), tris.end(), std::mt19937(seed));
+	out_indices.clear();
+	for (auto const& tri : tris) {
+		out_indices.insert(out_indices.end(), tri.begin(), tri.end());
+	}
+}
+
+// triangles as (sorted) vertex IDs, independent of vertex / triangle order
+std::vector<std::array<u32, 3>> triangles(std::vector<Vertex> const& vertices, std::vector<u32> const& indices) {
+	std::vector<std::array<u32, 3>> ret;
+	for (std::size_t idx = 0; idx < indices.size(); idx += 3) {
+		ret.push_back({vertices[indices[idx]].id, vertices[indices[idx + 1]].id, vertices[indices[idx + 2]].id});
+	}
+	std::sort(ret.begin(), ret.end());
+	return ret;
+}
+} // namespace
+
+s32 main() {
+	// ACMR known answers
+	{
+		std::vector<u32> const single = {0, 1, 2};
+		std::vector<u32> const quad = {0, 1, 2, 0, 2, 3};
+		FAILIF(meshopt::acmr(single, 3) != 3.0f || meshopt::acmr(quad, 4) != 2.0f);
+		// a cache of 3 evicts vertex 0 before it is reused
+		std::vector<u32> const strip = {0, 1, 2, 3, 4, 5, 0, 1, 2};
+		FAILIF(meshopt::acmr(strip, 6, 3) != 3.0f || meshopt::acmr(strip, 6, 6) != 2.0f);
+	}
+	// vertex cache: shuffled grid improves, triangles are preserved
+	{
+		auto mesh = grid(32, 0.0f);
+		shuffleTriangles(mesh.indices, 3);
+		u32 const vertexCount = (u32)mesh.vertices.size();
+		f32 const before = meshopt::acmr(mesh.indices, vertexCount);
+		std::vector<u32> clusters;
+		auto const optimised = meshopt::optimiseVertexCache(mesh.indices, vertexCount, meshopt::defaultCacheSize, &clusters);
+		f32 const after = meshopt::acmr(optimised, vertexCount);
+		FAILIF(before < 2.0f || after > 0.9f);
+		FAILIF(triangles(mesh.vertices, optimised) != triangles(mesh.vertices, mesh.indices));
+		FAILIF(clusters.empty() || clusters.front() != 0 || !std::is_sorted(clusters.begin(), clusters.end()));
+		// invalid input is returned unchanged
+		std::vector<u32> bad = {0, 1, vertexCount};
+		FAILIF(meshopt::optimiseVertexCache(bad, vertexCount) != bad);
+	}
+	// overdraw: the outer of two parallel layers (facing away from the centre) is drawn first
+	{
+		auto inner = grid(2, 0.0f);
+		auto outer = grid(2, 5.0f);
+		std::vector<Vertex> vertices = inner.vertices;
+		std::vector<u32> indices = inner.indices;
+		u32 const offset = (u32)vertices.size();
+		vertices.insert(vertices.end(), outer.vertices.begin(), outer.vertices.end());
+		for (u32 const idx : outer.indices) {
+			indices.push_back(idx + offset);
+		}
+		Span<std::byte> const bytes(reinterpret_cast<std::byte const*>(vertices.data()), vertices.size() * sizeof(Vertex));
+		std::vector<u32> const clusters = {0, (u32)inner.indices.size() / 3};
+		auto const sorted = meshopt::optimiseOverdraw(indices, bytes, sizeof(Vertex), clusters, 10.0f);
+		FAILIF(sorted.size() != indices.size() || sorted.front() < offset || sorted.back() >= offset);
+		// rejected when the ACMR threshold cannot be met
+		std::vector<u32> const interleaved = {0, 1, 2, 3, 4, 5};
+		FAILIF(meshopt::optimiseOverdraw(indices, bytes, sizeof(Vertex), interleaved, 0.5f) != indices);
+	}
+	// full stage: fetch order, dropped vertices, ACMR reporting
+	{
+		auto mesh = grid(24, 0.0f);
+		shuffleTriangles(mesh.indices, 11);
+		auto const source = triangles(mesh.vertices, mesh.indices);
+		auto vertices = mesh.vertices;
+		auto indices = mesh.indices;
+		auto const stats = meshopt::optimise(vertices, indices);
+		FAILIF(stats.acmrAfter >= stats.acmrBefore || stats.acmrAfter > 0.9f);
+		FAILIF(stats.vertexCount != mesh.vertices.size() - 1 || vertices.size() != stats.vertexCount);
+		FAILIF(triangles(vertices, indices) != source);
+		// vertices are in order of first use
+		u32 next = 0;
+		for (u32 const idx : indices) {
+			FAILIF(idx > next);
+			next = std::max(next, idx + 1);
+		}
+		FAILIF(next != stats.vertexCount);
+	}
+	return 0;
+}
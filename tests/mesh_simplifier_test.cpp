@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <core/mesh_simplifier.hpp>
+#include <core/std_types.hpp>
+#include <glm/glm.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+namespace {
+struct Vertex final {
+	glm::vec3 position;
+	glm::vec2 texCoord;
+};
+
+struct Mesh final {
+	std::vector<Vertex> vertices;
+	std::vector<u32> indices;
+
+	Span<std::byte> bytes() const {
+		return Span<std::byte>(reinterpret_cast<std::byte const*>(vertices.data()), vertices.size() * sizeof(Vertex));
+	}
+
+	glm::vec3 normal(std::vector<u32> const& tris, std::size_t tri) const {
+		auto const& p0 = vertices[tris[tri]].position;
+		return glm::cross(vertices[tris[tri + 1]].position - p0, vertices[tris[tri + 2]].position - p0);
+	}
+};
+
+constexpr f32 pi = 3.14159265f;
+
+// `side x side` quads on z = 0, facing +z
+Mesh grid(u32 side) {
+	Mesh ret;
+	for (u32 row = 0; row <= side; ++row) {
+		for (u32 col = 0; col <= side; ++col) {
+			ret.vertices.push_back({{(f32)col, (f32)row, 0.0f}, {(f32)col / (f32)side, (f32)row / (f32)side}});
+		}
+	}
+	ret.indices = test::gridIndices(side);
+	return ret;
+}
+
+// unit UV sphere facing outwards: the texture seam and poles duplicate positions
+Mesh sphere(u32 rings, u32 segments) {
+	Mesh ret;
+	for (u32 ring = 0; ring <= rings; ++ring) {
+		f32 const theta = pi * (f32)ring / (f32)rings;
+		for (u32 seg = 0; seg <= segments; ++seg) {
+			f32 const phi = 2.0f * pi * (f32)(seg % segments) / (f32)segments;
+			glm::vec3 const p = {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+			ret.vertices.push_back({ring == 0 || ring == rings ? glm::vec3(0.0f, p.y, 0.0f) : p, {(f32)seg / (f32)segments, (f32)ring / (f32)rings}});
+		}
+	}
+	for (u32 ring = 0; ring < rings; ++ring) {
+		for (u32 seg = 0; seg < segments; ++seg) {
+			u32 const i0 = ring * (segments + 1) + seg;
+			u32 const i2 = i0 + segments + 1;
+			ret.indices.insert(ret.indices.end(), {i0, i0 + 1, i2 + 1, i0, i2 + 1, i2});
+		}
+	}
+	return ret;
+}
+
+f32 area(Mesh const& mesh, std::vector<u32> const& tris) {
+	f32 ret = 0.0f;
+	for (std::size_t tri = 0; tri < tris.size(); tri += 3) {
+		auto const n = mesh.normal(tris, tri);
+		ret += std::sqrt(glm::dot(n, n)) * 0.5f;
+	}
+	return ret;
+}
+
+f32 volume(Mesh const& mesh, std::vector<u32> const& tris) {
+	f32 ret = 0.0f;
+	for (std::size_t tri = 0; tri < tris.size(); tri += 3) {
+		auto const& v = mesh.vertices;
+		ret += glm::dot(v[tris[tri]].position, glm::cross(v[tris[tri + 1]].position, v[tris[tri + 2]].position)) / 6.0f;
+	}
+	return ret;
+}
+
+bool valid(Mesh const& mesh, std::vector<u32> const& tris) {
+	return tris.size() % 3 == 0 && std::all_of(tris.begin(), tris.end(), [&mesh](u32 idx) { return idx < mesh.vertices.size(); });
+}
+} // namespace
+
+s32 main() {
+	// flat grid: interior and straight borders collapse without error, corners and coverage are preserved
+	{
+		auto const mesh = grid(16);
+		f32 error = -1.0f;
+		auto const simple = meshopt::simplify(mesh.indices, mesh.bytes(), sizeof(Vertex), 6, 0.01f, &error);
+		FAILIF(!valid(mesh, simple) || simple.size() * 8 > mesh.indices.size() || error < 0.0f || error > 1e-4f);
+		FAILIF(std::abs(area(mesh, simple) - 256.0f) > 1e-2f);
+		for (std::size_t tri = 0; tri < simple.size(); tri += 3) {
+			FAILIF(mesh.normal(simple, tri).z <= 0.0f);
+		}
+		// error budget of zero still allows exact collapses; target at or above the source returns it unchanged
+		FAILIF(meshopt::simplify(mesh.indices, mesh.bytes(), sizeof(Vertex), mesh.indices.size()) != mesh.indices);
+		// invalid input is returned unchanged
+		std::vector<u32> const bad = {0, 1, (u32)mesh.vertices.size()};
+		FAILIF(meshopt::simplify(bad, mesh.bytes(), sizeof(Vertex), 0) != bad);
+	}
+	// sphere: LOD chain shrinks, errors grow, seams stay closed, shape is kept
+	{
+		auto const mesh = sphere(32, 64);
+		auto const lods = meshopt::lods(mesh.indices, mesh.bytes(), sizeof(Vertex), 4, 0.5f, 0.1f);
+		FAILIF(lods.size() < 3 || lods.front().indices != mesh.indices || lods.front().error != 0.0f);
+		f32 const sourceVolume = volume(mesh, mesh.indices);
+		for (std::size_t level = 1; level < lods.size(); ++level) {
+			auto const& lod = lods[level];
+			FAILIF(!valid(mesh, lod.indices));
+			FAILIF((f32)lod.indices.size() > (f32)lods[level - 1].indices.size() * 0.75f);
+			FAILIF(lod.error < lods[level - 1].error || lod.error > 0.1f);
+			FAILIF(std::abs(volume(mesh, lod.indices) - sourceVolume) > sourceVolume * 0.15f);
+			for (std::size_t tri = 0; tri < lod.indices.size(); tri += 3) {
+				f32 lo = 1.0f, hi = 0.0f;
+				for (std::size_t corner = 0; corner < 3; ++corner) {
+					f32 const u = mesh.vertices[lod.indices[tri + corner]].texCoord.x;
+					lo = std::min(lo, u);
+					hi = std::max(hi, u);
+				}
+				// a triangle spanning the seam would interpolate across the whole texture
+				FAILIF(hi - lo > 0.5f);
+			}
+		}
+	}
+	// selection
+	{
+		f32 const size = meshopt::screenSize(1.0f, 10.0f, pi * 0.5f);
+		FAILIF(std::abs(size - 0.1f) > 1e-4f);
+		FAILIF(meshopt::screenSize(1.0f, 20.0f, pi * 0.5f) >= size);
+		std::vector<f32> const errors = {0.0f, 0.01f, 0.05f};
+		FAILIF(meshopt::selectLod(errors, size, 0.002f) != 1);
+		FAILIF(meshopt::selectLod(errors, size, 0.01f) != 2);
+		FAILIF(meshopt::selectLod(errors, size, 0.0f) != 0);
+		FAILIF(meshopt::selectLod(errors, meshopt::screenSize(1.0f, 0.5f, pi * 0.5f), 0.002f) != 0);
+		FAILIF(meshopt::selectLod({}, size, 1.0f) != 0);
+	}
+	return 0;
+}
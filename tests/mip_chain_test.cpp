@@ -0,0 +1,85 @@
+#include <random>
+#include <vector>
+#include <core/mip_chain.hpp>
+#include <core/std_types.hpp>
+#include <core/tasks.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+namespace {
+std::vector<u8> image(u32 width, u32 height, std::vector<u8> const& texel) {
+	std::vector<u8> ret;
+	for (u32 idx = 0; idx < width * height; ++idx) {
+		ret.insert(ret.end(), texel.begin(), texel.end());
+	}
+	return ret;
+}
+} // namespace
+
+s32 main() {
+	// level counts
+	FAILIF(mips::levelCount(1, 1) != 1 || mips::levelCount(256, 256) != 9 || mips::levelCount(5, 3) != 3 || mips::levelCount(1024, 1) != 11);
+	// known answers: 2x2 -> 1x1
+	{
+		std::vector<u8> const src = {0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255};
+		u8 out[4] = {};
+		mips::downsample(src.data(), 2, 2, out, mips::Encoding::eUNorm);
+		FAILIF(out[0] != 128 || out[3] != 128);
+		// linear average of black and white re-encodes to 188, not 128; alpha stays linear
+		mips::downsample(src.data(), 2, 2, out, mips::Encoding::eSRGB);
+		FAILIF(out[0] != 188 || out[1] != 188 || out[2] != 188 || out[3] != 128);
+		// +127 and -127 average to 0 as signed values (0x80 if treated as unsigned)
+		std::vector<u8> const snorm = {0x7f, 0x7f, 0x7f, 0x7f, 0x81, 0x81, 0x81, 0x81, 0x7f, 0x7f, 0x7f, 0x7f, 0x81, 0x81, 0x81, 0x81};
+		mips::downsample(snorm.data(), 2, 2, out, mips::Encoding::eSNorm);
+		FAILIF(out[0] != 0 || out[3] != 0);
+	}
+	// odd dimensions repeat edge texels
+	{
+		std::vector<u8> const src = {10, 10, 10, 10, 20, 20, 20, 20, 90, 90, 90, 90};
+		u8 out[4] = {};
+		mips::downsample(src.data(), 3, 1, out, mips::Encoding::eUNorm);
+		FAILIF(out[0] != 15);
+	}
+	// uniform images are preserved at every level, down to 1x1
+	{
+		auto const src = image(40, 24, {30, 140, 220, 77});
+		auto const chain = mips::generate(src, 40, 24, mips::Encoding::eSRGB);
+		FAILIF(chain.levels.size() != 5 || chain.levels.back().width != 1 || chain.levels.back().height != 1);
+		for (u8 const byte : chain.level(3)) {
+			FAILIF(byte != 30 && byte != 140 && byte != 220 && byte != 77);
+		}
+		FAILIF(mips::generate(src, 40, 24, mips::Encoding::eUNorm, 2).levels.size() != 1);
+	}
+	// vectorised and parallel paths match a scalar reference
+	{
+		tasks::Service service(4);
+		u32 const width = 1030;
+		u32 const height = 520;
+		std::vector<u8> src((std::size_t)width * height * 4);
+		std::mt19937 engine(42);
+		std::uniform_int_distribution<u32> dist(0, 255);
+		for (auto& byte : src) {
+			byte = (u8)dist(engine);
+		}
+		for (auto const encoding : {mips::Encoding::eUNorm, mips::Encoding::eSNorm}) {
+			auto const chain = mips::generate(src, width, height, encoding);
+			FAILIF(chain.levels.size() != mips::levelCount(width, height) - 1);
+			FAILIF(chain.bytes != mips::generate(src, width, height, encoding, 0, false).bytes);
+			Span<u8> const level1 = chain.level(0);
+			u8 const bias = encoding == mips::Encoding::eSNorm ? 0x80 : 0;
+			for (u32 y = 0; y < height / 2; ++y) {
+				for (u32 x = 0; x < width / 2; ++x) {
+					for (u32 c = 0; c < 4; ++c) {
+						auto at = [&](u32 sx, u32 sy) -> u32 { return src[((std::size_t)sy * width + sx) * 4 + c] ^ bias; };
+						u32 const expect = ((at(x * 2, y * 2) + at(x * 2 + 1, y * 2) + at(x * 2, y * 2 + 1) + at(x * 2 + 1, y * 2 + 1) + 2) / 4) ^ bias;
+						FAILIF(level1[((std::size_t)y * (width / 2) + x) * 4 + c] != expect);
+					}
+				}
+			}
+		}
+		auto const srgb = mips::generate(src, width, height, mips::Encoding::eSRGB);
+		FAILIF(srgb.bytes != mips::generate(src, width, height, mips::Encoding::eSRGB, 0, false).bytes);
+	}
+	return 0;
+}
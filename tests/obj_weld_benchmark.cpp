@@ -0,0 +1,137 @@
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <core/log.hpp>
+#include <core/std_types.hpp>
+#include <core/tasks.hpp>
+#include <core/time.hpp>
+#include <core/vertex_weld.hpp>
+#include <tinyobjloader/tiny_obj_loader.h>
+
+using namespace le;
+
+// Usage: bench-obj-weld [file.obj] [shapes] [side]
+// Without a file, generates `shapes` tessellated grids of `side x side` quads (with shared positions / normals / texcoords)
+
+namespace {
+std::string generate(u32 shapes, u32 side) {
+	std::stringstream str;
+	u32 base = 1;
+	for (u32 shape = 0; shape < shapes; ++shape) {
+		str << "o shape_" << shape << '\n';
+		for (u32 row = 0; row <= side; ++row) {
+			for (u32 col = 0; col <= side; ++col) {
+				str << "v " << col << ' ' << shape << ' ' << row << '\n';
+				str << "vt " << (f32)col / (f32)side << ' ' << (f32)row / (f32)side << '\n';
+			}
+		}
+		str << "vn 0 1 0\n";
+		for (u32 row = 0; row < side; ++row) {
+			for (u32 col = 0; col < side; ++col) {
+				u32 const i0 = base + row * (side + 1) + col;
+				u32 const i1 = i0 + 1;
+				u32 const i2 = i0 + side + 1;
+				u32 const i3 = i2 + 1;
+				u32 const n = shape + 1;
+				str << "f " << i0 << '/' << i0 << '/' << n << ' ' << i1 << '/' << i1 << '/' << n << ' ' << i3 << '/' << i3 << '/' << n << '\n';
+				str << "f " << i0 << '/' << i0 << '/' << n << ' ' << i3 << '/' << i3 << '/' << n << ' ' << i2 << '/' << i2 << '/' << n << '\n';
+			}
+		}
+		base += (side + 1) * (side + 1);
+	}
+	return str.str();
+}
+
+std::vector<weld::Corner> corners(tinyobj::shape_t const& shape) {
+	std::vector<weld::Corner> ret;
+	ret.reserve(shape.mesh.indices.size());
+	for (auto const& idx : shape.mesh.indices) {
+		ret.push_back({idx.vertex_index, idx.normal_index, idx.texcoord_index});
+	}
+	return ret;
+}
+
+// Previous approach: XOR of attribute value hashes, trusted without an equality check
+std::size_t legacyWeld(tinyobj::attrib_t const& attrib, tinyobj::shape_t const& shape) {
+	std::unordered_map<std::size_t, u32> hashToVertIdx;
+	hashToVertIdx.reserve(shape.mesh.indices.size());
+	auto hash3 = [](f32 const* pData) {
+		return std::hash<f32>()(pData[0]) ^ (std::hash<f32>()(pData[1]) << 1) ^ (std::hash<f32>()(pData[2]) << 2);
+	};
+	f32 const zero[3] = {};
+	for (auto const& idx : shape.mesh.indices) {
+		auto const p = hash3(&attrib.vertices[3 * (std::size_t)idx.vertex_index]);
+		auto const n = idx.normal_index < 0 ? hash3(zero) : hash3(&attrib.normals[3 * (std::size_t)idx.normal_index]);
+		auto const t = idx.texcoord_index < 0 ? 0 : std::hash<f32>()(attrib.texcoords[2 * (std::size_t)idx.texcoord_index]);
+		auto const hash = p ^ (n << 1) ^ (t << 3);
+		hashToVertIdx.emplace(hash, (u32)hashToVertIdx.size());
+	}
+	return hashToVertIdx.size();
+}
+
+template <typename F>
+f32 measure(F&& func) {
+	auto const start = Time::elapsed();
+	func();
+	return (Time::elapsed() - start).to_s() * 1000.0f;
+}
+} // namespace
+
+s32 main(s32 argc, char const* const argv[]) {
+	tasks::Service service(tasks::Config{});
+	std::string obj;
+	if (argc > 1 && std::string_view(argv[1]).find(".obj") != std::string_view::npos) {
+		std::ifstream file(argv[1]);
+		std::stringstream str;
+		str << file.rdbuf();
+		obj = str.str();
+	} else {
+		u32 const shapes = argc > 1 ? (u32)std::stoul(argv[1]) : 16;
+		u32 const side = argc > 2 ? (u32)std::stoul(argv[2]) : 256;
+		obj = generate(shapes, side);
+	}
+	tinyobj::attrib_t attrib;
+	std::vector<tinyobj::shape_t> shapes;
+	std::vector<tinyobj::material_t> materials;
+	std::string warn, err;
+	std::stringstream objStr(obj);
+	bool bOK = false;
+	f32 const parse = measure([&]() { bOK = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, &objStr); });
+	if (!bOK || shapes.empty()) {
+		logE("[bench-obj-weld] Failed to parse OBJ: {}", err);
+		return 1;
+	}
+	std::size_t cornerCount = 0;
+	for (auto const& shape : shapes) {
+		cornerCount += shape.mesh.indices.size();
+	}
+	std::size_t legacyVerts = 0;
+	std::size_t exactVerts = 0;
+	f32 const legacy = measure([&]() {
+		for (auto const& shape : shapes) {
+			legacyVerts += legacyWeld(attrib, shape);
+		}
+	});
+	f32 const serial = measure([&]() {
+		for (auto const& shape : shapes) {
+			exactVerts += weld::weld(corners(shape)).vertices.size();
+		}
+	});
+	std::vector<weld::Result> results(shapes.size());
+	f32 const parallel = measure([&]() {
+		tasks::forBands((u32)shapes.size(), (u32)shapes.size(), [&](u32 begin, u32 end) {
+			for (u32 idx = begin; idx < end; ++idx) {
+				results[idx] = weld::weld(corners(shapes[idx]));
+			}
+		});
+	});
+	logI("[bench-obj-weld] {} shapes, {} corners, {} bytes of OBJ text ({} workers)", shapes.size(), cornerCount, obj.size(), tasks::workerCount());
+	logI("[bench-obj-weld] tinyobj parse         : {:.2f}ms", parse);
+	logI("[bench-obj-weld] legacy hash (serial)  : {:.2f}ms ({} vertices)", legacy, legacyVerts);
+	logI("[bench-obj-weld] exact weld (serial)   : {:.2f}ms ({} vertices)", serial, exactVerts);
+	logI("[bench-obj-weld] exact weld (parallel) : {:.2f}ms", parallel);
+	return 0;
+}
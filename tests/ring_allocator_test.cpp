@@ -0,0 +1,99 @@
+#include <deque>
+#include <random>
+#include <vector>
+#include <core/ring_allocator.hpp>
+#include <core/std_types.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+namespace {
+struct Live final {
+	u64 offset;
+	u64 size;
+	u64 consumed;
+};
+
+bool overlaps(Live const& lhs, Live const& rhs) {
+	return lhs.offset < rhs.offset + rhs.size && rhs.offset < lhs.offset + lhs.size;
+}
+} // namespace
+
+s32 main() {
+	// alignment, wrap-around, and exhaustion
+	{
+		RingAllocator ring(100, 16);
+		FAILIF(ring.capacity() != 96);
+		auto const a = ring.allocate(20);
+		FAILIF(!a || a->offset != 0 || a->consumed != 32);
+		auto const b = ring.allocate(40);
+		FAILIF(!b || b->offset != 32 || b->consumed != 48);
+		// 16 bytes left at the end, none at the front
+		FAILIF(ring.allocate(17));
+		FAILIF(ring.allocate(97));
+		ring.release(a->consumed);
+		// skips the 16 bytes at the end
+		auto const c = ring.allocate(32);
+		FAILIF(!c || c->offset != 0 || c->consumed != 48);
+		FAILIF(ring.used() != 96 || ring.allocate(1));
+		ring.release(b->consumed + c->consumed);
+		FAILIF(ring.used() != 0);
+		// empty: restarts at the front
+		auto const d = ring.allocate(96);
+		FAILIF(!d || d->offset != 0 || d->consumed != 96);
+		ring.reset();
+		FAILIF(ring.used() != 0 || !ring.allocate(0));
+	}
+	// batched FIFO release: live blocks never overlap and always fit
+	{
+		u64 const capacity = 1 << 16;
+		RingAllocator ring(capacity, 256);
+		std::mt19937 rng(7);
+		std::uniform_int_distribution<u64> size(1, capacity / 8);
+		std::uniform_int_distribution<u32> batchSize(1, 6);
+		std::deque<std::vector<Live>> batches;
+		u64 allocated = 0;
+		u64 misses = 0;
+		for (u32 frame = 0; frame < 2000; ++frame) {
+			std::vector<Live> batch;
+			for (u32 count = batchSize(rng); count > 0; --count) {
+				u64 const bytes = size(rng);
+				if (auto block = ring.allocate(bytes)) {
+					Live const live{block->offset, bytes, block->consumed};
+					FAILIF(live.offset % 256 != 0 || live.offset + bytes > ring.capacity());
+					for (auto const& other : batches) {
+						for (auto const& rhs : other) {
+							FAILIF(overlaps(live, rhs));
+						}
+					}
+					for (auto const& rhs : batch) {
+						FAILIF(overlaps(live, rhs));
+					}
+					batch.push_back(live);
+					++allocated;
+				} else {
+					FAILIF(ring.used() + bytes <= capacity / 2);
+					++misses;
+				}
+			}
+			batches.push_back(std::move(batch));
+			// retire the oldest batches (eg after their fences signal)
+			while (batches.size() > 3) {
+				u64 consumed = 0;
+				for (auto const& live : batches.front()) {
+					consumed += live.consumed;
+				}
+				ring.release(consumed);
+				batches.pop_front();
+			}
+		}
+		FAILIF(allocated == 0 || misses == 0);
+		for (auto const& batch : batches) {
+			for (auto const& live : batch) {
+				ring.release(live.consumed);
+			}
+		}
+		FAILIF(ring.used() != 0);
+	}
+	return 0;
+}
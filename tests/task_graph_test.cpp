@@ -0,0 +1,92 @@
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <core/std_types.hpp>
+#include <core/task_graph.hpp>
+#include <core/tasks.hpp>
+#include <core/threads.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+s32 main() {
+	tasks::Service service(4);
+	// ordering: a diamond whose join expands the graph from within a node
+	{
+		std::mutex mutex;
+		std::vector<char> order;
+		auto push = [&](char c) {
+			std::scoped_lock lock(mutex);
+			order.push_back(c);
+		};
+		tasks::Graph graph;
+		auto const a = graph.add([&]() { push('a'); }, "a");
+		auto const b = graph.add(
+			[&]() {
+				threads::sleep(5ms);
+				push('b');
+			},
+			"b", {a});
+		auto const c = graph.add([&]() { push('c'); }, "c", {a});
+		graph.add(
+			[&]() {
+				push('d');
+				graph.add([&]() { push('e'); }, "e", {*graph.current()});
+			},
+			"d", {b, c});
+		graph.wait();
+		FAILIF(!graph.done() || graph.current() || order.size() != 5);
+		FAILIF(order.front() != 'a' || order[3] != 'd' || order[4] != 'e');
+		auto const stats = graph.stats();
+		FAILIF(stats.nodes != 5 || stats.discarded != 0);
+		// critical path covers b's sleep, and cannot exceed total work
+		FAILIF(stats.criticalPath < Time(5ms) || stats.total < stats.criticalPath);
+	}
+	// parallelism: independent leaves run concurrently
+	{
+		std::atomic<s32> running = 0;
+		std::atomic<s32> peak = 0;
+		tasks::Graph graph;
+		std::vector<tasks::Graph::ID> leaves;
+		for (s32 idx = 0; idx < 4; ++idx) {
+			leaves.push_back(graph.add(
+				[&]() {
+					s32 const now = ++running;
+					s32 prev = peak.load();
+					while (prev < now && !peak.compare_exchange_weak(prev, now)) {
+					}
+					threads::sleep(20ms);
+					--running;
+				},
+				"leaf", {}));
+		}
+		std::atomic<bool> bJoined = false;
+		graph.add([&]() { bJoined = running.load() == 0; }, "join", leaves);
+		graph.wait();
+		FAILIF(peak.load() < 2 || !bJoined.load());
+	}
+	// discard: pending dependents never run
+	{
+		std::atomic<bool> bStarted = false;
+		std::atomic<bool> bRelease = false;
+		std::atomic<bool> bRan = false;
+		tasks::Graph graph;
+		auto const gate = graph.add(
+			[&]() {
+				bStarted = true;
+				while (!bRelease.load()) {
+					threads::sleep(1ms);
+				}
+			},
+			"gate");
+		graph.add([&]() { bRan = true; }, "after", {gate});
+		while (!bStarted.load()) {
+			threads::sleep(1ms);
+		}
+		graph.discard();
+		bRelease = true;
+		graph.wait();
+		FAILIF(bRan.load() || graph.stats().discarded != 1);
+	}
+	return 0;
+}
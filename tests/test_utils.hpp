@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+#include <core/std_types.hpp>
+
+///
+/// \brief Fail the test (return 1 from main) if `x` is true
+///
+#define FAILIF(x)                                                                                                                                              \
+	do {                                                                                                                                                       \
+		if (x) {                                                                                                                                               \
+			return 1;                                                                                                                                          \
+		}                                                                                                                                                      \
+	} while (0)
+
+namespace le::test {
+///
+/// \brief Obtain indices of `side x side` quads (two triangles each) over a row-major grid of `(side + 1) x (side + 1)` vertices
+///
+inline std::vector<u32> gridIndices(u32 side) {
+	std::vector<u32> ret;
+	ret.reserve((std::size_t)side * side * 6);
+	for (u32 row = 0; row < side; ++row) {
+		for (u32 col = 0; col < side; ++col) {
+			u32 const i0 = row * (side + 1) + col;
+			u32 const i2 = i0 + side + 1;
+			ret.insert(ret.end(), {i0, i0 + 1, i2 + 1, i0, i2 + 1, i2});
+		}
+	}
+	return ret;
+}
+} // namespace le::test
@@ -0,0 +1,191 @@
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <core/bc.hpp>
+#include <core/ktx2.hpp>
+#include <core/mip_chain.hpp>
+#include <core/std_types.hpp>
+#include <core/tasks.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+namespace {
+// smooth gradients with a hard edge and varying alpha
+std::vector<u8> testImage(u32 width, u32 height) {
+	std::vector<u8> ret;
+	for (u32 y = 0; y < height; ++y) {
+		for (u32 x = 0; x < width; ++x) {
+			ret.push_back((u8)(x * 255 / width));
+			ret.push_back((u8)(y * 255 / height));
+			ret.push_back(x < width / 2 ? 40 : 220);
+			ret.push_back((u8)((x + y) * 255 / (width + height)));
+		}
+	}
+	return ret;
+}
+
+f64 rmse(std::vector<u8> const& lhs, std::vector<u8> const& rhs, std::size_t channels) {
+	f64 sum = 0.0;
+	std::size_t count = 0;
+	for (std::size_t idx = 0; idx < lhs.size(); ++idx) {
+		if (idx % 4 < channels) {
+			f64 const diff = (f64)lhs[idx] - (f64)rhs[idx];
+			sum += diff * diff;
+			++count;
+		}
+	}
+	return std::sqrt(sum / (f64)count);
+}
+
+std::vector<u8> bytes(Span<u8> span) {
+	return std::vector<u8>(span.begin(), span.end());
+}
+} // namespace
+
+s32 main() {
+	// sizes
+	FAILIF(bc::imageSize(bc::Format::eBC1, 5, 4) != 16 || bc::imageSize(bc::Format::eBC7, 1, 1) != 16 || bc::imageSize(bc::Format::eBC3, 8, 9) != 96);
+	// known answers: hand assembled blocks
+	{
+		u8 out[64] = {};
+		// BC1: c0 = red, c1 = blue (four colour mode), indices [0, 1, 2, 3, 0...]
+		u8 const bc1[8] = {0x00, 0xf8, 0x1f, 0x00, 0b11100100, 0, 0, 0};
+		FAILIF(!bc::decodeBlock(bc::Format::eBC1, bc1, out));
+		FAILIF(out[0] != 255 || out[2] != 0 || out[4] != 0 || out[6] != 255 || out[8] != 170 || out[10] != 85 || out[12] != 85 || out[14] != 170);
+		FAILIF(out[3] != 255 || out[16] != 255);
+		// BC1: c0 <= c1 selects three colour mode: index 3 is transparent black
+		u8 const bc1a[8] = {0x1f, 0x00, 0x00, 0xf8, 0b11000000, 0, 0, 0};
+		FAILIF(!bc::decodeBlock(bc::Format::eBC1, bc1a, out) || out[12] != 0 || out[15] != 0 || out[0] != 0 || out[2] != 255);
+		// BC3 alpha: a0 = 255, a1 = 0 (eight value mode), indices [0, 1, 2, 7, 0...]
+		u8 const bc3[16] = {255, 0, 0b10001000, 0b00001110, 0, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 0, 0, 0, 0};
+		FAILIF(!bc::decodeBlock(bc::Format::eBC3, bc3, out));
+		FAILIF(out[3] != 255 || out[7] != 0 || out[11] != 219 || out[15] != 36 || out[0] != 255 || out[1] != 255 || out[2] != 255);
+		// BC5: R = 10 everywhere, G = 200 everywhere (a0 == a1)
+		u8 const bc5[16] = {10, 10, 0, 0, 0, 0, 0, 0, 200, 200, 0, 0, 0, 0, 0, 0};
+		FAILIF(!bc::decodeBlock(bc::Format::eBC5, bc5, out) || out[60] != 10 || out[61] != 200 || out[62] != 0 || out[63] != 255);
+		// BC7: mode 6, endpoints (0, 0, 0, 1) and (255, 255, 255, 255), index 15 on the last texel
+		u8 bc7[16] = {};
+		bc7[0] = 0x40;
+		std::vector<std::pair<u32, u32>> fields = {{0, 7}, {127, 7}, {0, 7}, {127, 7}, {0, 7}, {127, 7}, {0, 7}, {127, 7}, {1, 1}, {1, 1}};
+		u32 pos = 7;
+		for (auto [value, count] : fields) {
+			for (u32 bit = 0; bit < count; ++bit, ++pos) {
+				bc7[pos / 8] |= (u8)(((value >> bit) & 1) << (pos % 8));
+			}
+		}
+		bc7[15] = 0xf0;
+		FAILIF(!bc::decodeBlock(bc::Format::eBC7, bc7, out) || out[0] != 1 || out[3] != 1 || out[60] != 255 || out[63] != 255);
+		// other BC7 modes are not decoded
+		bc7[0] = 0x01;
+		FAILIF(bc::decodeBlock(bc::Format::eBC7, bc7, out));
+	}
+	// solid blocks survive (within endpoint quantisation)
+	{
+		std::vector<u8> solid;
+		for (s32 idx = 0; idx < 16; ++idx) {
+			solid.insert(solid.end(), {200, 100, 50, 255});
+		}
+		for (auto const format : {bc::Format::eBC1, bc::Format::eBC3, bc::Format::eBC7}) {
+			auto const encoded = bc::encode(format, solid, 4, 4);
+			auto const decoded = bc::decode(format, encoded, 4, 4);
+			FAILIF(decoded.size() != solid.size() || rmse(solid, decoded, 4) > (format == bc::Format::eBC7 ? 1.0 : 4.0));
+		}
+	}
+	// round trips: encode then decode on the CPU, within format error bounds (partial edge blocks included)
+	{
+		tasks::Service service(4);
+		u32 const width = 130;
+		u32 const height = 70;
+		auto const image = testImage(width, height);
+		// BC1 alpha is 1-bit: round trip opaque texels
+		auto opaque = image;
+		for (std::size_t idx = 3; idx < opaque.size(); idx += 4) {
+			opaque[idx] = 255;
+		}
+		struct Bound final {
+			bc::Format format;
+			std::size_t channels;
+			f64 rmse;
+		};
+		for (auto const bound : {Bound{bc::Format::eBC1, 3, 3.0}, Bound{bc::Format::eBC3, 4, 3.0}, Bound{bc::Format::eBC5, 2, 1.0}, Bound{bc::Format::eBC7, 4, 2.0}}) {
+			auto const& source = bound.format == bc::Format::eBC1 ? opaque : image;
+			auto const encoded = bc::encode(bound.format, source, width, height);
+			FAILIF(encoded.size() != bc::imageSize(bound.format, width, height));
+			FAILIF(encoded != bc::encode(bound.format, source, width, height, false));
+			auto const decoded = bc::decode(bound.format, encoded, width, height);
+			FAILIF(decoded.size() != source.size() || rmse(source, decoded, bound.channels) > bound.rmse);
+		}
+		// BC1 punch-through alpha
+		auto cutout = image;
+		for (std::size_t idx = 3; idx < cutout.size(); idx += 4) {
+			cutout[idx] = cutout[idx] < 100 ? 0 : 255;
+		}
+		auto const decoded = bc::decode(bc::Format::eBC1, bc::encode(bc::Format::eBC1, cutout, width, height), width, height);
+		for (std::size_t idx = 3; idx < cutout.size(); idx += 4) {
+			FAILIF(decoded[idx] != cutout[idx]);
+		}
+	}
+	// KTX2: write and parse a mipmapped BC7 image and a BC1 cubemap
+	{
+		u32 const width = 64;
+		u32 const height = 32;
+		auto const image = testImage(width, height);
+		auto const chain = mips::generate(image, width, height, mips::Encoding::eSRGB);
+		std::vector<std::vector<u8>> levels = {bc::encode(bc::Format::eBC7, image, width, height)};
+		for (std::size_t idx = 0; idx < chain.levels.size(); ++idx) {
+			levels.push_back(bc::encode(bc::Format::eBC7, chain.level(idx), chain.levels[idx].width, chain.levels[idx].height));
+		}
+		io::ktx2::Image out;
+		out.format = io::ktx2::vkFormat(bc::Format::eBC7, true);
+		out.width = width;
+		out.height = height;
+		for (auto const& level : levels) {
+			out.levels.push_back(level);
+		}
+		auto const file = io::ktx2::write(out);
+		FAILIF(!io::ktx2::identify(file));
+		auto const parsed = io::ktx2::parse(file);
+		FAILIF(!parsed || parsed->format != io::ktx2::VkFormat::eBC7Srgb || parsed->width != width || parsed->height != height);
+		FAILIF(parsed->levels.size() != 7 || parsed->layers != 1 || parsed->faces != 1);
+		for (std::size_t idx = 0; idx < levels.size(); ++idx) {
+			FAILIF(bytes(parsed->levels[idx]) != levels[idx] || (parsed->levels[idx].pData - reinterpret_cast<u8 const*>(file.data())) % 16 != 0);
+		}
+		auto const decoded = bc::decode(bc::Format::eBC7, parsed->image(0, 0), width, height);
+		FAILIF(rmse(image, decoded, 4) > 4.0);
+
+		std::vector<u8> faces;
+		for (u8 face = 0; face < 6; ++face) {
+			auto const block = bc::encode(bc::Format::eBC1, std::vector<u8>(16 * 4, (u8)(face * 40)), 4, 4);
+			faces.insert(faces.end(), block.begin(), block.end());
+		}
+		io::ktx2::Image cube;
+		cube.format = io::ktx2::VkFormat::eBC1RGBAUnorm;
+		cube.width = cube.height = 4;
+		cube.faces = 6;
+		cube.levels = {faces};
+		auto const cubeFile = io::ktx2::write(cube);
+		auto const parsedCube = io::ktx2::parse(cubeFile);
+		FAILIF(!parsedCube || parsedCube->faces != 6 || parsedCube->image(0, 5).extent != 8);
+		FAILIF(std::abs((s32)bc::decode(bc::Format::eBC1, parsedCube->image(0, 5), 4, 4)[0] - 200) > 4);
+
+		// rejects: truncated, supercompressed, mismatched level sizes, too many levels, oversized dimensions
+		FAILIF(io::ktx2::parse(Span<std::byte>(file.data(), 40)));
+		auto supercompressed = file;
+		supercompressed[12 + 32] = std::byte(2);
+		FAILIF(io::ktx2::parse(supercompressed));
+		auto resized = file;
+		resized[12 + 8] = std::byte(65);
+		FAILIF(io::ktx2::parse(resized));
+		auto extraLevel = file;
+		extraLevel[12 + 28] = std::byte(8);
+		FAILIF(io::ktx2::parse(extraLevel));
+		auto huge = file;
+		std::fill(huge.begin() + 12 + 8, huge.begin() + 12 + 16, std::byte(0xff));
+		FAILIF(io::ktx2::parse(huge));
+		out.levels.pop_back();
+		out.levels.push_back(levels[1]);
+		FAILIF(!io::ktx2::write(out).empty());
+	}
+	return 0;
+}
@@ -0,0 +1,47 @@
+#include <vector>
+#include <core/std_types.hpp>
+#include <core/timer_wheel.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+using Wheel = TTimerWheel<u64, 3, 4>;
+
+s32 main() {
+	// each payload is its own expected expiry tick; spans all levels and overflow
+	std::vector<u64> const delays = {0, 1, 2, 15, 16, 17, 100, 255, 256, 257, 1000, 4095, 4096, 5000, 20000};
+	Wheel wheel;
+	u64 expected = 0;
+	for (auto delay : delays) {
+		wheel.schedule(delay, delay == 0 ? 1 : delay);
+		++expected;
+	}
+	FAILIF(wheel.size() != expected);
+	u64 fired = 0;
+	bool bLate = false;
+	auto onExpired = [&](Wheel::Tick tick, u64&& payload) {
+		bLate |= tick != payload || wheel.now() != payload;
+		++fired;
+	};
+	// uneven steps
+	wheel.advance(3, onExpired);
+	wheel.advance(250, onExpired);
+	wheel.advance(19747, onExpired);
+	FAILIF(bLate || fired != expected || !wheel.empty());
+
+	// scheduling mid-flight and periodic rescheduling
+	u64 const period = 37;
+	u64 const start = wheel.now();
+	u64 repeats = 0;
+	wheel.schedule(period, start + period);
+	auto onPeriodic = [&](Wheel::Tick tick, u64&& payload) {
+		bLate |= tick != payload;
+		++repeats;
+		wheel.schedule(period, payload + period);
+	};
+	wheel.advance(period * 100, onPeriodic);
+	FAILIF(bLate || repeats != 100 || wheel.size() != 1);
+	wheel.clear();
+	FAILIF(!wheel.empty());
+	return 0;
+}
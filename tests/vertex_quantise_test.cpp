@@ -0,0 +1,72 @@
+#include <cmath>
+#include <limits>
+#include <core/std_types.hpp>
+#include <core/vertex_quantise.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+namespace {
+constexpr f32 pi = 3.14159265f;
+
+f32 distance(glm::vec3 const& lhs, glm::vec3 const& rhs) {
+	auto const d = lhs - rhs;
+	return std::sqrt(glm::dot(d, d));
+}
+} // namespace
+
+s32 main() {
+	// half floats
+	{
+		FAILIF(quantise::toHalf(0.0f) != 0x0000 || quantise::toHalf(-0.0f) != 0x8000);
+		FAILIF(quantise::toHalf(1.0f) != 0x3c00 || quantise::toHalf(-2.0f) != 0xc000 || quantise::toHalf(65504.0f) != 0x7bff);
+		FAILIF(quantise::toHalf(1e6f) != 0x7c00 || quantise::toHalf(-std::numeric_limits<f32>::infinity()) != 0xfc00);
+		FAILIF(!std::isnan(quantise::fromHalf(quantise::toHalf(std::numeric_limits<f32>::quiet_NaN()))));
+		// smallest subnormal, and round to nearest even between representable values
+		FAILIF(quantise::toHalf(std::ldexp(1.0f, -24)) != 0x0001 || quantise::fromHalf(0x0001) != std::ldexp(1.0f, -24));
+		FAILIF(quantise::toHalf(1.0f + std::ldexp(1.0f, -11)) != 0x3c00 || quantise::toHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) != 0x3c02);
+		for (u32 bits = 0; bits < 0x7c00; ++bits) {
+			FAILIF(quantise::toHalf(quantise::fromHalf((u16)bits)) != bits);
+		}
+		for (f32 uv = -4.0f; uv <= 4.0f; uv += 0.01f) {
+			FAILIF(std::abs(quantise::fromHalf(quantise::toHalf(uv)) - uv) > std::abs(uv) * 1e-3f + 1e-7f);
+		}
+	}
+	// normalised integers
+	{
+		FAILIF(quantise::toUnorm16(0.0f) != 0 || quantise::toUnorm16(1.0f) != 65535 || quantise::toUnorm16(2.0f) != 65535);
+		FAILIF(quantise::toSnorm16(-1.0f) != -32767 || quantise::toSnorm16(1.0f) != 32767 || quantise::fromSnorm16(-32768) != -1.0f);
+	}
+	// octahedral normals: every direction (including axes and the folded hemisphere) round trips
+	{
+		for (u32 lat = 0; lat <= 64; ++lat) {
+			for (u32 lon = 0; lon < 128; ++lon) {
+				f32 const theta = pi * (f32)lat / 64.0f;
+				f32 const phi = 2.0f * pi * (f32)lon / 128.0f;
+				glm::vec3 const n = {std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)};
+				auto const oct = quantise::octEncode(n);
+				FAILIF(std::abs(oct.x) > 1.0f || std::abs(oct.y) > 1.0f);
+				FAILIF(distance(quantise::octDecode(oct), n) > 1e-5f);
+				glm::vec2 const snorm = {quantise::fromSnorm16(quantise::toSnorm16(oct.x)), quantise::fromSnorm16(quantise::toSnorm16(oct.y))};
+				FAILIF(distance(quantise::octDecode(snorm), n) > 1e-4f);
+			}
+		}
+	}
+	// packed vertices: positions within bounds precision, white colour exact
+	{
+		auto const bounds = quantise::bounds({-10.0f, 0.0f, 5.0f}, {10.0f, 0.0f, 25.0f});
+		FAILIF(bounds.scale.y != 1.0f);
+		glm::vec3 const position = {3.14159f, 0.0f, 7.5f};
+		glm::vec3 const normal = glm::vec3(0.0f, -1.0f, 1.0f) * (1.0f / std::sqrt(2.0f));
+		auto const packed = quantise::pack(position, glm::vec3(1.0f), normal, {0.25f, 0.75f}, bounds);
+		auto const unpacked = quantise::unpack(packed, bounds);
+		FAILIF(distance(unpacked.position, position) > 20.0f / 65535.0f);
+		FAILIF(unpacked.colour.x != 1.0f || unpacked.colour.y != 1.0f || unpacked.colour.z != 1.0f || unpacked.colour.w != 1.0f);
+		FAILIF(distance(unpacked.normal, normal) > 1e-4f);
+		FAILIF(unpacked.texCoord.x != 0.25f || unpacked.texCoord.y != 0.75f);
+		// positions outside bounds clamp
+		auto const clamped = quantise::unpack(quantise::pack({100.0f, 0.0f, 0.0f}, {}, normal, {}, bounds), bounds);
+		FAILIF(clamped.position.x != 10.0f || clamped.position.z != 5.0f);
+	}
+	return 0;
+}
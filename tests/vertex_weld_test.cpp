@@ -0,0 +1,101 @@
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+#include <core/std_types.hpp>
+#include <core/tasks.hpp>
+#include <core/vertex_weld.hpp>
+#include "test_utils.hpp"
+
+using namespace le;
+
+namespace {
+std::vector<weld::Corner> randomCorners(std::size_t count, s32 range, u32 seed) {
+	std::mt19937 engine(seed);
+	std::uniform_int_distribution<s32> dist(-1, range);
+	std::vector<weld::Corner> ret(count);
+	for (auto& corner : ret) {
+		corner = {dist(engine), dist(engine), dist(engine)};
+	}
+	return ret;
+}
+
+bool matchesReference(std::vector<weld::Corner> const& corners, weld::Result const& result) {
+	std::map<std::tuple<s32, s32, s32>, u32> reference;
+	if (result.indices.size() != corners.size()) {
+		return false;
+	}
+	for (std::size_t idx = 0; idx < corners.size(); ++idx) {
+		auto const& c = corners[idx];
+		auto const [it, bNew] = reference.emplace(std::make_tuple(c.position, c.normal, c.texCoord), (u32)reference.size());
+		if (result.indices[idx] != it->second || result.vertices[result.indices[idx]] != c) {
+			return false;
+		}
+	}
+	return reference.size() == result.vertices.size();
+}
+} // namespace
+
+s32 main() {
+	// first occurrence order
+	{
+		weld::Corner const a{0, 0, 0}, b{1, 0, 0}, c{0, 1, 0};
+		std::vector<weld::Corner> const corners = {a, b, a, c, b, c};
+		auto const result = weld::weld(corners);
+		FAILIF(result.indices != std::vector<u32>({0, 1, 0, 2, 1, 2}));
+		FAILIF(result.vertices.size() != 3 || result.vertices[0] != a || result.vertices[1] != b || result.vertices[2] != c);
+	}
+	// corners differing in a single attribute (or permuted) are never merged
+	{
+		std::vector<weld::Corner> const corners = {{1, 2, 3}, {1, 3, 2}, {2, 1, 3}, {3, 2, 1}, {1, 2, -1}, {1, -1, 3}, {-1, 2, 3}, {1, 2, 3}};
+		auto const result = weld::weld(corners);
+		FAILIF(result.vertices.size() != 7 || result.indices.back() != 0);
+	}
+	// table growth from zero capacity
+	{
+		weld::Table table;
+		for (s32 idx = 0; idx < 1000; ++idx) {
+			auto const [vertex, bInserted] = table.insert({idx, idx / 2, -1});
+			FAILIF(!bInserted || vertex != (u32)idx);
+		}
+		for (s32 idx = 0; idx < 1000; ++idx) {
+			auto const [vertex, bInserted] = table.insert({idx, idx / 2, -1});
+			FAILIF(bInserted || vertex != (u32)idx);
+		}
+		FAILIF(table.size() != 1000 || table.keys()[999].normal != 499);
+	}
+	// random corners against an ordered map
+	{
+		auto const corners = randomCorners(100000, 40, 7);
+		FAILIF(!matchesReference(corners, weld::weld(corners)));
+	}
+	// shapes welded in parallel bands match serial welding
+	{
+		tasks::Service service(4);
+		std::vector<std::vector<weld::Corner>> shapes;
+		for (u32 idx = 0; idx < 13; ++idx) {
+			shapes.push_back(randomCorners(1000 + idx * 997, 12 + (s32)idx, idx));
+		}
+		std::vector<weld::Result> results(shapes.size());
+		tasks::forBands((u32)shapes.size(), (u32)shapes.size(), [&](u32 begin, u32 end) {
+			for (u32 idx = begin; idx < end; ++idx) {
+				results[idx] = weld::weld(shapes[idx]);
+			}
+		});
+		for (std::size_t idx = 0; idx < shapes.size(); ++idx) {
+			FAILIF(!matchesReference(shapes[idx], results[idx]));
+		}
+		// empty ranges and excess bands
+		u32 calls = 0;
+		tasks::forBands(0, 4, [&calls](u32, u32) { ++calls; });
+		FAILIF(calls != 0);
+		std::vector<u32> hits(3, 0);
+		tasks::forBands(3, 64, [&hits](u32 begin, u32 end) {
+			for (u32 idx = begin; idx < end; ++idx) {
+				++hits[idx];
+			}
+		});
+		FAILIF(hits != std::vector<u32>(3, 1));
+	}
+	return 0;
+}
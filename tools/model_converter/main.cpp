@@ -0,0 +1,131 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <core/log.hpp>
+#include <core/lvmesh.hpp>
+#include <core/reader.hpp>
+#include <core/utils.hpp>
+#include <engine/resources/resource_types.hpp>
+
+using namespace le;
+
+namespace {
+constexpr std::string_view g_tName = "levk-model-converter";
+constexpr std::string_view g_usage = "Usage: levk-model-converter <data_dir>... -m <manifest>...";
+
+struct Args final {
+	std::vector<stdfs::path> dirs;
+	std::vector<stdfs::path> manifests;
+};
+
+bool parse(s32 argc, char const* const argv[], Args& out_args) {
+	for (s32 idx = 1; idx < argc; ++idx) {
+		std::string_view const arg = argv[idx];
+		if (arg == "-m" || arg == "--manifest") {
+			if (++idx >= argc) {
+				return false;
+			}
+			out_args.manifests.push_back(argv[idx]);
+		} else {
+			out_args.dirs.push_back(arg);
+		}
+	}
+	return !out_args.dirs.empty() && !out_args.manifests.empty();
+}
+
+///
+/// \brief Extract all string values (not keys) from a (JSON) manifest: resource IDs are a subset of them
+///
+std::vector<std::string> strings(stdfs::path const& manifest) {
+	std::ifstream file(manifest);
+	std::stringstream str;
+	str << file.rdbuf();
+	std::string const text = str.str();
+	std::vector<std::string> ret;
+	for (std::size_t begin = text.find('"'); begin != std::string::npos; begin = text.find('"', begin)) {
+		auto const end = text.find('"', begin + 1);
+		if (end == std::string::npos) {
+			break;
+		}
+		auto const next = text.find_first_not_of(" \t\r\n", end + 1);
+		if (next == std::string::npos || text[next] != ':') {
+			ret.push_back(text.substr(begin + 1, end - begin - 1));
+		}
+		begin = end + 1;
+	}
+	return ret;
+}
+
+///
+/// \brief Cook a model (`<id>/<leaf>.json` and its OBJ / MTL) into `<id>/<leaf>.lvmesh` alongside the JSON
+///
+bool convert(io::FileReader const& reader, stdfs::path const& id) {
+	res::Model::LoadInfo loadInfo;
+	loadInfo.idRoot = loadInfo.jsonDirectory = id;
+	auto const bytes = loadInfo.cook(reader);
+	if (bytes.empty()) {
+		logE("[{}] Failed to convert [{}]", g_tName, id.generic_string());
+		return false;
+	}
+	auto const model = io::lvmesh::parse(bytes);
+	if (!model) {
+		logE("[{}] Failed to verify [{}]", g_tName, id.generic_string());
+		return false;
+	}
+	auto output = reader.fullPath(id / (id.filename().generic_string() + ".json"));
+	output.replace_extension(".lvmesh");
+	std::ofstream file(output, std::ios::binary);
+	if (!file.write(reinterpret_cast<char const*>(bytes.data()), (std::streamsize)bytes.size())) {
+		logE("[{}] Failed to write [{}]", g_tName, output.generic_string());
+		return false;
+	}
+	std::size_t vertices = 0;
+	std::size_t triangles = 0;
+	for (auto const& mesh : model->meshes) {
+		vertices += model->vertexCount(mesh);
+		triangles += mesh.indices.extent / 3;
+	}
+	auto const [size, unit] = utils::friendlySize((u64)bytes.size());
+	logI("[{}] [{}] => [{}] ({} meshes, {} vertices, {} triangles, {:.2f}{})", g_tName, id.generic_string(), output.filename().generic_string(),
+		 model->meshes.size(), vertices, triangles, size, unit);
+	return true;
+}
+} // namespace
+
+s32 main(s32 argc, char const* const argv[]) {
+	Args args;
+	if (!parse(argc, argv, args)) {
+		logE("{}", g_usage);
+		return 1;
+	}
+	io::FileReader reader;
+	for (auto const& dir : args.dirs) {
+		if (!reader.mount(dir)) {
+			logE("[{}] Failed to mount [{}]!", g_tName, dir.generic_string());
+			return 1;
+		}
+	}
+	bool bSuccess = true;
+	std::size_t count = 0;
+	for (auto const& manifest : args.manifests) {
+		if (!stdfs::is_regular_file(manifest)) {
+			logE("[{}] Manifest [{}] not found!", g_tName, manifest.generic_string());
+			return 1;
+		}
+		for (auto const& str : strings(manifest)) {
+			stdfs::path const id = str;
+			if (str.empty() || id.has_extension() || !reader.isPresent(id / (id.filename().generic_string() + ".json"))) {
+				continue;
+			}
+			bSuccess &= convert(reader, id);
+			++count;
+		}
+	}
+	if (count == 0) {
+		logE("[{}] No models found!", g_tName);
+		return 1;
+	}
+	return bSuccess ? 0 : 1;
+}
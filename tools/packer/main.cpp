@@ -0,0 +1,139 @@
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <core/log.hpp>
+#include <core/pack.hpp>
+
+using namespace le;
+
+namespace {
+constexpr std::string_view g_usage = "Usage: levk-packer <output.pack> <data_dir>... [-m <manifest>]...";
+
+struct Args final {
+	stdfs::path output;
+	std::vector<stdfs::path> dirs;
+	std::vector<stdfs::path> manifests;
+};
+
+bool parse(s32 argc, char const* const argv[], Args& out_args) {
+	if (argc < 3) {
+		return false;
+	}
+	out_args.output = argv[1];
+	for (s32 idx = 2; idx < argc; ++idx) {
+		std::string_view const arg = argv[idx];
+		if (arg == "-m" || arg == "--manifest") {
+			if (++idx >= argc) {
+				return false;
+			}
+			out_args.manifests.push_back(argv[idx]);
+		} else {
+			out_args.dirs.push_back(arg);
+		}
+	}
+	return !out_args.dirs.empty();
+}
+
+///
+/// \brief Extract all string values (not keys) from a (JSON) manifest: resource IDs are a subset of them
+///
+std::vector<std::string> strings(stdfs::path const& manifest) {
+	std::ifstream file(manifest);
+	std::stringstream str;
+	str << file.rdbuf();
+	std::string const text = str.str();
+	std::vector<std::string> ret;
+	for (std::size_t begin = text.find('"'); begin != std::string::npos; begin = text.find('"', begin)) {
+		auto const end = text.find('"', begin + 1);
+		if (end == std::string::npos) {
+			break;
+		}
+		auto const next = text.find_first_not_of(" \t\r\n", end + 1);
+		if (next == std::string::npos || text[next] != ':') {
+			ret.push_back(text.substr(begin + 1, end - begin - 1));
+		}
+		begin = end + 1;
+	}
+	return ret;
+}
+
+///
+/// \brief Add an ID to the pack: files as-is, directories recursively, else all files `<id>.*` (eg shaders)
+///
+bool addID(io::pack::Writer& out_writer, std::vector<stdfs::path> const& dirs, std::string const& id) {
+	std::error_code errCode;
+	for (auto const& dir : dirs) {
+		auto const path = dir / id;
+		if (stdfs::is_regular_file(path, errCode)) {
+			return out_writer.add(id, path);
+		}
+		if (stdfs::is_directory(path, errCode)) {
+			auto iter = stdfs::recursive_directory_iterator(path, errCode);
+			for (; !errCode && iter != stdfs::recursive_directory_iterator(); iter.increment(errCode)) {
+				if (iter->is_regular_file(errCode)) {
+					out_writer.add(iter->path().lexically_relative(dir).generic_string(), iter->path());
+				}
+			}
+			return true;
+		}
+		bool bFound = false;
+		auto const stem = path.filename().generic_string() + ".";
+		for (auto const& entry : stdfs::directory_iterator(path.parent_path(), errCode)) {
+			if (entry.is_regular_file(errCode) && entry.path().filename().generic_string().rfind(stem, 0) == 0) {
+				bFound |= out_writer.add(entry.path().lexically_relative(dir).generic_string(), entry.path());
+			}
+		}
+		if (bFound) {
+			return true;
+		}
+	}
+	return false;
+}
+} // namespace
+
+s32 main(s32 argc, char const* const argv[]) {
+	Args args;
+	if (!parse(argc, argv, args)) {
+		logE("{}", g_usage);
+		return 1;
+	}
+	io::pack::Writer writer;
+	if (args.manifests.empty()) {
+		for (auto const& dir : args.dirs) {
+			if (!stdfs::is_directory(dir)) {
+				logE("[levk-packer] [{}] is not a directory!", dir.generic_string());
+				return 1;
+			}
+			writer.addAll(dir);
+		}
+	} else {
+		for (auto const& manifest : args.manifests) {
+			if (!stdfs::is_regular_file(manifest)) {
+				logE("[levk-packer] Manifest [{}] not found!", manifest.generic_string());
+				return 1;
+			}
+			bool bAdded = false;
+			for (auto const& dir : args.dirs) {
+				auto const relative = manifest.lexically_relative(dir);
+				if (!relative.empty() && *relative.begin() != "..") {
+					bAdded = writer.add(relative.generic_string(), manifest);
+					break;
+				}
+			}
+			if (!bAdded) {
+				writer.add(manifest.filename().generic_string(), manifest);
+			}
+			for (auto const& str : strings(manifest)) {
+				if (!str.empty() && addID(writer, args.dirs, str)) {
+					logD("[levk-packer] [{}] added", str);
+				}
+			}
+		}
+	}
+	if (writer.size() == 0) {
+		logE("[levk-packer] Nothing to pack!");
+		return 1;
+	}
+	return writer.write(args.output) ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stb/stb_image.h>
+#include <core/bc.hpp>
+#include <core/ktx2.hpp>
+#include <core/log.hpp>
+#include <core/mip_chain.hpp>
+#include <core/tasks.hpp>
+#include <core/utils.hpp>
+
+using namespace le;
+
+namespace {
+namespace stdfs = std::filesystem;
+
+constexpr std::string_view g_tName = "levk-texture-encoder";
+constexpr std::string_view g_usage = "Usage: levk-texture-encoder <data_dir>... -m <manifest>... [-f bc1|bc3|bc5|bc7] [--linear] [--no-mips]";
+
+struct Args final {
+	std::vector<stdfs::path> dirs;
+	std::vector<stdfs::path> manifests;
+	bc::Format format = bc::Format::eBC7;
+	bool bSRGB = true;
+	bool bMipMaps = true;
+};
+
+bool parse(s32 argc, char const* const argv[], Args& out_args) {
+	for (s32 idx = 1; idx < argc; ++idx) {
+		std::string_view const arg = argv[idx];
+		if (arg == "-m" || arg == "--manifest") {
+			if (++idx >= argc) {
+				return false;
+			}
+			out_args.manifests.push_back(argv[idx]);
+		} else if (arg == "-f" || arg == "--format") {
+			if (++idx >= argc) {
+				return false;
+			}
+			std::string_view const format = argv[idx];
+			if (format == "bc1") {
+				out_args.format = bc::Format::eBC1;
+			} else if (format == "bc3") {
+				out_args.format = bc::Format::eBC3;
+			} else if (format == "bc5") {
+				// two channel data (normal maps): never sRGB
+				out_args.format = bc::Format::eBC5;
+				out_args.bSRGB = false;
+			} else if (format == "bc7") {
+				out_args.format = bc::Format::eBC7;
+			} else {
+				return false;
+			}
+		} else if (arg == "--linear") {
+			out_args.bSRGB = false;
+		} else if (arg == "--no-mips") {
+			out_args.bMipMaps = false;
+		} else {
+			out_args.dirs.push_back(arg);
+		}
+	}
+	return !out_args.dirs.empty() && !out_args.manifests.empty();
+}
+
+///
+/// \brief Extract all string values (not keys) from a (JSON) manifest: resource IDs are a subset of them
+///
+std::vector<std::string> strings(stdfs::path const& manifest) {
+	std::ifstream file(manifest);
+	std::stringstream str;
+	str << file.rdbuf();
+	std::string const text = str.str();
+	std::vector<std::string> ret;
+	for (std::size_t begin = text.find('"'); begin != std::string::npos; begin = text.find('"', begin)) {
+		auto const end = text.find('"', begin + 1);
+		if (end == std::string::npos) {
+			break;
+		}
+		auto const next = text.find_first_not_of(" \t\r\n", end + 1);
+		if (next == std::string::npos || text[next] != ':') {
+			ret.push_back(text.substr(begin + 1, end - begin - 1));
+		}
+		begin = end + 1;
+	}
+	return ret;
+}
+
+bool isImage(stdfs::path const& id) {
+	auto ext = id.extension().generic_string();
+	utils::strings::toLower(ext);
+	return ext == ".png" || ext == ".jpg" || ext == ".jpeg";
+}
+
+///
+/// \brief Encode an image (and its mip chain) into a `.ktx2` alongside it
+///
+bool encode(Args const& args, stdfs::path const& path) {
+	s32 width = 0;
+	s32 height = 0;
+	s32 channels = 0;
+	u8* pRGBA = stbi_load(path.generic_string().data(), &width, &height, &channels, 4);
+	if (!pRGBA) {
+		logE("[{}] Failed to decode [{}]: {}", g_tName, path.generic_string(), stbi_failure_reason());
+		return false;
+	}
+	Span<u8> const base(pRGBA, (std::size_t)width * (std::size_t)height * 4);
+	auto const encoding = args.bSRGB ? mips::Encoding::eSRGB : mips::Encoding::eUNorm;
+	auto const chain = args.bMipMaps ? mips::generate(base, (u32)width, (u32)height, encoding) : mips::Chain();
+	std::vector<std::vector<u8>> levels = {bc::encode(args.format, base, (u32)width, (u32)height)};
+	for (std::size_t idx = 0; idx < chain.levels.size(); ++idx) {
+		levels.push_back(bc::encode(args.format, chain.level(idx), chain.levels[idx].width, chain.levels[idx].height));
+	}
+	stbi_image_free(pRGBA);
+	io::ktx2::Image image;
+	image.format = io::ktx2::vkFormat(args.format, args.bSRGB);
+	image.width = (u32)width;
+	image.height = (u32)height;
+	for (auto const& level : levels) {
+		image.levels.push_back(level);
+	}
+	auto const bytes = io::ktx2::write(image);
+	auto output = path;
+	output.replace_extension(".ktx2");
+	std::ofstream file(output, std::ios::binary);
+	if (bytes.empty() || !file.write(reinterpret_cast<char const*>(bytes.data()), (std::streamsize)bytes.size())) {
+		logE("[{}] Failed to write [{}]", g_tName, output.generic_string());
+		return false;
+	}
+	auto const [srcSize, srcUnit] = utils::friendlySize((u64)base.extent + (u64)chain.bytes.size());
+	auto const [dstSize, dstUnit] = utils::friendlySize((u64)bytes.size());
+	logI("[{}] [{}] => [{}] ({} levels, {:.2f}{} => {:.2f}{})", g_tName, path.generic_string(), output.filename().generic_string(), levels.size(), srcSize,
+		 srcUnit, dstSize, dstUnit);
+	return true;
+}
+} // namespace
+
+s32 main(s32 argc, char const* const argv[]) {
+	Args args;
+	if (!parse(argc, argv, args)) {
+		logE("{}", g_usage);
+		return 1;
+	}
+	tasks::Service service(tasks::Config{});
+	bool bSuccess = true;
+	std::size_t count = 0;
+	for (auto const& manifest : args.manifests) {
+		if (!stdfs::is_regular_file(manifest)) {
+			logE("[{}] Manifest [{}] not found!", g_tName, manifest.generic_string());
+			return 1;
+		}
+		for (auto const& str : strings(manifest)) {
+			if (str.empty() || !isImage(str)) {
+				continue;
+			}
+			std::error_code errCode;
+			for (auto const& dir : args.dirs) {
+				if (auto const path = dir / str; stdfs::is_regular_file(path, errCode)) {
+					bSuccess &= encode(args, path);
+					++count;
+					break;
+				}
+			}
+		}
+	}
+	if (count == 0) {
+		logE("[{}] No PNG / JPG inputs found!", g_tName);
+		return 1;
+	}
+	return bSuccess ? 0 : 1;
+}